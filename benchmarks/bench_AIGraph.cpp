@@ -0,0 +1,94 @@
+#include <benchmark/benchmark.h>
+#include <ai/AIGraph.hpp>
+#include <ai/AIGraphNode.hpp>
+#include <ai/RoutePlanner.hpp>
+#include <data/PathData.hpp>
+
+#include <random>
+#include <vector>
+
+namespace {
+/// A road grid of size x size welded intersections, 20 units apart
+void makeRoadGrid(ai::AIGraph& graph, int size) {
+    const glm::quat identity{1.f, 0.f, 0.f, 0.f};
+    const float spacing = 20.f;
+    const float origin = -spacing * static_cast<float>(size) / 2.f;
+    for (int line = 0; line < size; ++line) {
+        PathData rows{PathData::PATH_CAR, 0, "", {}};
+        PathData columns{PathData::PATH_CAR, 0, "", {}};
+        const auto offset = origin + spacing * static_cast<float>(line);
+        for (int i = 0; i < size; ++i) {
+            const auto along = origin + spacing * static_cast<float>(i);
+            const int next = i + 1 < size ? i + 1 : -1;
+            rows.nodes.push_back({PathNode::EXTERNAL, next,
+                                  glm::vec3(along, offset, 0.f), 1.f, 1, 1});
+            columns.nodes.push_back({PathNode::EXTERNAL, next,
+                                     glm::vec3(offset, along, 0.f), 1.f, 1,
+                                     1});
+        }
+        graph.createPathNodes(glm::vec3(), identity, rows);
+        graph.createPathNodes(glm::vec3(), identity, columns);
+    }
+}
+
+std::vector<glm::vec3> makePoints(int size) {
+    std::mt19937 rng(1);
+    const auto extent = static_cast<unsigned>(size * 20);
+    std::vector<glm::vec3> points;
+    for (int i = 0; i < 1024; ++i) {
+        const auto x = static_cast<float>(rng() % extent) - extent / 2.f;
+        const auto y = static_cast<float>(rng() % extent) - extent / 2.f;
+        points.emplace_back(x, y, 0.f);
+    }
+    return points;
+}
+}  // namespace
+
+static void BM_AIGraphBuild(benchmark::State& state) {
+    const auto size = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        ai::AIGraph graph;
+        makeRoadGrid(graph, size);
+        benchmark::DoNotOptimize(graph.nodes.data());
+    }
+
+    state.SetItemsProcessed(
+        static_cast<int64_t>(state.iterations()) * size * size * 2);
+}
+BENCHMARK(BM_AIGraphBuild)->Arg(32)->Arg(96);
+
+static void BM_AIGraphNearestNode(benchmark::State& state) {
+    const auto size = static_cast<int>(state.range(0));
+    ai::AIGraph graph;
+    makeRoadGrid(graph, size);
+    const auto points = makePoints(size);
+
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(graph.findNearestNode(
+            points[i++ % points.size()], ai::NodeType::Vehicle));
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_AIGraphNearestNode)->Arg(32)->Arg(96);
+
+static void BM_RoutePlannerFindRoute(benchmark::State& state) {
+    const auto size = static_cast<int>(state.range(0));
+    ai::AIGraph graph;
+    makeRoadGrid(graph, size);
+    const auto points = makePoints(size);
+    ai::RoutePlanner planner(graph);
+    std::vector<ai::AIGraphNode*> route;
+
+    size_t i = 0;
+    for (auto _ : state) {
+        const auto& from = points[i++ % points.size()];
+        const auto& to = points[i++ % points.size()];
+        benchmark::DoNotOptimize(
+            planner.findRoute(from, to, ai::NodeType::Vehicle, route));
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_RoutePlannerFindRoute)->Arg(32)->Arg(96);
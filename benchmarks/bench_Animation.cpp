@@ -0,0 +1,22 @@
+#include <benchmark/benchmark.h>
+#include <loaders/LoaderIFP.hpp>
+#include "bench_Fixtures.hpp"
+
+static void BM_GetInterpolatedKeyframe(benchmark::State& state) {
+    auto bone = fixtures::makeBone(static_cast<size_t>(state.range(0)));
+
+    // Sweep through the animation, like an animator playing it back
+    const float step = bone.duration / 97.f;
+    float time = 0.f;
+    for (auto _ : state) {
+        auto frame = bone.getInterpolatedKeyframe(time);
+        benchmark::DoNotOptimize(frame);
+        time += step;
+        if (time > bone.duration) {
+            time -= bone.duration;
+        }
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_GetInterpolatedKeyframe)->Arg(8)->Arg(64)->Arg(512);
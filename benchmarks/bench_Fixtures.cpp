@@ -0,0 +1,467 @@
+#include "bench_Fixtures.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <sstream>
+
+#include <glm/gtc/quaternion.hpp>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+
+#include <loaders/RWBinaryStream.hpp>
+
+namespace fixtures {
+
+void ChunkWriter::begin(uint32_t id) {
+    write(id);
+    open_.push_back(data_.size());
+    write(uint32_t{0});
+    write(kVersion);
+}
+
+void ChunkWriter::end() {
+    auto sizeOffset = open_.back();
+    open_.pop_back();
+    auto size = static_cast<uint32_t>(data_.size() - sizeOffset -
+                                      2 * sizeof(uint32_t));
+    std::memcpy(data_.data() + sizeOffset, &size, sizeof(size));
+}
+
+void ChunkWriter::writeBytes(const void* bytes, size_t size) {
+    auto offset = data_.size();
+    data_.resize(offset + size);
+    std::memcpy(data_.data() + offset, bytes, size);
+}
+
+void ChunkWriter::writeString(const std::string& str) {
+    begin(RW::SID_String);
+    writeBytes(str.c_str(), str.size() + 1);
+    end();
+}
+
+FileContentsInfo ChunkWriter::release() {
+    auto mem = std::make_unique<char[]>(data_.size());
+    std::copy(data_.begin(), data_.end(), mem.get());
+    FileContentsInfo file(std::move(mem), data_.size());
+    data_.clear();
+    return file;
+}
+
+namespace {
+void writeFrameList(ChunkWriter& out, size_t frames) {
+    out.begin(RW::SID_FrameList);
+
+    out.begin(RW::SID_Struct);
+    out.write(static_cast<uint32_t>(frames));
+    for (size_t f = 0; f < frames; ++f) {
+        const float rotation[9] = {1.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 1.f};
+        out.write(rotation);
+        out.write(glm::vec3(0.f, 0.f, static_cast<float>(f)));
+        out.write(static_cast<int32_t>(f) - 1);
+        out.write(uint32_t{0});
+    }
+    out.end();
+
+    for (size_t f = 0; f < frames; ++f) {
+        out.begin(RW::SID_Extension);
+        out.begin(RW::SID_NodeName);
+        auto name = "Frame" + std::to_string(f);
+        out.writeBytes(name.data(), name.size());
+        out.end();
+        out.end();
+    }
+
+    out.end();
+}
+
+void writeMaterialList(ChunkWriter& out) {
+    out.begin(RW::SID_MaterialList);
+
+    out.begin(RW::SID_Struct);
+    out.write(uint32_t{1});
+    out.write(int32_t{-1});
+    out.end();
+
+    out.begin(RW::SID_Material);
+    out.begin(RW::SID_Struct);
+    out.write(uint32_t{0});
+    out.write(glm::u8vec4(255, 255, 255, 255));
+    out.write(uint32_t{0});
+    out.write(uint32_t{1});
+    out.write(1.f);  // Ambient
+    out.write(1.f);  // Specular
+    out.write(1.f);  // Diffuse
+    out.end();
+
+    out.begin(RW::SID_Texture);
+    out.begin(RW::SID_Struct);
+    out.write(uint32_t{RW::BSTextureNative::FILTER_LINEAR});
+    out.end();
+    out.writeString("Texture");
+    out.writeString("");
+    out.end();
+
+    out.end();
+
+    out.end();
+}
+
+void writeGeometry(ChunkWriter& out, size_t vertices, bool normals) {
+    // A strip zig-zagging between two rows of vertices
+    const auto triangles = vertices - 2;
+
+    out.begin(RW::SID_Geometry);
+
+    out.begin(RW::SID_Struct);
+    const uint16_t flags = 4 | 8 | (normals ? 16 : 0);
+    out.write(flags);
+    out.write(uint8_t{1});  // Texture coordinate sets
+    out.write(uint8_t{0});
+    out.write(static_cast<uint32_t>(triangles));
+    out.write(static_cast<uint32_t>(vertices));
+    out.write(uint32_t{1});  // Morph targets
+    out.write(RW::BSGeometryColor{});
+
+    for (size_t v = 0; v < vertices; ++v) {
+        out.write(glm::u8vec4(255, 255, 255, 255));
+    }
+    for (size_t v = 0; v < vertices; ++v) {
+        out.write(glm::vec2(static_cast<float>(v / 2), v % 2));
+    }
+    for (size_t t = 0; t < triangles; ++t) {
+        out.write(RW::BSGeometryTriangle{
+            static_cast<uint16_t>(t), static_cast<uint16_t>(t + 1), 0,
+            static_cast<uint16_t>(t + 2)});
+    }
+
+    RW::BSGeometryBounds bounds{};
+    bounds.center = glm::vec3(vertices / 4.f, 0.5f, 0.f);
+    bounds.radius = vertices / 4.f + 1.f;
+    bounds.positions = 1;
+    bounds.normals = normals ? 1 : 0;
+    out.write(bounds);
+
+    for (size_t v = 0; v < vertices; ++v) {
+        out.write(glm::vec3(static_cast<float>(v / 2), v % 2, 0.f));
+    }
+    if (normals) {
+        for (size_t v = 0; v < vertices; ++v) {
+            out.write(glm::vec3(0.f, 0.f, 1.f));
+        }
+    }
+    out.end();
+
+    writeMaterialList(out);
+
+    out.begin(RW::SID_Extension);
+    out.begin(RW::SID_BinMeshPLG);
+    out.write(uint32_t{1});  // Triangle strip
+    out.write(uint32_t{1});  // Splits
+    out.write(static_cast<uint32_t>(vertices));
+    out.write(static_cast<uint32_t>(vertices));
+    out.write(uint32_t{0});  // Material
+    for (size_t v = 0; v < vertices; ++v) {
+        out.write(static_cast<uint32_t>(v));
+    }
+    out.end();
+    out.end();
+
+    out.end();
+}
+}  // namespace
+
+FileContentsInfo makeDFF(size_t frames, size_t geometries, size_t vertices,
+                         bool normals) {
+    frames = std::max<size_t>(frames, 1);
+    vertices = std::clamp<size_t>(vertices, 3, 0xFFFF);
+
+    ChunkWriter out;
+    out.begin(RW::SID_Clump);
+
+    out.begin(RW::SID_Struct);
+    out.write(static_cast<uint32_t>(geometries));
+    out.end();
+
+    writeFrameList(out, frames);
+
+    out.begin(RW::SID_GeometryList);
+    out.begin(RW::SID_Struct);
+    out.write(static_cast<uint32_t>(geometries));
+    out.end();
+    for (size_t g = 0; g < geometries; ++g) {
+        writeGeometry(out, vertices, normals);
+    }
+    out.end();
+
+    for (size_t g = 0; g < geometries; ++g) {
+        out.begin(RW::SID_Atomic);
+        out.begin(RW::SID_Struct);
+        out.write(static_cast<uint32_t>(g % frames));
+        out.write(static_cast<uint32_t>(g));
+        out.write(uint32_t{5});  // Render and collision test
+        out.write(uint32_t{0});
+        out.end();
+        out.end();
+    }
+
+    out.end();
+    return out.release();
+}
+
+FileContentsInfo makeTXD(size_t textures, uint16_t size, uint32_t format) {
+    const size_t pixels = static_cast<size_t>(size) * size;
+
+    ChunkWriter out;
+    out.begin(RW::SID_TextureDictionary);
+
+    out.begin(RW::SID_Struct);
+    out.write(static_cast<uint16_t>(textures));
+    out.write(uint16_t{0});
+    out.end();
+
+    for (size_t t = 0; t < textures; ++t) {
+        out.begin(RW::SID_TextureNative);
+        out.begin(RW::SID_Struct);
+
+        RW::BSTextureNative header{};
+        header.platform = 8;
+        header.filterflags = RW::BSTextureNative::FILTER_LINEAR;
+        header.wrapU = header.wrapV = RW::BSTextureNative::WRAP_WRAP;
+        auto name = "texture" + std::to_string(t);
+        std::copy(name.begin(), name.end(), header.diffuseName);
+        header.rasterformat = format;
+        header.width = header.height = size;
+        header.nummipmaps = 1;
+        header.rastertype = 4;
+
+        const bool isPal8 = (format & RW::BSTextureNative::FORMAT_EXT_PAL8) ==
+                            RW::BSTextureNative::FORMAT_EXT_PAL8;
+        const bool is16Bit = format == RW::BSTextureNative::FORMAT_1555 ||
+                             format == RW::BSTextureNative::FORMAT_565;
+        header.bpp = isPal8 ? 8 : is16Bit ? 16 : 32;
+
+        // The struct ends with the header's datasize field
+        out.writeBytes(&header, offsetof(RW::BSTextureNative, datasize));
+
+        if (isPal8) {
+            for (uint32_t c = 0; c < 256; ++c) {
+                out.write(0xFF000000u | c * 0x010101u);
+            }
+            out.write(static_cast<uint32_t>(pixels));
+            for (size_t p = 0; p < pixels; ++p) {
+                out.write(static_cast<uint8_t>(p * 7));
+            }
+        } else if (is16Bit) {
+            out.write(static_cast<uint32_t>(pixels * sizeof(uint16_t)));
+            for (size_t p = 0; p < pixels; ++p) {
+                out.write(static_cast<uint16_t>(p * 31));
+            }
+        } else {
+            out.write(static_cast<uint32_t>(pixels * sizeof(uint32_t)));
+            for (size_t p = 0; p < pixels; ++p) {
+                out.write(static_cast<uint32_t>(p * 0x01020304u));
+            }
+        }
+
+        out.end();
+
+        out.begin(RW::SID_Extension);
+        out.end();
+
+        out.end();
+    }
+
+    out.end();
+    return out.release();
+}
+
+std::string makeIPL(size_t instances) {
+    std::ostringstream out;
+    out << "# Generated\ninst\n";
+    for (size_t i = 0; i < instances; ++i) {
+        out << 1000 + i % 500 << ", model" << i % 500 << ", "
+            << static_cast<float>(i % 100) * 10.5f << ", "
+            << static_cast<float>(i / 100) * -8.25f << ", "
+            << static_cast<float>(i % 7) << ", 1, 1, 1, 0, 0, "
+            << (i % 2 ? "0.707107, 0.707107" : "0, 1") << "\n";
+    }
+    out << "end\n";
+    return out.str();
+}
+
+namespace {
+enum SCMParam : uint8_t {
+    TInt32 = 0x01,
+    TGlobal = 0x02,
+    TInt8 = 0x04,
+};
+
+/// Appends a little endian value to the script
+template <class T>
+void put(std::vector<char>& out, T value) {
+    auto offset = out.size();
+    out.resize(offset + sizeof(T));
+    std::memcpy(out.data() + offset, &value, sizeof(T));
+}
+
+void putJump(std::vector<char>& out, uint32_t target) {
+    put(out, uint16_t{0x0002});
+    put(out, TInt32);
+    put(out, target);
+    put(out, uint8_t{0});
+}
+}  // namespace
+
+std::vector<char> makeSCM(size_t instructions) {
+    constexpr uint32_t kGlobalsSize = 64;
+    constexpr uint16_t kCounter = 0;
+    constexpr uint16_t kTotal = 4;
+
+    std::vector<char> out;
+
+    // Each section starts with a jump over it, which SCMFile follows
+    const uint32_t modelSection = 8 + kGlobalsSize;
+    const uint32_t missionSection = modelSection + 8 + sizeof(uint32_t);
+    const uint32_t codeSection = missionSection + 8 + 3 * sizeof(uint32_t);
+
+    putJump(out, modelSection);
+    out.resize(modelSection, 0);
+
+    putJump(out, missionSection);
+    put(out, uint32_t{0});  // Models
+
+    putJump(out, codeSection);
+    put(out, uint32_t{0});  // Main size, filled in below
+    put(out, uint32_t{0});  // Largest mission
+    put(out, uint32_t{0});  // Missions
+
+    const auto loop = static_cast<uint32_t>(out.size());
+    for (size_t i = 0; i < instructions; ++i) {
+        // counter += 1, total += 3 alternately
+        put(out, uint16_t{0x0008});
+        put(out, TGlobal);
+        put(out, i % 2 ? kTotal : kCounter);
+        put(out, TInt8);
+        put(out, static_cast<int8_t>(i % 2 ? 3 : 1));
+    }
+
+    // if counter > 1000000, counter = 0
+    put(out, uint16_t{0x00D6});
+    put(out, TInt8);
+    put(out, int8_t{0});
+
+    put(out, uint16_t{0x0018});
+    put(out, TGlobal);
+    put(out, kCounter);
+    put(out, TInt32);
+    put(out, int32_t{1000000});
+
+    const auto skipJump = out.size();
+    put(out, uint16_t{0x004D});
+    put(out, TInt32);
+    put(out, int32_t{0});
+
+    put(out, uint16_t{0x0004});
+    put(out, TGlobal);
+    put(out, kCounter);
+    put(out, TInt8);
+    put(out, int8_t{0});
+
+    const auto skip = static_cast<int32_t>(out.size());
+    std::memcpy(out.data() + skipJump + 3, &skip, sizeof(skip));
+
+    // wait 0, then go round again
+    put(out, uint16_t{0x0001});
+    put(out, TInt8);
+    put(out, int8_t{0});
+
+    put(out, uint16_t{0x0002});
+    put(out, TInt32);
+    put(out, static_cast<int32_t>(loop));
+
+    const auto mainSize = static_cast<uint32_t>(out.size());
+    std::memcpy(out.data() + missionSection + 8, &mainSize, sizeof(mainSize));
+
+    return out;
+}
+
+AnimationBone makeBone(size_t keyframes) {
+    constexpr float kFrameTime = 1.f / 30.f;
+
+    std::vector<AnimationKeyframe> frames;
+    frames.reserve(keyframes);
+    for (size_t f = 0; f < keyframes; ++f) {
+        const float t = static_cast<float>(f) * kFrameTime;
+        frames.emplace_back(glm::angleAxis(t, glm::vec3(0.f, 0.f, 1.f)),
+                            glm::vec3(t, 0.f, 0.f), glm::vec3(1.f), t,
+                            static_cast<int>(f));
+    }
+
+    const float duration =
+        keyframes > 0 ? static_cast<float>(keyframes - 1) * kFrameTime : 0.f;
+    return {"bone", -1, -1, duration, AnimationBone::RT0, frames};
+}
+
+Weather makeWeather() {
+    Weather weather;
+    weather.entries.resize(4 * 24);
+    for (size_t e = 0; e < weather.entries.size(); ++e) {
+        auto& entry = weather.entries[e];
+        const auto value = static_cast<float>(e % 24) / 24.f;
+        entry.ambientColor = entry.directLightColor = glm::vec3(value);
+        entry.skyTopColor = entry.skyBottomColor = glm::vec3(1.f - value);
+        entry.sunCoreColor = entry.sunCoronaColor = glm::vec3(value);
+        entry.sunCoreSize = entry.sunCoronaSize = entry.sunBrightness = value;
+        entry.shadowIntensity = entry.lightShading = entry.poleShading =
+            static_cast<int32_t>(e);
+        entry.farClipping = 800.f + value * 400.f;
+        entry.fogStart = 100.f + value * 50.f;
+        entry.amountGroundLight = value;
+        entry.lowCloudColor = entry.topCloudColor = entry.bottomCloudColor =
+            glm::vec3(value);
+    }
+    return weather;
+}
+
+ZoneDataList makeZones(size_t zones) {
+    constexpr float kMapSize = 4000.f;
+
+    // Every district is followed by its four quarters
+    const auto districts = (zones + 4) / 5;
+    size_t perRow = 1;
+    while (perRow * perRow < districts) {
+        perRow++;
+    }
+    const float districtSize = 2.f * kMapSize / static_cast<float>(perRow);
+
+    ZoneDataList list;
+    list.reserve(zones + 1);
+    list.emplace_back("CITYZON", 0, glm::vec3(-kMapSize, -kMapSize, -500.f),
+                      glm::vec3(kMapSize, kMapSize, 500.f), 0, 0, 0);
+    for (size_t i = 0; i < zones; ++i) {
+        const auto district = i / 5;
+        glm::vec3 min(-kMapSize + static_cast<float>(district % perRow) *
+                                      districtSize,
+                      -kMapSize + static_cast<float>(district / perRow) *
+                                      districtSize,
+                      -100.f);
+        float size = districtSize;
+        if (i % 5 != 0) {
+            const auto quarter = i % 5 - 1;
+            size *= 0.5f;
+            min.x += static_cast<float>(quarter % 2) * size;
+            min.y += static_cast<float>(quarter / 2) * size;
+        }
+        const glm::vec3 max(min.x + size, min.y + size, 100.f);
+        list.emplace_back("Z" + std::to_string(i), 0, min, max, 0, 0, 0);
+    }
+
+    for (ZoneData& zone : list) {
+        if (&zone != &list.front()) {
+            list.front().insertZone(zone);
+        }
+    }
+    return list;
+}
+
+}  // namespace fixtures
@@ -0,0 +1,103 @@
+#ifndef _BENCHFIXTURES_HPP_
+#define _BENCHFIXTURES_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <data/Weather.hpp>
+#include <data/ZoneData.hpp>
+#include <loaders/LoaderIFP.hpp>
+#include <platform/FileHandle.hpp>
+
+/**
+ * Synthetic game files, so the benchmarks run without the game data and
+ * always measure the same input.
+ *
+ * The generators are deterministic: the same arguments give the same bytes
+ * on every run and every commit.
+ */
+namespace fixtures {
+
+/**
+ * Builds RenderWare binary streams, patching in each chunk's size when it
+ * is closed.
+ */
+class ChunkWriter {
+public:
+    static constexpr uint32_t kVersion = 0x0C02FFFF;
+
+    void begin(uint32_t id);
+    void end();
+
+    template <class T>
+    void write(const T& value) {
+        auto offset = data_.size();
+        data_.resize(offset + sizeof(T));
+        std::memcpy(data_.data() + offset, &value, sizeof(T));
+    }
+
+    void writeBytes(const void* bytes, size_t size);
+
+    /// Writes a String chunk holding str and its terminator
+    void writeString(const std::string& str);
+
+    const std::vector<char>& getData() const {
+        return data_;
+    }
+
+    FileContentsInfo release();
+
+private:
+    std::vector<char> data_;
+    std::vector<size_t> open_;
+};
+
+/**
+ * @return a clump with a chain of frames and one atomic per geometry. Each
+ * geometry is a triangle strip with one material and a texture.
+ *
+ * @param normals whether the geometry stores normals, or the loader has to
+ * generate them
+ */
+FileContentsInfo makeDFF(size_t frames, size_t geometries, size_t vertices,
+                         bool normals);
+
+/**
+ * @return a texture dictionary of square textures in the given format,
+ * one of the BSTextureNative::FORMAT_ values
+ */
+FileContentsInfo makeTXD(size_t textures, uint16_t size, uint32_t format);
+
+/**
+ * @return the text of an IPL file with an inst section
+ */
+std::string makeIPL(size_t instances);
+
+/**
+ * @return an SCM file whose main thread runs a loop of instructions
+ * arithmetic instructions, followed by a conditional jump and a wait 0.
+ */
+std::vector<char> makeSCM(size_t instructions);
+
+/**
+ * @return a bone with evenly spaced rotation and translation keyframes
+ */
+AnimationBone makeBone(size_t keyframes);
+
+/**
+ * @return a full day of entries for every weather condition
+ */
+Weather makeWeather();
+
+/**
+ * @return a root zone over the whole map followed by the given number of
+ * zones, laid out as districts split into quarters. The hierarchy is built.
+ */
+ZoneDataList makeZones(size_t zones);
+
+}  // namespace fixtures
+
+#endif
@@ -0,0 +1,52 @@
+#include <benchmark/benchmark.h>
+#include <core/JobSystem.hpp>
+
+#include <cmath>
+#include <vector>
+
+namespace {
+constexpr size_t kItems = 1 << 16;
+
+void workerArgs(benchmark::internal::Benchmark* b) {
+    for (int64_t workers : {0, 1, 2, 4, 8}) {
+        b->Arg(workers);
+    }
+    b->ArgName("workers")->UseRealTime();
+}
+}  // namespace
+
+// Enough work per item that the workers have something to share
+static void BM_JobSystemParallelFor(benchmark::State& state) {
+    JobSystem jobs(static_cast<unsigned>(state.range(0)));
+    std::vector<float> values(kItems, 1.f);
+
+    for (auto _ : state) {
+        jobs.parallelFor(0, values.size(), 1024,
+                         [&](size_t first, size_t last) {
+                             for (size_t i = first; i < last; ++i) {
+                                 values[i] = std::sqrt(values[i] +
+                                                       static_cast<float>(i));
+                             }
+                         });
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kItems));
+}
+BENCHMARK(BM_JobSystemParallelFor)->Apply(workerArgs);
+
+// The overhead of scheduling many tiny jobs
+static void BM_JobSystemSubmit(benchmark::State& state) {
+    JobSystem jobs(static_cast<unsigned>(state.range(0)));
+
+    for (auto _ : state) {
+        JobCounter counter;
+        for (int i = 0; i < 256; ++i) {
+            jobs.submit(counter, [] {});
+        }
+        jobs.wait(counter);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * 256);
+}
+BENCHMARK(BM_JobSystemSubmit)->Apply(workerArgs);
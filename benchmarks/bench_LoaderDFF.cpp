@@ -0,0 +1,30 @@
+#include <benchmark/benchmark.h>
+#include <data/Clump.hpp>
+#include <loaders/LoaderDFF.hpp>
+#include "bench_Fixtures.hpp"
+
+// Arguments: geometries, vertices per geometry, whether normals are stored
+static void BM_LoaderDFF(benchmark::State& state) {
+    auto file = fixtures::makeDFF(16, static_cast<size_t>(state.range(0)),
+                                  static_cast<size_t>(state.range(1)),
+                                  state.range(2) != 0);
+    LoaderDFF loader;
+
+    for (auto _ : state) {
+        auto clump = loader.loadFromMemory(file);
+        if (!clump) {
+            state.SkipWithError("The generated DFF didn't load");
+            break;
+        }
+        benchmark::DoNotOptimize(clump.get());
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                            static_cast<int64_t>(file.length));
+}
+BENCHMARK(BM_LoaderDFF)
+    ->ArgNames({"geometries", "vertices", "normals"})
+    ->Args({1, 64, 1})
+    ->Args({16, 256, 1})
+    ->Args({16, 256, 0})
+    ->Args({4, 4096, 1});
@@ -0,0 +1,22 @@
+#include <benchmark/benchmark.h>
+#include <loaders/LoaderIPL.hpp>
+#include "bench_Fixtures.hpp"
+
+#include <sstream>
+
+static void BM_LoaderIPL(benchmark::State& state) {
+    auto text = fixtures::makeIPL(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        std::istringstream stream(text);
+        LoaderIPL loader;
+        loader.load(stream);
+        benchmark::DoNotOptimize(loader.m_instances.data());
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() *
+                                                 text.size()));
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+                            state.range(0));
+}
+BENCHMARK(BM_LoaderIPL)->Arg(100)->Arg(5000);
@@ -0,0 +1,134 @@
+#include <benchmark/benchmark.h>
+#include <loaders/LoaderTXD.hpp>
+#include <loaders/PixelConversion.hpp>
+#include <loaders/RWBinaryStream.hpp>
+#include "bench_Fixtures.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace {
+constexpr size_t kPixels = 256 * 256;
+
+bool skipUnsupported(benchmark::State& state, PixelConversion::Kernel kernel) {
+    if (!PixelConversion::isSupported(kernel)) {
+        state.SkipWithError("Kernel isn't supported on this CPU");
+        return true;
+    }
+    state.SetLabel(PixelConversion::kernelName(kernel));
+    return false;
+}
+
+PixelConversion::Kernel kernelArg(const benchmark::State& state) {
+    return static_cast<PixelConversion::Kernel>(state.range(0));
+}
+
+void kernelArgs(benchmark::internal::Benchmark* b) {
+    for (auto kernel : {PixelConversion::Kernel::Scalar,
+                        PixelConversion::Kernel::SSE41,
+                        PixelConversion::Kernel::AVX2}) {
+        b->Arg(static_cast<int64_t>(kernel));
+    }
+}
+}  // namespace
+
+// Without a GL context the loader only parses the dictionary
+static void BM_LoaderTXD(benchmark::State& state) {
+    auto file = fixtures::makeTXD(static_cast<size_t>(state.range(0)), 128,
+                                  RW::BSTextureNative::FORMAT_EXT_PAL8 |
+                                      RW::BSTextureNative::FORMAT_8888);
+    TextureLoader loader;
+
+    for (auto _ : state) {
+        TextureArchive textures;
+        loader.loadFromMemory(file, textures);
+        benchmark::DoNotOptimize(textures.size());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+                            state.range(0));
+}
+BENCHMARK(BM_LoaderTXD)->Arg(1)->Arg(64);
+
+static void BM_ExpandPalette(benchmark::State& state) {
+    auto kernel = kernelArg(state);
+    if (skipUnsupported(state, kernel)) {
+        return;
+    }
+
+    std::vector<uint32_t> palette(256);
+    std::vector<uint8_t> indices(kPixels);
+    std::vector<uint32_t> out(kPixels);
+    for (size_t i = 0; i < kPixels; ++i) {
+        indices[i] = static_cast<uint8_t>(i * 7);
+    }
+
+    for (auto _ : state) {
+        PixelConversion::expandPalette(palette.data(), indices.data(),
+                                       out.data(), kPixels, kernel);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kPixels));
+}
+BENCHMARK(BM_ExpandPalette)->Apply(kernelArgs);
+
+static void BM_Convert1555(benchmark::State& state) {
+    auto kernel = kernelArg(state);
+    if (skipUnsupported(state, kernel)) {
+        return;
+    }
+
+    std::vector<uint16_t> in(kPixels);
+    std::vector<uint32_t> out(kPixels);
+    for (size_t i = 0; i < kPixels; ++i) {
+        in[i] = static_cast<uint16_t>(i * 31);
+    }
+
+    for (auto _ : state) {
+        PixelConversion::convert1555(in.data(), out.data(), kPixels, kernel);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kPixels));
+}
+BENCHMARK(BM_Convert1555)->Apply(kernelArgs);
+
+static void BM_Convert565(benchmark::State& state) {
+    auto kernel = kernelArg(state);
+    if (skipUnsupported(state, kernel)) {
+        return;
+    }
+
+    std::vector<uint16_t> in(kPixels);
+    std::vector<uint32_t> out(kPixels);
+    for (size_t i = 0; i < kPixels; ++i) {
+        in[i] = static_cast<uint16_t>(i * 31);
+    }
+
+    for (auto _ : state) {
+        PixelConversion::convert565(in.data(), out.data(), kPixels, kernel);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kPixels));
+}
+BENCHMARK(BM_Convert565)->Apply(kernelArgs);
+
+static void BM_SwizzleBGRA(benchmark::State& state) {
+    auto kernel = kernelArg(state);
+    if (skipUnsupported(state, kernel)) {
+        return;
+    }
+
+    std::vector<uint32_t> in(kPixels, 0x11223344u);
+    std::vector<uint32_t> out(kPixels);
+
+    for (auto _ : state) {
+        PixelConversion::swizzleBGRA(in.data(), out.data(), kPixels, kernel);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kPixels));
+}
+BENCHMARK(BM_SwizzleBGRA)->Apply(kernelArgs);
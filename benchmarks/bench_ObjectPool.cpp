@@ -0,0 +1,52 @@
+#include <benchmark/benchmark.h>
+#include <engine/GameWorld.hpp>
+#include <objects/GameObject.hpp>
+
+#include <memory>
+
+namespace {
+class BenchObject final : public GameObject {
+public:
+    BenchObject() : GameObject(nullptr, glm::vec3(), glm::quat(), nullptr) {
+    }
+
+    void tick(float) override {
+    }
+};
+}  // namespace
+
+// Objects without an ID get the lowest free one assigned on insertion
+static void BM_ObjectPoolInsert(benchmark::State& state) {
+    const auto count = static_cast<size_t>(state.range(0));
+
+    for (auto _ : state) {
+        GameWorld::ObjectPool pool;
+        for (size_t i = 0; i < count; ++i) {
+            pool.insert(std::make_unique<BenchObject>());
+        }
+        benchmark::DoNotOptimize(pool.objects.size());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+                            state.range(0));
+}
+BENCHMARK(BM_ObjectPoolInsert)->Arg(64)->Arg(512)->Arg(2048);
+
+static void BM_ObjectPoolFind(benchmark::State& state) {
+    const auto count = static_cast<GameObjectID>(state.range(0));
+
+    GameWorld::ObjectPool pool;
+    for (GameObjectID i = 0; i < count; ++i) {
+        pool.insert(std::make_unique<BenchObject>());
+    }
+
+    GameObjectID id = 0;
+    for (auto _ : state) {
+        // Every ID in turn, and one that isn't in the pool
+        benchmark::DoNotOptimize(pool.find(id));
+        id = id == count ? 0 : id + 1;
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_ObjectPoolFind)->Arg(64)->Arg(2048);
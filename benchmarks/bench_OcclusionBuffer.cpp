@@ -0,0 +1,78 @@
+#include <benchmark/benchmark.h>
+#include <data/CollisionModel.hpp>
+#include <render/OcclusionBuffer.hpp>
+#include <render/ViewCamera.hpp>
+
+#include <random>
+#include <vector>
+
+namespace {
+/// Camera at the origin looking down the X axis
+glm::mat4 cameraViewProjection() {
+    ViewCamera camera;
+    return camera.frustum.projection() * camera.getView();
+}
+
+/// A block of buildings in front of the camera, one box each
+std::vector<glm::mat4> makeBlock(CollisionModel& model) {
+    model.boxes.push_back(
+        {glm::vec3(-10.f, -10.f, 0.f), glm::vec3(10.f, 10.f, 40.f), {}});
+
+    std::vector<glm::mat4> transforms;
+    for (int x = 0; x < 4; ++x) {
+        for (int y = -4; y < 4; ++y) {
+            transforms.push_back(glm::translate(
+                glm::mat4(1.f), glm::vec3(40.f + x * 30.f, y * 30.f, -10.f)));
+        }
+    }
+    return transforms;
+}
+}  // namespace
+
+static void BM_OcclusionBufferRasterize(benchmark::State& state) {
+    CollisionModel model;
+    const auto transforms = makeBlock(model);
+    OcclusionBuffer buffer;
+    const auto viewProjection = cameraViewProjection();
+
+    for (auto _ : state) {
+        buffer.clear(viewProjection, 0.1f);
+        for (const auto& transform : transforms) {
+            buffer.addOccluder(model, transform);
+        }
+        benchmark::DoNotOptimize(buffer.getDepth(0, 0));
+    }
+
+    state.SetItemsProcessed(
+        static_cast<int64_t>(state.iterations() * transforms.size()));
+}
+BENCHMARK(BM_OcclusionBufferRasterize);
+
+static void BM_OcclusionBufferTest(benchmark::State& state) {
+    CollisionModel model;
+    OcclusionBuffer buffer;
+    buffer.clear(cameraViewProjection(), 0.1f);
+    for (const auto& transform : makeBlock(model)) {
+        buffer.addOccluder(model, transform);
+    }
+
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> depth(20.f, 300.f);
+    std::uniform_real_distribution<float> side(-100.f, 100.f);
+    std::uniform_real_distribution<float> radius(1.f, 10.f);
+    std::vector<std::pair<glm::vec3, float>> spheres;
+    for (int i = 0; i < 1024; ++i) {
+        spheres.emplace_back(glm::vec3(depth(rng), side(rng), side(rng)),
+                             radius(rng));
+    }
+
+    size_t i = 0;
+    for (auto _ : state) {
+        const auto& sphere = spheres[i++ % spheres.size()];
+        benchmark::DoNotOptimize(
+            buffer.isOccluded(sphere.first, sphere.second));
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_OcclusionBufferTest);
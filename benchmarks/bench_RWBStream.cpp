@@ -0,0 +1,34 @@
+#include <benchmark/benchmark.h>
+#include <loaders/RWBinaryStream.hpp>
+#include "bench_Fixtures.hpp"
+
+namespace {
+/// Visits every chunk of the stream and of the chunks nested inside it
+size_t countChunks(RWBStream stream, int depth) {
+    size_t chunks = 0;
+    for (auto id = stream.getNextChunk(); id != 0; id = stream.getNextChunk()) {
+        chunks++;
+        // Struct and string chunks hold data rather than chunks
+        if (depth > 0 && id != RW::SID_Struct && id != RW::SID_String) {
+            chunks += countChunks(stream.getInnerStream(), depth - 1);
+        }
+    }
+    return chunks;
+}
+}  // namespace
+
+static void BM_RWBStreamIterate(benchmark::State& state) {
+    auto file = fixtures::makeDFF(16, static_cast<size_t>(state.range(0)), 64,
+                                  true);
+
+    size_t chunks = 0;
+    for (auto _ : state) {
+        chunks = countChunks(RWBStream(file.data, file.length), 8);
+        benchmark::DoNotOptimize(chunks);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                            static_cast<int64_t>(file.length));
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * chunks));
+}
+BENCHMARK(BM_RWBStreamIterate)->Arg(1)->Arg(16)->Arg(128);
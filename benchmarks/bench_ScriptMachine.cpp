@@ -0,0 +1,42 @@
+#include <benchmark/benchmark.h>
+#include <core/Logger.hpp>
+#include <engine/GameData.hpp>
+#include <engine/GameState.hpp>
+#include <engine/GameWorld.hpp>
+#include <script/SCMFile.hpp>
+#include <script/ScriptMachine.hpp>
+#include <script/modules/GTA3Module.hpp>
+#include "bench_Fixtures.hpp"
+
+namespace {
+/// Instructions in each round besides the arithmetic ones
+constexpr int64_t kLoopOverhead = 6;
+}  // namespace
+
+// Each execute() runs the thread once round its loop, then it waits
+static void BM_ScriptMachineExecute(benchmark::State& state) {
+    const auto instructions = static_cast<size_t>(state.range(0));
+
+    Logger log;
+    GameData data(&log, "");
+    GameWorld world(&log, &data);
+    GameState gameState;
+    world.state = &gameState;
+    gameState.world = &world;
+
+    auto bytes = fixtures::makeSCM(instructions);
+    SCMFile file;
+    file.loadFile(bytes.data(), bytes.size());
+
+    GTA3Module module;
+    ScriptMachine machine(&gameState, file, &module);
+    machine.startThread(file.getCodeSection());
+
+    for (auto _ : state) {
+        machine.execute(1.f / 30.f);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+                            (state.range(0) + kLoopOverhead));
+}
+BENCHMARK(BM_ScriptMachineExecute)->Arg(16)->Arg(256);
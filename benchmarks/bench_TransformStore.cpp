@@ -0,0 +1,137 @@
+#include <benchmark/benchmark.h>
+#include <engine/GameWorld.hpp>
+#include <objects/GameObject.hpp>
+#include <objects/TransformStore.hpp>
+
+#include <glm/gtx/norm.hpp>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+class BenchObject final : public GameObject {
+    Type type_;
+
+public:
+    BenchObject(Type type, const glm::vec3& position)
+        : GameObject(nullptr, position, glm::quat(), nullptr), type_(type) {
+    }
+
+    Type type() const override {
+        return type_;
+    }
+
+    void tick(float) override {
+    }
+};
+
+// Around the number of characters and vehicles alive near the player
+constexpr size_t kDynamicObjects = 256;
+constexpr size_t kQueries = 64;
+constexpr float kRadius = 100.f;
+
+glm::vec3 randomPosition(std::mt19937& rng) {
+    // Raw mt19937 output is the same everywhere, distributions are not
+    const auto x = static_cast<float>(rng() % 4000) - 2000.f;
+    const auto y = static_cast<float>(rng() % 4000) - 2000.f;
+    return {x, y, 0.f};
+}
+
+/**
+ * The map objects of a city with a few hundred characters and vehicles,
+ * both in one store as well as in stores and pools of their own.
+ */
+struct City {
+    std::vector<std::unique_ptr<BenchObject>> owners;
+    TransformStore allTransforms;
+    TransformStore dynamicTransforms;
+    GameWorld::ObjectPool dynamicPool;
+    std::vector<glm::vec3> queries;
+
+    explicit City(size_t staticObjects) {
+        std::mt19937 rng(1);
+        owners.push_back(std::make_unique<BenchObject>(GameObject::Instance,
+                                                       glm::vec3()));
+        auto instance = owners.back().get();
+        for (size_t i = 0; i < staticObjects; ++i) {
+            allTransforms.create(instance, randomPosition(rng), glm::quat());
+        }
+
+        for (size_t i = 0; i < kDynamicObjects; ++i) {
+            const auto position = randomPosition(rng);
+            const auto type =
+                i % 2 ? GameObject::Character : GameObject::Vehicle;
+            auto object = std::make_unique<BenchObject>(type, position);
+            allTransforms.create(object.get(), position, glm::quat());
+            dynamicTransforms.create(object.get(), position, glm::quat());
+            dynamicPool.insert(std::move(object));
+        }
+
+        for (size_t i = 0; i < kQueries; ++i) {
+            queries.push_back(randomPosition(rng));
+        }
+    }
+};
+}  // namespace
+
+// Walking the ped and vehicle pools, each object is a pointer chase
+static void BM_DynamicRadiusQueryPool(benchmark::State& state) {
+    City city(static_cast<size_t>(state.range(0)));
+
+    size_t i = 0;
+    std::vector<glm::vec3> found;
+    for (auto _ : state) {
+        const auto& center = city.queries[i++ % kQueries];
+        found.clear();
+        for (const auto& object : city.dynamicPool.objects) {
+            const auto position = object.second->getPosition();
+            if (glm::distance2(center, position) <= kRadius * kRadius) {
+                found.push_back(position);
+            }
+        }
+        benchmark::DoNotOptimize(found.data());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_DynamicRadiusQueryPool)->Arg(10000)->Arg(20000);
+
+// Every object in one store, the map objects have to be filtered out
+static void BM_DynamicRadiusQueryAllTransforms(benchmark::State& state) {
+    City city(static_cast<size_t>(state.range(0)));
+
+    size_t i = 0;
+    std::vector<GameObject*> found;
+    for (auto _ : state) {
+        found.clear();
+        city.allTransforms.findInRadius(city.queries[i++ % kQueries], kRadius,
+                                        found);
+        size_t dynamic = 0;
+        for (auto object : found) {
+            dynamic += object->type() == GameObject::Character ||
+                       object->type() == GameObject::Vehicle;
+        }
+        benchmark::DoNotOptimize(dynamic);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_DynamicRadiusQueryAllTransforms)->Arg(10000)->Arg(20000);
+
+// Characters and vehicles in a store of their own, as in GameWorld
+static void BM_DynamicRadiusQueryDynamicTransforms(benchmark::State& state) {
+    City city(static_cast<size_t>(state.range(0)));
+
+    size_t i = 0;
+    std::vector<GameObject*> found;
+    for (auto _ : state) {
+        found.clear();
+        city.dynamicTransforms.findInRadius(city.queries[i++ % kQueries],
+                                            kRadius, found);
+        benchmark::DoNotOptimize(found.data());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_DynamicRadiusQueryDynamicTransforms)->Arg(10000)->Arg(20000);
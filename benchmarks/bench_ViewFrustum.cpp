@@ -0,0 +1,46 @@
+#include <benchmark/benchmark.h>
+#include <render/ViewFrustum.hpp>
+
+#include <glm/gtc/constants.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <random>
+#include <vector>
+
+namespace {
+struct Sphere {
+    glm::vec3 center;
+    float radius;
+};
+}  // namespace
+
+static void BM_ViewFrustumIntersects(benchmark::State& state) {
+    ViewFrustum frustum(0.1f, 1000.f, glm::half_pi<float>(), 16.f / 9.f);
+    frustum.update(frustum.projection() *
+                   glm::lookAt(glm::vec3(0.f), glm::vec3(0.f, 1.f, 0.f),
+                               glm::vec3(0.f, 0.f, 1.f)));
+
+    // A fixed seed, so every run tests the same spheres
+    std::mt19937 random(1234);
+    std::uniform_real_distribution<float> position(-1000.f, 1000.f);
+    std::uniform_real_distribution<float> radius(0.5f, 50.f);
+    std::vector<Sphere> spheres(static_cast<size_t>(state.range(0)));
+    for (auto& sphere : spheres) {
+        sphere = {{position(random), position(random), position(random)},
+                  radius(random)};
+    }
+
+    size_t visible = 0;
+    for (auto _ : state) {
+        visible = 0;
+        for (const auto& sphere : spheres) {
+            visible += frustum.intersects(sphere.center, sphere.radius);
+        }
+        benchmark::DoNotOptimize(visible);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+                            state.range(0));
+    state.counters["visible"] = static_cast<double>(visible);
+}
+BENCHMARK(BM_ViewFrustumIntersects)->Arg(10000);
@@ -0,0 +1,24 @@
+#include <benchmark/benchmark.h>
+#include <data/Weather.hpp>
+#include "bench_Fixtures.hpp"
+
+static void BM_WeatherInterpolate(benchmark::State& state) {
+    auto weather = fixtures::makeWeather();
+
+    // A transition is in progress half of the time
+    float timeOfDay = 0.f;
+    for (auto _ : state) {
+        float transition = timeOfDay - static_cast<int>(timeOfDay);
+        auto entry = weather.interpolate(WeatherCondition::Sunny,
+                                         WeatherCondition::Rainy,
+                                         transition * 2.f, timeOfDay);
+        benchmark::DoNotOptimize(entry);
+        timeOfDay += 0.013f;
+        if (timeOfDay >= 24.f) {
+            timeOfDay -= 24.f;
+        }
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_WeatherInterpolate);
@@ -0,0 +1,74 @@
+#include <benchmark/benchmark.h>
+#include <data/ZoneData.hpp>
+#include <data/ZoneIndex.hpp>
+#include "bench_Fixtures.hpp"
+
+#include <random>
+#include <vector>
+
+namespace {
+std::vector<glm::vec3> makePoints(size_t count) {
+    // Raw mt19937 output is the same everywhere, distributions are not
+    std::mt19937 rng(1);
+    std::vector<glm::vec3> points;
+    points.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        const auto x = static_cast<float>(rng() % 8000) - 4000.f;
+        const auto y = static_cast<float>(rng() % 8000) - 4000.f;
+        const auto z = static_cast<float>(rng() % 200) - 100.f;
+        points.emplace_back(x, y, z);
+    }
+    return points;
+}
+
+constexpr size_t kPoints = 1024;
+}  // namespace
+
+static void BM_ZoneFindLeafAtPoint(benchmark::State& state) {
+    auto zones = fixtures::makeZones(static_cast<size_t>(state.range(0)));
+    const auto points = makePoints(kPoints);
+
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            zones.front().findLeafAtPoint(points[i++ % kPoints]));
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_ZoneFindLeafAtPoint)->Arg(50)->Arg(500);
+
+static void BM_ZoneIndexFind(benchmark::State& state) {
+    auto zones = fixtures::makeZones(static_cast<size_t>(state.range(0)));
+    const auto points = makePoints(kPoints);
+    ZoneIndex index;
+    index.build(zones.front());
+
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(index.find(points[i++ % kPoints]));
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_ZoneIndexFind)->Arg(50)->Arg(500);
+
+// A camera moving through the map, the way the traffic director looks up
+static void BM_ZoneIndexFindCached(benchmark::State& state) {
+    auto zones = fixtures::makeZones(static_cast<size_t>(state.range(0)));
+    ZoneIndex index;
+    index.build(zones.front());
+    ZoneIndex::Cache cache;
+
+    glm::vec3 point(-3999.f, -2950.f, 0.f);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(index.find(point, cache));
+        point.x += 0.5f;
+        if (point.x > 3999.f) {
+            point.x = -3999.f;
+        }
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_ZoneIndexFindCached)->Arg(50)->Arg(500);
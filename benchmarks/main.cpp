@@ -0,0 +1,14 @@
+#include <benchmark/benchmark.h>
+#include <gl/Headless.hpp>
+
+int main(int argc, char** argv) {
+    // Loaders skip their GL uploads, so only the parsing is measured
+    gl::setHeadless(true);
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
@@ -142,6 +142,14 @@ if(ENABLE_SCRIPT_DEBUG)
     )
 endif()
 
+if(ENABLE_PROFILING)
+    if(PROFILING_BACKEND STREQUAL "TRACE")
+        target_compile_definitions(rw_interface INTERFACE "RW_PROFILER_TRACE")
+    elseif(NOT PROFILING_BACKEND STREQUAL "MICROPROFILE")
+        message(FATAL_ERROR "Illegal PROFILING_BACKEND option. (was '${PROFILING_BACKEND}')")
+    endif()
+endif()
+
 if(FAILED_CHECK_ACTION STREQUAL "IGNORE")
     target_compile_definitions(rw_interface INTERFACE "RW_FAILED_CHECK_ACTION=0")
 elseif(FAILED_CHECK_ACTION STREQUAL "ABORT")
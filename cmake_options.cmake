@@ -2,10 +2,13 @@ option(RW_VERBOSE_DEBUG_MESSAGES "Print verbose debugging messages" ON)
 
 option(BUILD_TOOLS "Build tools")
 option(BUILD_TESTS "Build test suite")
+option(BUILD_BENCHMARKS "Build micro benchmarks (requires Google Benchmark)")
 option(BUILD_VIEWER "Build GUI data viewer")
 
 option(ENABLE_SCRIPT_DEBUG "Enable verbose script execution")
 option(ENABLE_PROFILING "Enable detailed profiling metrics")
+set(PROFILING_BACKEND "MICROPROFILE" CACHE STRING "Where profiling metrics go: the microprofile web UI, or Chrome trace files")
+set_property(CACHE PROFILING_BACKEND PROPERTY STRINGS "MICROPROFILE" "TRACE")
 
 option(TEST_DATA "Enable tests that require game data")
 
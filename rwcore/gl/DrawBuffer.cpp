@@ -4,6 +4,7 @@
 
 #include <gl/gl_core_3_3.h>
 #include <gl/GeometryBuffer.hpp>
+#include <gl/Headless.hpp>
 
 DrawBuffer::DrawBuffer() : vao(0) {
 }
@@ -15,6 +16,9 @@ DrawBuffer::~DrawBuffer() {
 }
 
 void DrawBuffer::addGeometry(GeometryBuffer* gbuff) {
+    if (gl::isHeadless()) {
+        return;
+    }
     if (vao == 0) {
         glGenVertexArrays(1, &vao);
     }
@@ -77,6 +77,12 @@ public:
      */
     void uploadVertices(GLsizei num, GLsizeiptr size, const GLvoid* mem);
 
+    /**
+     * Replaces part of the buffer's contents, the buffer must already have
+     * been allocated by uploadVertices().
+     */
+    void uploadSubData(GLintptr offset, GLsizeiptr size, const GLvoid* mem);
+
     const AttributeList& getDataAttributes() const {
         return attributes;
     }
@@ -0,0 +1,17 @@
+#include "gl/Headless.hpp"
+
+namespace {
+bool gHeadless = false;
+}  // namespace
+
+namespace gl {
+
+bool isHeadless() {
+    return gHeadless;
+}
+
+void setHeadless(bool headless) {
+    gHeadless = headless;
+}
+
+}  // namespace gl
@@ -0,0 +1,21 @@
+#ifndef _LIBRW_HEADLESS_HPP_
+#define _LIBRW_HEADLESS_HPP_
+
+namespace gl {
+
+/**
+ * @brief Whether there is no GL context to use.
+ *
+ * In headless mode the GL wrappers and the loaders never touch GL. Models and
+ * textures are still loaded, keeping the data the simulation needs (bounds,
+ * materials, indices, texture sizes) while the GPU objects are left at 0.
+ *
+ * Must be set before anything is loaded.
+ */
+bool isHeadless();
+
+void setHeadless(bool headless);
+
+}  // namespace gl
+
+#endif
@@ -18,7 +18,9 @@ public:
     }
 
     ~TextureData() {
-        glDeleteTextures(1, &texName);
+        if (texName != 0) {
+            glDeleteTextures(1, &texName);
+        }
     }
 
     GLuint getName() const {
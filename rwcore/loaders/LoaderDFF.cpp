@@ -11,6 +11,7 @@
 #include <glm/glm.hpp>
 
 #include "data/Clump.hpp"
+#include "gl/Headless.hpp"
 #include "gl/gl_core_3_3.h"
 #include "loaders/RWBinaryStream.hpp"
 #include "platform/FileHandle.hpp"
@@ -49,6 +50,62 @@ struct RWBSFrame {
     uint32_t matrixflags;  // Not used
 };
 
+namespace {
+/**
+ * Bounds checked reads from the data of the current chunk in a stream.
+ *
+ * Values are copied out with memcpy, so the chunk data doesn't need to be
+ * aligned.
+ */
+class ChunkReader {
+    const char* _cur;
+    const char* _end;
+
+public:
+    explicit ChunkReader(const RWBStream& stream)
+        : _cur(stream.getCursor())
+        , _end(stream.getCursor() + stream.getCurrentChunkSize()) {
+    }
+
+    /**
+     * @return a pointer to the next bytes bytes of the chunk
+     * @throws DFFLoaderException if the chunk is too short
+     */
+    const char* take(size_t bytes) {
+        if (bytes > remaining()) {
+            throw DFFLoaderException("Unexpected end of chunk");
+        }
+        auto data = _cur;
+        _cur += bytes;
+        return data;
+    }
+
+    /// Bounds checked take() of count elements of T
+    template <class T>
+    const char* takeArray(size_t count) {
+        if (count > remaining() / sizeof(T)) {
+            throw DFFLoaderException("Unexpected end of chunk");
+        }
+        return take(count * sizeof(T));
+    }
+
+    template <class T>
+    T read() {
+        T value;
+        std::memcpy(&value, take(sizeof(T)), sizeof(T));
+        return value;
+    }
+
+    void skip(size_t bytes) {
+        take(bytes);
+    }
+
+    size_t remaining() const {
+        return static_cast<size_t>(_end - _cur);
+    }
+};
+}  // namespace
+
 LoaderDFF::FrameList LoaderDFF::readFrameList(const RWBStream &stream) {
     auto listStream = stream.getInnerStream();
 
@@ -57,25 +114,26 @@ LoaderDFF::FrameList LoaderDFF::readFrameList(const RWBStream &stream) {
         throw DFFLoaderException("Frame List missing struct chunk");
     }
 
-    char *headerPtr = listStream.getCursor();
+    ChunkReader header(listStream);
 
-    unsigned int numFrames = *reinterpret_cast<std::uint32_t *>(headerPtr);
-    headerPtr += sizeof(std::uint32_t);
+    unsigned int numFrames = header.read<std::uint32_t>();
+    if (numFrames > header.remaining() / sizeof(RWBSFrame)) {
+        throw DFFLoaderException("Frame List is truncated");
+    }
 
     FrameList framelist;
     framelist.reserve(numFrames);
 
     for (auto f = 0u; f < numFrames; ++f) {
-        auto data = reinterpret_cast<RWBSFrame *>(headerPtr);
-        headerPtr += sizeof(RWBSFrame);
+        auto data = header.read<RWBSFrame>();
         auto frame =
-            std::make_shared<ModelFrame>(f, data->rotation, data->position);
+            std::make_shared<ModelFrame>(f, data.rotation, data.position);
 
-        RW_CHECK(data->index < static_cast<int>(framelist.size()),
+        RW_CHECK(data.index < static_cast<int>(framelist.size()),
                  "Frame parent out of bounds");
-        if (data->index != -1 &&
-            data->index < static_cast<int>(framelist.size())) {
-            framelist[data->index]->addChild(frame);
+        if (data.index != -1 &&
+            data.index < static_cast<int>(framelist.size())) {
+            framelist[data.index]->addChild(frame);
         }
 
         framelist.push_back(frame);
@@ -123,13 +181,13 @@ LoaderDFF::GeometryList LoaderDFF::readGeometryList(const RWBStream &stream) {
         throw DFFLoaderException("Geometry List missing struct chunk");
     }
 
-    char *headerPtr = listStream.getCursor();
-
-    unsigned int numGeometries = bit_cast<std::uint32_t>(*headerPtr);
-    headerPtr += sizeof(std::uint32_t);
+    unsigned int numGeometries = ChunkReader(listStream).read<std::uint32_t>();
 
+    // Each geometry is at least a chunk header, don't trust the count further
     std::vector<GeometryPtr> geometrylist;
-    geometrylist.reserve(numGeometries);
+    geometrylist.reserve(std::min<size_t>(
+        numGeometries,
+        stream.getCurrentChunkSize() / RWBStream::kChunkHeaderSize));
 
     for (auto chunkID = listStream.getNextChunk(); chunkID != 0;
          chunkID = listStream.getNextChunk()) {
@@ -155,85 +213,107 @@ GeometryPtr LoaderDFF::readGeometry(const RWBStream &stream) {
 
     auto geom = std::make_shared<Geometry>();
 
-    char *headerPtr = geomStream.getCursor();
-
-    geom->flags = bit_cast<std::uint16_t>(*headerPtr);
-    headerPtr += sizeof(std::uint16_t);
+    ChunkReader header(geomStream);
 
-    /*unsigned short numUVs = bit_cast<std::uint8_t>(*headerPtr);*/
-    headerPtr += sizeof(std::uint8_t);
-    /*unsigned short moreFlags = bit_cast<std::uint8_t>(*headerPtr);*/
-    headerPtr += sizeof(std::uint8_t);
+    geom->flags = header.read<std::uint16_t>();
 
-    unsigned int numTris = bit_cast<std::uint32_t>(*headerPtr);
-    headerPtr += sizeof(std::uint32_t);
-    unsigned int numVerts = bit_cast<std::uint32_t>(*headerPtr);
-    headerPtr += sizeof(std::uint32_t);
+    /*unsigned short numUVs = header.read<std::uint8_t>();*/
+    header.skip(sizeof(std::uint8_t));
+    /*unsigned short moreFlags = header.read<std::uint8_t>();*/
+    header.skip(sizeof(std::uint8_t));
 
-    /*unsigned int numFrames = bit_cast<std::uint32_t>(*headerPtr);*/
-    headerPtr += sizeof(std::uint32_t);
+    unsigned int numTris = header.read<std::uint32_t>();
+    unsigned int numVerts = header.read<std::uint32_t>();
 
-    std::vector<GeometryVertex> verts;
-    verts.resize(numVerts);
+    /*unsigned int numFrames = header.read<std::uint32_t>();*/
+    header.skip(sizeof(std::uint32_t));
 
     if (geomStream.getChunkVersion() < 0x1003FFFF) {
-        headerPtr += sizeof(RW::BSGeometryColor);
+        header.skip(sizeof(RW::BSGeometryColor));
     }
 
     /// @todo extract magic numbers.
 
+    const char *colours = nullptr;
     if ((geom->flags & 8) == 8) {
-        for (size_t v = 0; v < numVerts; ++v) {
-            verts[v].colour = bit_cast<glm::u8vec4>(*headerPtr);
-            headerPtr += sizeof(glm::u8vec4);
-        }
-    } else {
-        for (size_t v = 0; v < numVerts; ++v) {
-            verts[v].colour = {255, 255, 255, 255};
-        }
+        colours = header.takeArray<glm::u8vec4>(numVerts);
     }
 
+    const char *texcoords = nullptr;
     if ((geom->flags & 4) == 4 || (geom->flags & 128) == 128) {
-        for (size_t v = 0; v < numVerts; ++v) {
-            verts[v].texcoord = bit_cast<glm::vec2>(*headerPtr);
-            headerPtr += sizeof(glm::vec2);
-        }
+        texcoords = header.takeArray<glm::vec2>(numVerts);
     }
 
     // Grab indicies data to generate normals (if applicable).
-    auto triangles = std::make_unique<RW::BSGeometryTriangle[]>(numTris);
-    memcpy(triangles.get(), headerPtr, sizeof(RW::BSGeometryTriangle) * numTris);
-    headerPtr += sizeof(RW::BSGeometryTriangle) * numTris;
+    const char *triangles =
+        header.takeArray<RW::BSGeometryTriangle>(numTris);
 
-    geom->geometryBounds = bit_cast<RW::BSGeometryBounds>(*headerPtr);
+    geom->geometryBounds = header.read<RW::BSGeometryBounds>();
     geom->geometryBounds.radius = std::abs(geom->geometryBounds.radius);
-    headerPtr += sizeof(RW::BSGeometryBounds);
 
-    for (size_t v = 0; v < numVerts; ++v) {
-        verts[v].position = bit_cast<glm::vec3>(*headerPtr);
-        headerPtr += sizeof(glm::vec3);
-    }
+    const char *positions = header.takeArray<glm::vec3>(numVerts);
 
+    // Attributes missing from the file are generated here, everything else
+    // is uploaded straight out of the file data.
+    std::vector<glm::vec3> generatedNormals;
+    std::vector<glm::u8vec4> generatedColours;
+
+    const char *normals = nullptr;
     if ((geom->flags & 16) == 16) {
-        for (size_t v = 0; v < numVerts; ++v) {
-            verts[v].normal = bit_cast<glm::vec3>(*headerPtr);
-            headerPtr += sizeof(glm::vec3);
-        }
+        normals = header.takeArray<glm::vec3>(numVerts);
     } else {
         // Use triangle data to calculate normals for each vert.
+        generatedNormals.resize(numVerts);
+        auto position = [&](size_t v) {
+            return bit_cast<glm::vec3>(positions[v * sizeof(glm::vec3)]);
+        };
         for (size_t t = 0; t < numTris; ++t) {
-            auto &triangle = triangles[t];
-            auto &A = verts[triangle.first];
-            auto &B = verts[triangle.second];
-            auto &C = verts[triangle.third];
-            auto normal = glm::normalize(
-                glm::cross(C.position - A.position, B.position - A.position));
-            A.normal = normal;
-            B.normal = normal;
-            C.normal = normal;
+            auto triangle = bit_cast<RW::BSGeometryTriangle>(
+                triangles[t * sizeof(RW::BSGeometryTriangle)]);
+            if (triangle.first >= numVerts || triangle.second >= numVerts ||
+                triangle.third >= numVerts) {
+                throw DFFLoaderException("Triangle vertex out of bounds");
+            }
+            auto A = position(triangle.first);
+            auto B = position(triangle.second);
+            auto C = position(triangle.third);
+            auto normal = glm::normalize(glm::cross(C - A, B - A));
+            generatedNormals[triangle.first] = normal;
+            generatedNormals[triangle.second] = normal;
+            generatedNormals[triangle.third] = normal;
         }
+        normals = reinterpret_cast<const char *>(generatedNormals.data());
     }
 
+    if (!colours) {
+        generatedColours.resize(numVerts, {255, 255, 255, 255});
+        colours = reinterpret_cast<const char *>(generatedColours.data());
+    }
+
+    // The attributes are stored one after another rather than interleaved,
+    // so that each can be copied into the buffer without rearranging it.
+    size_t vertexSize = sizeof(glm::vec3) * 2 + sizeof(glm::u8vec4) +
+                        (texcoords ? sizeof(glm::vec2) : 0);
+    geom->gbuff.uploadVertices(static_cast<GLsizei>(numVerts),
+                               vertexSize * numVerts, nullptr);
+
+    auto &attributes = geom->gbuff.getDataAttributes();
+    size_t offset = 0;
+    auto uploadAttribute = [&](AttributeSemantic sem, GLsizei size,
+                               GLsizei stride, GLenum type, const char *data) {
+        geom->gbuff.uploadSubData(offset, stride * numVerts, data);
+        attributes.emplace_back(sem, size, stride, offset, type);
+        offset += stride * numVerts;
+    };
+    uploadAttribute(ATRS_Position, 3, sizeof(glm::vec3), GL_FLOAT, positions);
+    uploadAttribute(ATRS_Normal, 3, sizeof(glm::vec3), GL_FLOAT, normals);
+    if (texcoords) {
+        uploadAttribute(ATRS_TexCoord, 2, sizeof(glm::vec2), GL_FLOAT,
+                        texcoords);
+    }
+    uploadAttribute(ATRS_Colour, 4, sizeof(glm::u8vec4), GL_UNSIGNED_BYTE,
+                    colours);
+
     // Process the geometry child sections
     for (auto chunkID = geomStream.getNextChunk(); chunkID != 0;
          chunkID = geomStream.getNextChunk()) {
@@ -252,9 +332,13 @@ GeometryPtr LoaderDFF::readGeometry(const RWBStream &stream) {
     geom->dbuff.setFaceType(geom->facetype == Geometry::Triangles
                                 ? GL_TRIANGLES
                                 : GL_TRIANGLE_STRIP);
-    geom->gbuff.uploadVertices(verts);
     geom->dbuff.addGeometry(&geom->gbuff);
 
+    // The indices stay in subgeom either way
+    if (gl::isHeadless()) {
+        return geom;
+    }
+
     glGenBuffers(1, &geom->EBO);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, geom->EBO);
 
@@ -279,9 +363,11 @@ void LoaderDFF::readMaterialList(const GeometryPtr &geom, const RWBStream &strea
         throw DFFLoaderException("MaterialList missing struct chunk");
     }
 
-    unsigned int numMaterials = bit_cast<std::uint32_t>(*listStream.getCursor());
+    unsigned int numMaterials = ChunkReader(listStream).read<std::uint32_t>();
 
-    geom->materials.reserve(numMaterials);
+    geom->materials.reserve(std::min<size_t>(
+        numMaterials,
+        stream.getCurrentChunkSize() / RWBStream::kChunkHeaderSize));
 
     RWBStream::ChunkID chunkID;
     while ((chunkID = listStream.getNextChunk())) {
@@ -303,28 +389,25 @@ void LoaderDFF::readMaterial(const GeometryPtr &geom, const RWBStream &stream) {
         throw DFFLoaderException("Material missing struct chunk");
     }
 
-    char *matData = materialStream.getCursor();
+    ChunkReader matData(materialStream);
 
     Geometry::Material material;
 
     // Unkown
-    matData += sizeof(std::uint32_t);
-    material.colour = bit_cast<glm::u8vec4>(*matData);
+    matData.skip(sizeof(std::uint32_t));
+    material.colour = matData.read<glm::u8vec4>();
 
-    matData += sizeof(std::uint32_t);
     // Unkown
-    matData += sizeof(std::uint32_t);
-    /*bool usesTexture = bit_cast<std::uint32_t>(*matData);*/
-    matData += sizeof(std::uint32_t);
+    matData.skip(sizeof(std::uint32_t));
+    /*bool usesTexture = matData.read<std::uint32_t>();*/
+    matData.skip(sizeof(std::uint32_t));
 
-    material.ambientIntensity = bit_cast<float>(*matData);
-    matData += sizeof(float);
+    material.ambientIntensity = matData.read<float>();
 
-    /*float specular = bit_cast<float>(*matData);*/
-    matData += sizeof(float);
+    /*float specular = matData.read<float>();*/
+    matData.skip(sizeof(float));
 
-    material.diffuseIntensity = bit_cast<float>(*matData);
-    matData += sizeof(float);
+    material.diffuseIntensity = matData.read<float>();
     material.flags = 0;
 
     RWBStream::ChunkID chunkID;
@@ -352,13 +435,18 @@ void LoaderDFF::readTexture(Geometry::Material &material,
 
     // There's some data in the Texture's struct, but we don't know what it is.
 
-    /// @todo improve how these strings are read.
-    std::string name, alpha;
+    // The strings are null terminated, unless they fill their whole chunk
+    auto readString = [&texStream]() {
+        if (!texStream.getNextChunk()) {
+            throw DFFLoaderException("Texture missing name");
+        }
+        const char *str = texStream.getCursor();
+        const char *end = str + texStream.getCurrentChunkSize();
+        return std::string(str, std::find(str, end, '\0'));
+    };
 
-    texStream.getNextChunk();
-    name = texStream.getCursor();
-    texStream.getNextChunk();
-    alpha = texStream.getCursor();
+    std::string name = readString();
+    std::string alpha = readString();
 
     std::transform(name.begin(), name.end(), name.begin(), ::tolower);
     std::transform(alpha.begin(), alpha.end(), alpha.begin(), ::tolower);
@@ -385,34 +473,34 @@ void LoaderDFF::readGeometryExtension(const GeometryPtr &geom,
 }
 
 void LoaderDFF::readBinMeshPLG(const GeometryPtr &geom, const RWBStream &stream) {
-    auto data = stream.getCursor();
+    ChunkReader data(stream);
 
-    geom->facetype = static_cast<Geometry::FaceType>(bit_cast<std::uint32_t>(*data));
-    data += sizeof(std::uint32_t);
+    geom->facetype =
+        static_cast<Geometry::FaceType>(data.read<std::uint32_t>());
 
-    unsigned int numSplits = bit_cast<std::uint32_t>(*data);
-    data += sizeof(std::uint32_t);
+    unsigned int numSplits = data.read<std::uint32_t>();
 
     // Number of triangles.
-    data += sizeof(std::uint32_t);
+    data.skip(sizeof(std::uint32_t));
 
+    if (numSplits > data.remaining() / sizeof(RW::BSMaterialSplit)) {
+        throw DFFLoaderException("BinMeshPLG is truncated");
+    }
     geom->subgeom.reserve(numSplits);
 
     size_t start = 0;
 
     for (size_t s = 0; s < numSplits; ++s) {
         SubGeometry sg;
-        sg.numIndices = bit_cast<std::uint32_t>(*data);
-        data += sizeof(std::uint32_t);
-        sg.material = bit_cast<std::uint32_t>(*data);
-        data += sizeof(std::uint32_t);
+        sg.numIndices = data.read<std::uint32_t>();
+        sg.material = data.read<std::uint32_t>();
         sg.start = start;
         start += sg.numIndices;
 
+        auto indices = data.takeArray<std::uint32_t>(sg.numIndices);
         sg.indices.resize(sg.numIndices);
-        std::memcpy(sg.indices.data(), data,
+        std::memcpy(sg.indices.data(), indices,
                     sizeof(std::uint32_t) * sg.numIndices);
-        data += sizeof(std::uint32_t) * sg.numIndices;
 
         geom->subgeom.push_back(std::move(sg));
     }
@@ -428,14 +516,10 @@ AtomicPtr LoaderDFF::readAtomic(FrameList &framelist,
         throw DFFLoaderException("Atomic missing struct chunk");
     }
 
-    auto data = atomicStream.getCursor();
-    std::uint32_t frame = bit_cast<std::uint32_t>(*data);
-    data += sizeof(std::uint32_t);
-
-    std::uint32_t geometry = bit_cast<std::uint32_t>(*data);
-    data += sizeof(std::uint32_t);
-
-    std::uint32_t flags = bit_cast<std::uint32_t>(*data);
+    ChunkReader data(atomicStream);
+    std::uint32_t frame = data.read<std::uint32_t>();
+    std::uint32_t geometry = data.read<std::uint32_t>();
+    std::uint32_t flags = data.read<std::uint32_t>();
 
     // Verify the atomic's particulars
     RW_CHECK(frame < framelist.size(), "atomic frame " << frame
@@ -456,9 +540,18 @@ AtomicPtr LoaderDFF::readAtomic(FrameList &framelist,
 }
 
 ClumpPtr LoaderDFF::loadFromMemory(const FileContentsInfo& file) {
-    auto model = std::make_shared<Clump>();
+    RWBStream rootStream(file.data, file.length);
 
-    RWBStream rootStream(file.data.get(), file.length);
+    try {
+        return readClump(rootStream);
+    } catch (DFFLoaderException& e) {
+        RW_ERROR("Failed to load DFF: " << e.which());
+        return nullptr;
+    }
+}
+
+ClumpPtr LoaderDFF::readClump(RWBStream& rootStream) {
+    auto model = std::make_shared<Clump>();
 
     auto rootID = rootStream.getNextChunk();
     if (rootID != CHUNK_CLUMP) {
@@ -473,7 +566,7 @@ ClumpPtr LoaderDFF::loadFromMemory(const FileContentsInfo& file) {
     }
 
     // There is only one value in the struct section.
-    std::uint32_t numAtomics = bit_cast<std::uint32_t>(*rootStream.getCursor());
+    std::uint32_t numAtomics = ChunkReader(modelStream).read<std::uint32_t>();
     RW_UNUSED(numAtomics);
 
     GeometryList geometrylist;
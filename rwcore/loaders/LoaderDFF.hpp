@@ -30,6 +30,10 @@ public:
     using GeometryList = std::vector<GeometryPtr>;
     using FrameList = std::vector<ModelFramePtr>;
 
+    /**
+     * Parses a clump directly from the file's data
+     * @return the clump, or nullptr if the data isn't a valid clump
+     */
     ClumpPtr loadFromMemory(const FileContentsInfo& file);
 
     void setTextureLookupCallback(const TextureLookupCallback& tlc) {
@@ -39,6 +43,8 @@ public:
 private:
     TextureLookupCallback texturelookup;
 
+    ClumpPtr readClump(RWBStream& rootStream);
+
     FrameList readFrameList(const RWBStream& stream);
 
     GeometryList readGeometryList(const RWBStream& stream);
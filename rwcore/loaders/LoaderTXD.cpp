@@ -4,10 +4,13 @@
 #include <cctype>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <string>
 #include <vector>
 
+#include "gl/Headless.hpp"
 #include "gl/gl_core_3_3.h"
+#include "loaders/PixelConversion.hpp"
 #include "loaders/RWBinaryStream.hpp"
 #include "platform/FileHandle.hpp"
 #include "rw/debug.hpp"
@@ -22,6 +25,12 @@ static
 TextureData::Handle getErrorTexture() {
     static GLuint errTexName = 0;
     static TextureData::Handle tex;
+    if (gl::isHeadless()) {
+        if (!tex) {
+            tex = TextureData::create(0, {2, 2}, false);
+        }
+        return tex;
+    }
     if (errTexName == 0) {
         glGenTextures(1, &errTexName);
         glBindTexture(GL_TEXTURE_2D, errTexName);
@@ -34,26 +43,75 @@ TextureData::Handle getErrorTexture() {
     return tex;
 }
 
-const size_t paletteSize = 1024;
+const size_t paletteSize8 = 256 * sizeof(uint32_t);
+const size_t paletteSize4 = 32 * sizeof(uint32_t);
+
+// The struct of a native texture is the BSTextureNative header, without its
+// datasize field, followed by the raster.
+const size_t nativeHeaderSize = offsetof(RW::BSTextureNative, datasize);
 
 static
-void processPalette(uint32_t* fullColor, RW::BinaryStreamSection& rootSection) {
-    uint8_t* dataBase = reinterpret_cast<uint8_t*>(
-        rootSection.raw() + sizeof(RW::BSSectionHeader) +
-        sizeof(RW::BSTextureNative) - 4);
+bool processPalette(uint32_t* fullColor, size_t pixels, bool isPal4,
+                    const uint8_t* raster, size_t rasterSize) {
+    size_t paletteSize = isPal4 ? paletteSize4 : paletteSize8;
+    if (rasterSize < paletteSize + sizeof(uint32_t)) {
+        return false;
+    }
+
+    // PAL4 palettes are padded out to 256 entries so that both formats
+    // share one lookup kernel, and stray indices can't read past the end.
+    uint32_t palette[256] = {};
+    std::memcpy(palette, raster, paletteSize);
 
-    uint8_t* coldata = (dataBase + paletteSize + sizeof(uint32_t));
-    uint32_t raster_size = *reinterpret_cast<uint32_t*>(dataBase + paletteSize);
-    uint32_t* palette = reinterpret_cast<uint32_t*>(dataBase);
+    uint32_t raster_size;
+    std::memcpy(&raster_size, raster + paletteSize, sizeof(uint32_t));
+    const uint8_t* coldata = raster + paletteSize + sizeof(uint32_t);
+    size_t available = rasterSize - paletteSize - sizeof(uint32_t);
 
-    for (size_t j = 0; j < raster_size; ++j) {
-        *(fullColor++) = palette[coldata[j]];
+    PixelConversion::expandPalette(
+        palette, coldata, fullColor,
+        std::min<size_t>({raster_size, available, pixels}));
+    return true;
+}
+
+static
+bool processFullColor(uint32_t* fullColor, size_t pixels, uint32_t format,
+                      const uint8_t* raster, size_t rasterSize) {
+    if (rasterSize < sizeof(uint32_t)) {
+        return false;
+    }
+
+    uint32_t raster_size;
+    std::memcpy(&raster_size, raster, sizeof(uint32_t));
+    const uint8_t* coldata = raster + sizeof(uint32_t);
+    size_t available =
+        std::min<size_t>(raster_size, rasterSize - sizeof(uint32_t));
+
+    switch (format) {
+        case RW::BSTextureNative::FORMAT_1555:
+            PixelConversion::convert1555(
+                reinterpret_cast<const uint16_t*>(coldata), fullColor,
+                std::min<size_t>(available / sizeof(uint16_t), pixels));
+            return true;
+        case RW::BSTextureNative::FORMAT_565:
+            PixelConversion::convert565(
+                reinterpret_cast<const uint16_t*>(coldata), fullColor,
+                std::min<size_t>(available / sizeof(uint16_t), pixels));
+            return true;
+        case RW::BSTextureNative::FORMAT_8888:
+        case RW::BSTextureNative::FORMAT_888:
+            PixelConversion::swizzleBGRA(
+                reinterpret_cast<const uint32_t*>(coldata), fullColor,
+                std::min<size_t>(available / sizeof(uint32_t), pixels));
+            return true;
+        default:
+            return false;
     }
 }
 
 static
 TextureData::Handle createTexture(RW::BSTextureNative& texNative,
-                                  RW::BinaryStreamSection& rootSection) {
+                                  const uint8_t* raster, size_t rasterSize) {
     // TODO: Exception handling.
     if (texNative.platform != 8) {
         RW_ERROR("Unsupported texture platform " << std::dec
@@ -64,64 +122,54 @@ TextureData::Handle createTexture(RW::BSTextureNative& texNative,
     bool isPal8 =
         (texNative.rasterformat & RW::BSTextureNative::FORMAT_EXT_PAL8) ==
         RW::BSTextureNative::FORMAT_EXT_PAL8;
+    bool isPal4 =
+        (texNative.rasterformat & RW::BSTextureNative::FORMAT_EXT_PAL4) ==
+        RW::BSTextureNative::FORMAT_EXT_PAL4;
     bool isFulc = texNative.rasterformat == RW::BSTextureNative::FORMAT_1555 ||
+                  texNative.rasterformat == RW::BSTextureNative::FORMAT_565 ||
                   texNative.rasterformat == RW::BSTextureNative::FORMAT_8888 ||
                   texNative.rasterformat == RW::BSTextureNative::FORMAT_888;
     // Export this value
     bool transparent =
         !((texNative.rasterformat & RW::BSTextureNative::FORMAT_888) ==
-          RW::BSTextureNative::FORMAT_888);
+              RW::BSTextureNative::FORMAT_888 ||
+          texNative.rasterformat == RW::BSTextureNative::FORMAT_565);
 
-    if (!(isPal8 || isFulc)) {
+    if (!(isPal8 || isPal4 || isFulc)) {
         RW_ERROR("Unsupported raster format " << std::dec
                   << texNative.rasterformat);
         return getErrorTexture();
     }
 
-    GLuint textureName = 0;
+    // Nothing samples the pixels without a GL context, only the size and
+    // transparency are used.
+    if (gl::isHeadless()) {
+        return TextureData::create(0, {texNative.width, texNative.height},
+                                   transparent);
+    }
 
-    if (isPal8) {
-        std::vector<uint32_t> fullColor(texNative.width * texNative.height);
-
-        processPalette(fullColor.data(), rootSection);
-
-        glGenTextures(1, &textureName);
-        glBindTexture(GL_TEXTURE_2D, textureName);
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, texNative.width,
-                     texNative.height, 0, GL_RGBA, GL_UNSIGNED_BYTE,
-                     fullColor.data());
-    } else if (isFulc) {
-        auto coldata = rootSection.raw() + sizeof(RW::BSTextureNative);
-        coldata += sizeof(uint32_t);
-
-        GLenum type = GL_UNSIGNED_BYTE, format = GL_RGBA;
-        switch (texNative.rasterformat) {
-            case RW::BSTextureNative::FORMAT_1555:
-                format = GL_RGBA;
-                type = GL_UNSIGNED_SHORT_1_5_5_5_REV;
-                break;
-            case RW::BSTextureNative::FORMAT_8888:
-                format = GL_BGRA;
-                // type = GL_UNSIGNED_INT_8_8_8_8_REV;
-                coldata += 8;
-                type = GL_UNSIGNED_BYTE;
-                break;
-            case RW::BSTextureNative::FORMAT_888:
-                format = GL_BGRA;
-                type = GL_UNSIGNED_BYTE;
-                break;
-            default:
-                break;
-        }
+    // Everything is expanded to RGBA8888 on the CPU so the driver doesn't
+    // have to convert anything during the upload.
+    size_t pixels = static_cast<size_t>(texNative.width) * texNative.height;
+    std::vector<uint32_t> fullColor(pixels);
 
-        glGenTextures(1, &textureName);
-        glBindTexture(GL_TEXTURE_2D, textureName);
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, texNative.width,
-                     texNative.height, 0, format, type, coldata);
-    } else {
+    bool converted =
+        (isPal8 || isPal4)
+            ? processPalette(fullColor.data(), pixels, isPal4, raster,
+                             rasterSize)
+            : processFullColor(fullColor.data(), pixels,
+                               texNative.rasterformat, raster, rasterSize);
+    if (!converted) {
+        RW_ERROR("Texture raster is truncated");
         return getErrorTexture();
     }
 
+    GLuint textureName = 0;
+    glGenTextures(1, &textureName);
+    glBindTexture(GL_TEXTURE_2D, textureName);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, texNative.width, texNative.height,
+                 0, GL_RGBA, GL_UNSIGNED_BYTE, fullColor.data());
+
     GLenum texFilter = GL_LINEAR;
     switch (texNative.filterflags & 0xFF) {
         default:
@@ -174,26 +222,41 @@ TextureData::Handle createTexture(RW::BSTextureNative& texNative,
 
 bool TextureLoader::loadFromMemory(const FileContentsInfo& file,
                                    TextureArchive& inTextures) {
-    auto data = file.data.get();
-    RW::BinaryStreamSection root(data);
-    /*auto texDict =*/root.readStructure<RW::BSTextureDictionary>();
+    RWBStream rootStream(file.data, file.length);
+    if (rootStream.getNextChunk() != RW::SID_TextureDictionary) {
+        RW_ERROR("Invalid texture dictionary");
+        return false;
+    }
 
-    size_t rootI = 0;
-    while (root.hasMoreData(rootI)) {
-        auto rootSection = root.getNextChildSection(rootI);
+    auto dictStream = rootStream.getInnerStream();
+    for (auto chunkID = dictStream.getNextChunk(); chunkID != 0;
+         chunkID = dictStream.getNextChunk()) {
+        if (chunkID != RW::SID_TextureNative) continue;
+
+        auto nativeStream = dictStream.getInnerStream();
+        if (nativeStream.getNextChunk() != RW::SID_Struct ||
+            nativeStream.getCurrentChunkSize() < nativeHeaderSize) {
+            RW_ERROR("Texture missing struct chunk");
+            continue;
+        }
 
-        if (rootSection.header.id != RW::SID_TextureNative) continue;
+        RW::BSTextureNative texNative{};
+        std::memcpy(&texNative, nativeStream.getCursor(), nativeHeaderSize);
 
-        RW::BSTextureNative texNative =
-            rootSection.readStructure<RW::BSTextureNative>();
-        std::string name = std::string(texNative.diffuseName);
-        std::string alpha = std::string(texNative.alphaName);
-        std::transform(name.begin(), name.end(), name.begin(), ::tolower);
-        std::transform(alpha.begin(), alpha.end(), alpha.begin(), ::tolower);
+        // The names are only null terminated if they're shorter than 32
+        auto readName = [](const char (&str)[32]) {
+            std::string name(str, std::find(str, str + 32, '\0'));
+            std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+            return name;
+        };
+        std::string name = readName(texNative.diffuseName);
 
-        auto texture = createTexture(texNative, rootSection);
+        auto raster = reinterpret_cast<const uint8_t*>(
+            nativeStream.getCursor() + nativeHeaderSize);
+        size_t rasterSize =
+            nativeStream.getCurrentChunkSize() - nativeHeaderSize;
 
-        inTextures[name] = texture;
+        inTextures[name] = createTexture(texNative, raster, rasterSize);
     }
 
     return true;
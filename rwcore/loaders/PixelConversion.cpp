@@ -0,0 +1,408 @@
+#include "loaders/PixelConversion.hpp"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || \
+    defined(_M_IX86)
+#define RW_PIXEL_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(RW_PIXEL_X86) && (defined(__GNUC__) || defined(__clang__))
+#define RW_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define RW_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define RW_TARGET_SSE41
+#define RW_TARGET_AVX2
+#endif
+
+namespace PixelConversion {
+
+namespace {
+
+inline uint32_t expand5(uint32_t c) {
+    return (c << 3) | (c >> 2);
+}
+
+inline uint32_t expand6(uint32_t c) {
+    return (c << 2) | (c >> 4);
+}
+
+void expandPaletteScalar(const uint32_t* palette, const uint8_t* indices,
+                         uint32_t* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = palette[indices[i]];
+    }
+}
+
+void convert1555Scalar(const uint16_t* in, uint32_t* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t v = in[i];
+        uint32_t r = expand5(v & 0x1F);
+        uint32_t g = expand5((v >> 5) & 0x1F);
+        uint32_t b = expand5((v >> 10) & 0x1F);
+        uint32_t a = (v & 0x8000) ? 0xFF : 0x00;
+        out[i] = r | (g << 8) | (b << 16) | (a << 24);
+    }
+}
+
+void convert565Scalar(const uint16_t* in, uint32_t* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t v = in[i];
+        uint32_t r = expand5(v >> 11);
+        uint32_t g = expand6((v >> 5) & 0x3F);
+        uint32_t b = expand5(v & 0x1F);
+        out[i] = r | (g << 8) | (b << 16) | 0xFF000000u;
+    }
+}
+
+void swizzleBGRAScalar(const uint32_t* in, uint32_t* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t v = in[i];
+        out[i] = (v & 0xFF00FF00u) | ((v >> 16) & 0xFF) | ((v & 0xFF) << 16);
+    }
+}
+
+#ifdef RW_PIXEL_X86
+
+// The 16-bit formats are expanded in 16-bit lanes: each lane ends up holding
+// either R|G<<8 or B|A<<8, which are then interleaved into 32-bit pixels.
+
+RW_TARGET_SSE41 inline __m128i expand5SSE(__m128i c) {
+    return _mm_or_si128(_mm_slli_epi16(c, 3), _mm_srli_epi16(c, 2));
+}
+
+RW_TARGET_SSE41 inline __m128i expand6SSE(__m128i c) {
+    return _mm_or_si128(_mm_slli_epi16(c, 2), _mm_srli_epi16(c, 4));
+}
+
+RW_TARGET_SSE41
+void expandPaletteSSE41(const uint32_t* palette, const uint8_t* indices,
+                        uint32_t* out, size_t count) {
+    // There is no gather before AVX2, so this is an unrolled lookup that
+    // at least writes whole vectors.
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i v = _mm_setr_epi32(
+            static_cast<int>(palette[indices[i + 0]]),
+            static_cast<int>(palette[indices[i + 1]]),
+            static_cast<int>(palette[indices[i + 2]]),
+            static_cast<int>(palette[indices[i + 3]]));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), v);
+    }
+    expandPaletteScalar(palette, indices + i, out + i, count - i);
+}
+
+RW_TARGET_SSE41
+void convert1555SSE41(const uint16_t* in, uint32_t* out, size_t count) {
+    const __m128i mask5 = _mm_set1_epi16(0x1F);
+    const __m128i maskHi = _mm_set1_epi16(static_cast<short>(0xFF00));
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        __m128i r = expand5SSE(_mm_and_si128(v, mask5));
+        __m128i g = expand5SSE(_mm_and_si128(_mm_srli_epi16(v, 5), mask5));
+        __m128i b = expand5SSE(_mm_and_si128(_mm_srli_epi16(v, 10), mask5));
+        __m128i a = _mm_and_si128(_mm_srai_epi16(v, 15), maskHi);
+        __m128i rg = _mm_or_si128(r, _mm_slli_epi16(g, 8));
+        __m128i ba = _mm_or_si128(b, a);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i),
+                         _mm_unpacklo_epi16(rg, ba));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 4),
+                         _mm_unpackhi_epi16(rg, ba));
+    }
+    convert1555Scalar(in + i, out + i, count - i);
+}
+
+RW_TARGET_SSE41
+void convert565SSE41(const uint16_t* in, uint32_t* out, size_t count) {
+    const __m128i mask5 = _mm_set1_epi16(0x1F);
+    const __m128i mask6 = _mm_set1_epi16(0x3F);
+    const __m128i alpha = _mm_set1_epi16(static_cast<short>(0xFF00));
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        __m128i r = expand5SSE(_mm_srli_epi16(v, 11));
+        __m128i g = expand6SSE(_mm_and_si128(_mm_srli_epi16(v, 5), mask6));
+        __m128i b = expand5SSE(_mm_and_si128(v, mask5));
+        __m128i rg = _mm_or_si128(r, _mm_slli_epi16(g, 8));
+        __m128i ba = _mm_or_si128(b, alpha);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i),
+                         _mm_unpacklo_epi16(rg, ba));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 4),
+                         _mm_unpackhi_epi16(rg, ba));
+    }
+    convert565Scalar(in + i, out + i, count - i);
+}
+
+RW_TARGET_SSE41
+void swizzleBGRASSE41(const uint32_t* in, uint32_t* out, size_t count) {
+    const __m128i shuffle =
+        _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i),
+                         _mm_shuffle_epi8(v, shuffle));
+    }
+    swizzleBGRAScalar(in + i, out + i, count - i);
+}
+
+RW_TARGET_AVX2 inline __m256i expand5AVX2(__m256i c) {
+    return _mm256_or_si256(_mm256_slli_epi16(c, 3), _mm256_srli_epi16(c, 2));
+}
+
+RW_TARGET_AVX2 inline __m256i expand6AVX2(__m256i c) {
+    return _mm256_or_si256(_mm256_slli_epi16(c, 2), _mm256_srli_epi16(c, 4));
+}
+
+/// Interleaves the RG and BA halves and stores 16 pixels in order.
+/// unpack works within 128-bit lanes, so the halves need to be permuted.
+RW_TARGET_AVX2 inline void storeInterleavedAVX2(uint32_t* out, __m256i rg,
+                                                __m256i ba) {
+    __m256i lo = _mm256_unpacklo_epi16(rg, ba);
+    __m256i hi = _mm256_unpackhi_epi16(rg, ba);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out),
+                        _mm256_permute2x128_si256(lo, hi, 0x20));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 8),
+                        _mm256_permute2x128_si256(lo, hi, 0x31));
+}
+
+RW_TARGET_AVX2
+void expandPaletteAVX2(const uint32_t* palette, const uint8_t* indices,
+                       uint32_t* out, size_t count) {
+    const int* base = reinterpret_cast<const int*>(palette);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128i idx8 =
+            _mm_loadl_epi64(reinterpret_cast<const __m128i*>(indices + i));
+        __m256i idx = _mm256_cvtepu8_epi32(idx8);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+                            _mm256_i32gather_epi32(base, idx, 4));
+    }
+    expandPaletteScalar(palette, indices + i, out + i, count - i);
+}
+
+RW_TARGET_AVX2
+void convert1555AVX2(const uint16_t* in, uint32_t* out, size_t count) {
+    const __m256i mask5 = _mm256_set1_epi16(0x1F);
+    const __m256i maskHi = _mm256_set1_epi16(static_cast<short>(0xFF00));
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m256i v =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+        __m256i r = expand5AVX2(_mm256_and_si256(v, mask5));
+        __m256i g =
+            expand5AVX2(_mm256_and_si256(_mm256_srli_epi16(v, 5), mask5));
+        __m256i b =
+            expand5AVX2(_mm256_and_si256(_mm256_srli_epi16(v, 10), mask5));
+        __m256i a = _mm256_and_si256(_mm256_srai_epi16(v, 15), maskHi);
+        storeInterleavedAVX2(out + i,
+                             _mm256_or_si256(r, _mm256_slli_epi16(g, 8)),
+                             _mm256_or_si256(b, a));
+    }
+    convert1555SSE41(in + i, out + i, count - i);
+}
+
+RW_TARGET_AVX2
+void convert565AVX2(const uint16_t* in, uint32_t* out, size_t count) {
+    const __m256i mask5 = _mm256_set1_epi16(0x1F);
+    const __m256i mask6 = _mm256_set1_epi16(0x3F);
+    const __m256i alpha = _mm256_set1_epi16(static_cast<short>(0xFF00));
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m256i v =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+        __m256i r = expand5AVX2(_mm256_srli_epi16(v, 11));
+        __m256i g =
+            expand6AVX2(_mm256_and_si256(_mm256_srli_epi16(v, 5), mask6));
+        __m256i b = expand5AVX2(_mm256_and_si256(v, mask5));
+        storeInterleavedAVX2(out + i,
+                             _mm256_or_si256(r, _mm256_slli_epi16(g, 8)),
+                             _mm256_or_si256(b, alpha));
+    }
+    convert565SSE41(in + i, out + i, count - i);
+}
+
+RW_TARGET_AVX2
+void swizzleBGRAAVX2(const uint32_t* in, uint32_t* out, size_t count) {
+    const __m256i shuffle = _mm256_setr_epi8(
+        2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,
+        2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i v =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+                            _mm256_shuffle_epi8(v, shuffle));
+    }
+    swizzleBGRASSE41(in + i, out + i, count - i);
+}
+
+#ifdef _MSC_VER
+bool detectSSE41() {
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 19)) != 0;
+}
+
+bool detectAVX2() {
+    int info[4];
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx) {
+        return false;
+    }
+    // The OS has to save the YMM registers on context switches
+    if ((_xgetbv(0) & 0x6) != 0x6) {
+        return false;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+}
+#else
+bool detectSSE41() {
+    return __builtin_cpu_supports("sse4.1");
+}
+
+bool detectAVX2() {
+    return __builtin_cpu_supports("avx2");
+}
+#endif
+
+#endif  // RW_PIXEL_X86
+
+}  // namespace
+
+bool isSupported(Kernel kernel) {
+    switch (kernel) {
+        case Kernel::Scalar:
+            return true;
+#ifdef RW_PIXEL_X86
+        case Kernel::SSE41: {
+            static const bool supported = detectSSE41();
+            return supported;
+        }
+        case Kernel::AVX2: {
+            static const bool supported = detectSSE41() && detectAVX2();
+            return supported;
+        }
+#endif
+        default:
+            return false;
+    }
+}
+
+Kernel bestKernel() {
+    static const Kernel best = [] {
+        if (isSupported(Kernel::AVX2)) {
+            return Kernel::AVX2;
+        }
+        if (isSupported(Kernel::SSE41)) {
+            return Kernel::SSE41;
+        }
+        return Kernel::Scalar;
+    }();
+    return best;
+}
+
+const char* kernelName(Kernel kernel) {
+    switch (kernel) {
+        case Kernel::Scalar:
+            return "Scalar";
+        case Kernel::SSE41:
+            return "SSE4.1";
+        case Kernel::AVX2:
+            return "AVX2";
+    }
+    return "Unknown";
+}
+
+void expandPalette(const uint32_t* palette, const uint8_t* indices,
+                   uint32_t* out, size_t count) {
+    expandPalette(palette, indices, out, count, bestKernel());
+}
+
+void expandPalette(const uint32_t* palette, const uint8_t* indices,
+                   uint32_t* out, size_t count, Kernel kernel) {
+    switch (kernel) {
+#ifdef RW_PIXEL_X86
+        case Kernel::AVX2:
+            expandPaletteAVX2(palette, indices, out, count);
+            return;
+        case Kernel::SSE41:
+            expandPaletteSSE41(palette, indices, out, count);
+            return;
+#endif
+        default:
+            expandPaletteScalar(palette, indices, out, count);
+            return;
+    }
+}
+
+void convert1555(const uint16_t* in, uint32_t* out, size_t count) {
+    convert1555(in, out, count, bestKernel());
+}
+
+void convert1555(const uint16_t* in, uint32_t* out, size_t count,
+                 Kernel kernel) {
+    switch (kernel) {
+#ifdef RW_PIXEL_X86
+        case Kernel::AVX2:
+            convert1555AVX2(in, out, count);
+            return;
+        case Kernel::SSE41:
+            convert1555SSE41(in, out, count);
+            return;
+#endif
+        default:
+            convert1555Scalar(in, out, count);
+            return;
+    }
+}
+
+void convert565(const uint16_t* in, uint32_t* out, size_t count) {
+    convert565(in, out, count, bestKernel());
+}
+
+void convert565(const uint16_t* in, uint32_t* out, size_t count,
+                Kernel kernel) {
+    switch (kernel) {
+#ifdef RW_PIXEL_X86
+        case Kernel::AVX2:
+            convert565AVX2(in, out, count);
+            return;
+        case Kernel::SSE41:
+            convert565SSE41(in, out, count);
+            return;
+#endif
+        default:
+            convert565Scalar(in, out, count);
+            return;
+    }
+}
+
+void swizzleBGRA(const uint32_t* in, uint32_t* out, size_t count) {
+    swizzleBGRA(in, out, count, bestKernel());
+}
+
+void swizzleBGRA(const uint32_t* in, uint32_t* out, size_t count,
+                 Kernel kernel) {
+    switch (kernel) {
+#ifdef RW_PIXEL_X86
+        case Kernel::AVX2:
+            swizzleBGRAAVX2(in, out, count);
+            return;
+        case Kernel::SSE41:
+            swizzleBGRASSE41(in, out, count);
+            return;
+#endif
+        default:
+            swizzleBGRAScalar(in, out, count);
+            return;
+    }
+}
+
+}  // namespace PixelConversion
@@ -0,0 +1,74 @@
+#ifndef _LIBRW_PIXELCONVERSION_HPP_
+#define _LIBRW_PIXELCONVERSION_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Conversion kernels for expanding native texture rasters to RGBA8888.
+ *
+ * Every kernel has a scalar implementation and, on x86, SSE4.1 and AVX2
+ * variants. The best supported variant is selected once at runtime; the
+ * explicit Kernel overloads exist so that tests can compare every path.
+ *
+ * Output pixels are 32-bit RGBA in memory order (R in the lowest byte).
+ */
+namespace PixelConversion {
+
+enum class Kernel {
+    Scalar,
+    SSE41,
+    AVX2,
+};
+
+/**
+ * @return true if the CPU (and this build) can run the given kernel
+ */
+bool isSupported(Kernel kernel);
+
+/**
+ * @return the fastest kernel supported by this CPU
+ */
+Kernel bestKernel();
+
+/**
+ * @return human readable name of the kernel, for logging
+ */
+const char* kernelName(Kernel kernel);
+
+/**
+ * Looks up each 8-bit index in a 256 entry palette. PAL4 rasters use this
+ * with their palette padded to 256 entries.
+ */
+void expandPalette(const uint32_t* palette, const uint8_t* indices,
+                   uint32_t* out, size_t count);
+void expandPalette(const uint32_t* palette, const uint8_t* indices,
+                   uint32_t* out, size_t count, Kernel kernel);
+
+/**
+ * Converts 1555 pixels with the first component in the lowest bits, as
+ * GL_RGBA / GL_UNSIGNED_SHORT_1_5_5_5_REV interprets them.
+ */
+void convert1555(const uint16_t* in, uint32_t* out, size_t count);
+void convert1555(const uint16_t* in, uint32_t* out, size_t count,
+                 Kernel kernel);
+
+/**
+ * Converts 565 pixels with red in the highest bits, as
+ * GL_RGB / GL_UNSIGNED_SHORT_5_6_5 interprets them. Alpha is opaque.
+ */
+void convert565(const uint16_t* in, uint32_t* out, size_t count);
+void convert565(const uint16_t* in, uint32_t* out, size_t count,
+                Kernel kernel);
+
+/**
+ * Swaps the red and blue bytes of each pixel (BGRA <-> RGBA).
+ * in and out may be the same buffer.
+ */
+void swizzleBGRA(const uint32_t* in, uint32_t* out, size_t count);
+void swizzleBGRA(const uint32_t* in, uint32_t* out, size_t count,
+                 Kernel kernel);
+
+}  // namespace PixelConversion
+
+#endif
@@ -24,22 +24,28 @@ class RWBStream {
     std::ptrdiff_t _size;
     char* _dataCur;
     char* _nextChunk;
-    std::uint32_t _chunkVersion;
-    size_t _currChunkSz;
+    std::uint32_t _chunkVersion = 0;
+    size_t _currChunkSz = 0;
 
 public:
     typedef std::uint32_t ChunkID;
 
+    /// Size of the id, size and version header before each chunk
+    static constexpr std::ptrdiff_t kChunkHeaderSize = 3 * sizeof(std::uint32_t);
+
     RWBStream(char* data, size_t size)
         : _data(data), _size(size), _dataCur(data), _nextChunk(data) {
     }
 
     /**
      * Moves the stream to the next chunk and returns it's ID
+     *
+     * Returns 0 once the end of the stream is reached, or if the next chunk
+     * would run past the end of the stream.
      */
     ChunkID getNextChunk() {
-        // Check that there's any data left
-        if ((_dataCur - _data) >= _size) return 0;
+        // Check that there's a complete chunk header left
+        if (_size - (_nextChunk - _data) < kChunkHeaderSize) return 0;
 
         // _nextChunk is initally = to _data, making this a non-op
         _dataCur = _nextChunk;
@@ -47,12 +53,20 @@ public:
         ChunkID id = bit_cast<std::uint32_t>(*_dataCur);
         _dataCur += sizeof(ChunkID);
 
-        _currChunkSz = bit_cast<std::uint32_t>(*_dataCur);
+        std::uint32_t chunkSize = bit_cast<std::uint32_t>(*_dataCur);
         _dataCur += sizeof(std::uint32_t);
 
         _chunkVersion = bit_cast<std::uint32_t>(*_dataCur);
         _dataCur += sizeof(std::uint32_t);
 
+        if (chunkSize > static_cast<size_t>(_size - (_dataCur - _data))) {
+            RW_ERROR("Chunk " << id << " overruns the end of the stream");
+            _dataCur = _nextChunk = _data + _size;
+            _currChunkSz = 0;
+            return 0;
+        }
+
+        _currChunkSz = chunkSize;
         _nextChunk = _dataCur + _currChunkSz;
 
         return id;
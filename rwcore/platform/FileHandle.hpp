@@ -3,27 +3,59 @@
 
 #include <cstddef>
 #include <memory>
+#include <utility>
 
 /**
- * @brief Contains a pointer to a file's contents.
+ * @brief A view of a file's contents.
+ *
+ * The bytes are either owned by the view, or borrowed from a shared backing
+ * store such as a memory mapped archive. The backing store is kept alive for
+ * as long as any view into it exists, so loaders can parse straight out of
+ * the mapped pages without copying the file first.
+ *
+ * Views of the same archive share its mapping, so loaders should treat the
+ * data as read-only. The mapping is copy-on-write, so stray writes never
+ * reach the file on disk.
  */
 struct FileContentsInfo {
-    std::unique_ptr<char[]> data;
-    size_t length;
+    char* data = nullptr;
+    size_t length = 0;
+
+    FileContentsInfo() = default;
 
     FileContentsInfo(std::unique_ptr<char[]> mem, size_t len)
-        : data(std::move(mem)), length(len) {
+        : data(mem.get()), length(len), backing_(std::move(mem)) {
+    }
+
+    /**
+     * @param backing keeps the memory in [mem, mem + len) alive
+     */
+    FileContentsInfo(std::shared_ptr<void> backing, char* mem, size_t len)
+        : data(mem), length(len), backing_(std::move(backing)) {
     }
 
-    FileContentsInfo(FileContentsInfo&& info)
-        : data(std::move(info.data)), length(info.length) {
+    FileContentsInfo(FileContentsInfo&& info) noexcept
+        : data(info.data)
+        , length(info.length)
+        , backing_(std::move(info.backing_)) {
         info.data = nullptr;
+        info.length = 0;
+    }
+
+    FileContentsInfo& operator=(FileContentsInfo&& info) noexcept {
+        data = std::exchange(info.data, nullptr);
+        length = std::exchange(info.length, 0);
+        backing_ = std::move(info.backing_);
+        return *this;
     }
 
     FileContentsInfo(FileContentsInfo& info) = delete;
     FileContentsInfo& operator=(FileContentsInfo& info) = delete;
 
     ~FileContentsInfo() = default;
+
+private:
+    std::shared_ptr<void> backing_;
 };
 
 #endif
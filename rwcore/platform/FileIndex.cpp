@@ -6,11 +6,52 @@
 #include <iterator>
 #include <sstream>
 
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
 #include "platform/FileHandle.hpp"
 #include "loaders/LoaderIMG.hpp"
 
 #include "rw/debug.hpp"
 
+namespace bip = boost::interprocess;
+
+struct FileIndex::MappedFile {
+    bip::mapped_region region;
+};
+
+namespace {
+constexpr size_t kArchiveSectorSize = 2048;
+
+/// Maps the whole file copy-on-write, returns nullptr if it can't be mapped
+std::shared_ptr<bip::mapped_region> mapFile(const std::string &path) {
+    try {
+        bip::file_mapping file(path.c_str(), bip::read_only);
+        return std::make_shared<bip::mapped_region>(file, bip::copy_on_write);
+    } catch (const bip::interprocess_exception &) {
+        // Empty files can't be mapped either
+        return nullptr;
+    }
+}
+
+FileContentsInfo readFile(const std::string &path, size_t offset,
+                          size_t length) {
+    std::ifstream dfile(path, std::ios::binary);
+    if (!dfile.is_open()) {
+        throw std::runtime_error("Unable to open file: " + path);
+    }
+
+    dfile.seekg(offset);
+    auto data = std::make_unique<char[]>(length);
+    dfile.read(data.get(), length);
+    if (static_cast<size_t>(dfile.gcount()) != length) {
+        RW_ERROR("Error reading " << path);
+    }
+
+    return {std::move(data), length};
+}
+}  // namespace
+
 std::string FileIndex::normalizeFilePath(const std::string &filePath) {
     std::ostringstream oss;
     std::transform(filePath.cbegin(), filePath.cend(), std::ostreambuf_iterator<char>(oss), [](char c) {
@@ -87,7 +128,8 @@ void FileIndex::indexArchive(const std::string &archive) {
 
         std::string assetName = normalizeFilePath(asset.name);
 
-        indexedData_[assetName] = {IndexedDataType::ARCHIVE, path.string(), asset.name};
+        indexedData_[assetName] = {IndexedDataType::ARCHIVE, path.string(),
+                                   asset.name, asset.offset, asset.size};
     }
 }
 
@@ -96,39 +138,49 @@ FileContentsInfo FileIndex::openFile(const std::string &filePath) {
     auto indexedDataPos = indexedData_.find(cleanFilePath);
 
     if (indexedDataPos == indexedData_.end()) {
-        return {nullptr, 0};
+        return {};
     }
 
     const auto &indexedData = indexedDataPos->second;
 
-    std::unique_ptr<char[]> data = nullptr;
-    size_t length = 0;
-
     if (indexedData.type == IndexedDataType::ARCHIVE) {
-        LoaderIMG img;
-
-        if (!img.load(indexedData.path)) {
-            throw std::runtime_error("Failed to load IMG archive: " + indexedData.path);
+        auto imgPath = rwfs::path(indexedData.path).replace_extension(".img");
+        auto archiveIt = archives_.find(indexedData.path);
+        if (archiveIt == archives_.end()) {
+            std::shared_ptr<MappedFile> archive;
+            if (auto region = mapFile(imgPath.string())) {
+                archive = std::make_shared<MappedFile>();
+                archive->region.swap(*region);
+            } else {
+                RW_ERROR("Failed to map IMG archive: " << imgPath.string());
+            }
+            archiveIt = archives_.emplace(indexedData.path, archive).first;
         }
 
-        LoaderIMGFile file;
-        auto filename = rwfs::path(indexedData.assetData).filename().string();
-        if (img.findAssetInfo(filename, file)) {
-            length = file.size * 2048;
-            data = img.loadToMemory(filename);
+        size_t offset = indexedData.offset * kArchiveSectorSize;
+        size_t length = indexedData.size * kArchiveSectorSize;
+
+        const auto &archive = archiveIt->second;
+        if (!archive) {
+            return readFile(imgPath.string(), offset, length);
         }
-    } else {
-        std::ifstream dfile(indexedData.path, std::ios::binary);
-        if (!dfile.is_open()) {
-            throw std::runtime_error("Unable to open file: " + indexedData.path);
+
+        if (offset > archive->region.get_size() ||
+            length > archive->region.get_size() - offset) {
+            RW_ERROR("Asset " << indexedData.assetData
+                              << " is outside of its archive");
+            return {};
         }
 
-        dfile.seekg(0, std::ios::end);
-        length = dfile.tellg();
-        dfile.seekg(0);
-        data = std::make_unique<char[]>(length);
-        dfile.read(data.get(), length);
+        auto base = static_cast<char *>(archive->region.get_address());
+        return {archive, base + offset, length};
     }
 
-    return {std::move(data), length};
+    auto region = mapFile(indexedData.path);
+    if (!region) {
+        return readFile(indexedData.path, 0, rwfs::file_size(indexedData.path));
+    }
+    auto base = static_cast<char *>(region->get_address());
+    auto length = region->get_size();
+    return {std::move(region), base, length};
 }
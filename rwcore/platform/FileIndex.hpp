@@ -4,6 +4,8 @@
 #include "rw/filesystem.hpp"
 #include "rw/forward.hpp"
 
+#include <cstdint>
+#include <memory>
 #include <unordered_map>
 
 class FileIndex {
@@ -51,6 +53,9 @@ public:
     /**
      * Returns a FileHandle for the file if it can be found in the
      * file index, otherwise an empty FileHandle is returned.
+     *
+     * Archives are memory mapped the first time one of their members is
+     * opened, and the returned FileHandle points directly into the mapping.
      * @param filePath name of the file to open
      * @return FileHandle to the file, nullptr if this FileINdexed has not indexed the path
      */
@@ -77,8 +82,23 @@ private:
         std::string path;
         /// Extra data of assets (FIXME: use c++17 std::variant or std::option)
         std::string assetData;
+        /// Offset of an archive member in the archive, in sectors
+        std::uint32_t offset = 0;
+        /// Size of an archive member, in sectors
+        std::uint32_t size = 0;
     };
 
+    /**
+     * @brief A read-only mapping of an entire file.
+     */
+    struct MappedFile;
+
+    /**
+     * @brief archives_ Mappings of the archives that files have been opened
+     * from, keyed by the archive's path.
+     */
+    std::unordered_map<std::string, std::shared_ptr<MappedFile>> archives_;
+
     /**
      * @brief indexedData_ A mapping from filepath (relative to game data path) to an IndexedData item.
      */
@@ -1,7 +1,9 @@
 #include "ai/AIGraph.hpp"
 
 #include <algorithm>
+#include <cmath>
 #include <cstddef>
+#include <limits>
 
 #include <glm/gtx/norm.hpp>
 
@@ -13,12 +15,29 @@
 
 namespace ai {
 
+namespace {
+constexpr int kGridWidth = static_cast<int>(WORLD_GRID_WIDTH);
+
+std::size_t gridIndex(int x, int y) {
+    return static_cast<std::size_t>(x * kGridWidth + y);
+}
+}  // namespace
+
+glm::ivec2 AIGraph::getGridCell(const glm::vec2& world) {
+    const float lowerCoord = -(WORLD_GRID_SIZE) / 2.f;
+    const auto toCell = [&](float v) {
+        const auto cell = static_cast<int>(
+            std::floor((v - lowerCoord) / static_cast<float>(WORLD_CELL_SIZE)));
+        return std::min(std::max(cell, 0), kGridWidth - 1);
+    };
+    return glm::ivec2(toCell(world.x), toCell(world.y));
+}
+
 void AIGraph::createPathNodes(const glm::vec3& position,
                               const glm::quat& rotation, PathData& path) {
     auto startIndex = static_cast<std::uint32_t>(nodes.size());
     std::vector<AIGraphNode*> pathNodes;
     pathNodes.reserve(path.nodes.size());
-    nodes.reserve(path.nodes.size());
 
     for (auto n = 0u; n < path.nodes.size(); ++n) {
         bool external = false;
@@ -26,13 +45,10 @@ void AIGraph::createPathNodes(const glm::vec3& position,
         glm::vec3 nodePosition = position + (rotation * node.position);
 
         if (node.type == PathNode::EXTERNAL) {
-            for (auto& realNode : externalNodes) {
-                auto d = glm::distance2(realNode->position, nodePosition);
-                if (d < 1.f) {
-                    pathNodes.push_back(realNode);
-                    external = true;
-                    break;
-                }
+            auto realNode = findExternalNode(nodePosition, 1.f);
+            if (realNode) {
+                pathNodes.push_back(realNode);
+                external = true;
             }
         }
         if (!external) {
@@ -50,27 +66,24 @@ void AIGraph::createPathNodes(const glm::vec3& position,
             ainode->position = nodePosition;
             ainode->external = node.type == PathNode::EXTERNAL;
             ainode->disabled = false;
+            ainode->index = static_cast<std::uint32_t>(nodes.size());
 
             pathNodes.push_back(ptr);
             nodes.push_back(std::move(ainode));
 
+            // Determine which grid cell this node falls into
+            const float halfSize = WORLD_GRID_SIZE / 2.f;
+            if (ptr->position.x < -halfSize || ptr->position.x >= halfSize ||
+                ptr->position.y < -halfSize || ptr->position.y >= halfSize) {
+                RW_MESSAGE("Warning: Node outside of grid at "
+                           << ptr->position.x << " " << ptr->position.y);
+            }
+            auto cell = getGridCell(glm::vec2(ptr->position));
+            auto index = gridIndex(cell.x, cell.y);
+            gridAllNodes[index].push_back(ptr);
+
             if (ptr->external) {
                 externalNodes.push_back(ptr);
-
-                // Determine which grid cell this node falls into
-                float lowerCoord = -(WORLD_GRID_SIZE) / 2.f;
-                auto gridrel = glm::vec2(ptr->position) -
-                               glm::vec2(lowerCoord, lowerCoord);
-                auto gridcoord =
-                    glm::floor(gridrel / glm::vec2(WORLD_CELL_SIZE));
-                if (gridcoord.x < 0 || gridcoord.y < 0 ||
-                    gridcoord.x >= WORLD_GRID_WIDTH ||
-                    gridcoord.y >= WORLD_GRID_WIDTH) {
-                    RW_MESSAGE("Warning: Node outside of grid at coord "
-                               << gridcoord.x << " " << gridcoord.y);
-                }
-                auto index = static_cast<std::size_t>(
-                    (gridcoord.x * WORLD_GRID_WIDTH) + gridcoord.y);
                 gridNodes[index].push_back(ptr);
             }
         }
@@ -122,4 +135,85 @@ void AIGraph::gatherExternalNodesNear(const glm::vec3& center,
     }
 }
 
+void AIGraph::gatherExternalNodesInCells(
+    const glm::ivec2& minCell, const glm::ivec2& maxCell,
+    std::vector<AIGraphNode*>& nodes) const {
+    for (int x = std::max(minCell.x, 0);
+         x <= std::min(maxCell.x, kGridWidth - 1); ++x) {
+        for (int y = std::max(minCell.y, 0);
+             y <= std::min(maxCell.y, kGridWidth - 1); ++y) {
+            const auto& external = gridNodes[gridIndex(x, y)];
+            nodes.insert(nodes.end(), external.begin(), external.end());
+        }
+    }
+}
+
+AIGraphNode* AIGraph::findNearestNode(const glm::vec3& position,
+                                      NodeType type,
+                                      const NodeFilter& filter) const {
+    const auto center = getGridCell(glm::vec2(position));
+    AIGraphNode* nearest = nullptr;
+    float nearestDistance2 = std::numeric_limits<float>::max();
+
+    const auto searchCell = [&](int x, int y) {
+        if (x < 0 || y < 0 || x >= kGridWidth || y >= kGridWidth) {
+            return;
+        }
+        for (AIGraphNode* node : gridAllNodes[gridIndex(x, y)]) {
+            if (node->type != type) {
+                continue;
+            }
+            const float d = glm::distance2(position, node->position);
+            if (d < nearestDistance2 && (!filter || filter(*node))) {
+                nearest = node;
+                nearestDistance2 = d;
+            }
+        }
+    };
+
+    // Search rings of cells around the center until the next ring can't
+    // hold anything closer
+    for (int ring = 0; ring < kGridWidth; ++ring) {
+        for (int y = center.y - ring; y <= center.y + ring; ++y) {
+            searchCell(center.x - ring, y);
+            if (ring > 0) {
+                searchCell(center.x + ring, y);
+            }
+        }
+        for (int x = center.x - ring + 1; x < center.x + ring; ++x) {
+            searchCell(x, center.y - ring);
+            searchCell(x, center.y + ring);
+        }
+
+        const float nextRing = static_cast<float>(ring * WORLD_CELL_SIZE);
+        if (nearest && nearestDistance2 <= nextRing * nextRing) {
+            break;
+        }
+    }
+
+    return nearest;
+}
+
+AIGraphNode* AIGraph::findExternalNode(const glm::vec3& position,
+                                       float radius) const {
+    const auto planecoords = glm::vec2(position);
+    const auto minGrid = getGridCell(planecoords - glm::vec2(radius));
+    const auto maxGrid = getGridCell(planecoords + glm::vec2(radius));
+
+    AIGraphNode* nearest = nullptr;
+    float nearestDistance2 = radius * radius;
+    for (int x = minGrid.x; x <= maxGrid.x; ++x) {
+        for (int y = minGrid.y; y <= maxGrid.y; ++y) {
+            for (AIGraphNode* node : gridNodes[gridIndex(x, y)]) {
+                const float d = glm::distance2(position, node->position);
+                if (d < nearestDistance2) {
+                    nearest = node;
+                    nearestDistance2 = d;
+                }
+            }
+        }
+    }
+    return nearest;
+}
+
 }  // namespace ai
@@ -2,10 +2,13 @@
 #define _RWENGINE_AIGRAPH_HPP_
 
 #include <glm/gtc/quaternion.hpp>
+#include <glm/vec2.hpp>
 
 #include <rw/types.hpp>
 
 #include <array>
+#include <functional>
+#include <memory>
 #include <vector>
 
 struct PathData;
@@ -33,11 +36,48 @@ public:
      */
     std::array<std::vector<AIGraphNode*>, WORLD_GRID_CELLS> gridNodes;
 
+    /**
+     * Stores all AI Grid Nodes organised by world grid cell. Nodes outside
+     * of the grid are stored in the nearest cell.
+     */
+    std::array<std::vector<AIGraphNode*>, WORLD_GRID_CELLS> gridAllNodes;
+
+    using NodeFilter = std::function<bool(const AIGraphNode&)>;
+
     void createPathNodes(const glm::vec3& position, const glm::quat& rotation,
                          PathData& path);
 
     void gatherExternalNodesNear(const glm::vec3& center, const float radius,
                                  std::vector<AIGraphNode*>& nodes, NodeType type);
+
+    /**
+     * Finds the node of the given type closest to position, searching the
+     * grid outwards from position's cell.
+     * @param filter if set, only nodes it accepts are considered
+     * @return the closest node, or nullptr if there is none
+     */
+    AIGraphNode* findNearestNode(const glm::vec3& position, NodeType type,
+                                 const NodeFilter& filter = {}) const;
+
+    /**
+     * Appends the external nodes stored in the grid cells from minCell to
+     * maxCell, inclusive
+     */
+    void gatherExternalNodesInCells(const glm::ivec2& minCell,
+                                    const glm::ivec2& maxCell,
+                                    std::vector<AIGraphNode*>& nodes) const;
+
+    /**
+     * @return the grid cell containing world, clamped to the grid
+     */
+    static glm::ivec2 getGridCell(const glm::vec2& world);
+
+    /**
+     * @return the external node closest to position within radius, or
+     * nullptr if there is none
+     */
+    AIGraphNode* findExternalNode(const glm::vec3& position,
+                                  float radius) const;
 };
 
 } // ai
@@ -27,6 +27,11 @@ struct AIGraphNode {
 
     int32_t nextIndex;
 
+    /**
+     * Position of this node in AIGraph::nodes
+     */
+    uint32_t index = 0;
+
     bool disabled;
 
     std::vector<AIGraphNode*> connections;
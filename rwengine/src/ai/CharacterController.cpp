@@ -433,7 +433,7 @@ bool Activities::EnterVehicle::update(CharacterObject *character,
                 vehicle->setPartTarget(entryDoor, true, entryDoor->openAngle);
             } else {
                 // character->setPosition(vehicle->getSeatEntryPosition(seat));
-                character->rotation = vehicle->getRotation();
+                character->GameObject::setRotation(vehicle->getRotation());
             }
         } else if (character->getCurrentCycle() == cycle_pullout) {
             if (character->animator->isCompleted(AnimIndexAction)) {
@@ -526,7 +526,7 @@ bool Activities::ExitVehicle::update(CharacterObject *character,
             auto exitPos = vehicle->getSeatEntryPositionWorld(seat);
             auto exitPosLocal = vehicle->getSeatEntryPosition(seat);
 
-            character->rotation = vehicle->getRotation();
+            character->GameObject::setRotation(vehicle->getRotation());
 
             // Exit the vehicle immediatley
             character->enterVehicle(nullptr, seat);
@@ -0,0 +1,107 @@
+#include "ai/RoutePlanner.hpp"
+
+#include <algorithm>
+
+#include <glm/glm.hpp>
+
+#include "ai/AIGraph.hpp"
+#include "ai/AIGraphNode.hpp"
+
+namespace ai {
+
+RoutePlanner::RoutePlanner(const AIGraph& graph) : graph_(graph) {
+}
+
+RoutePlanner::Record& RoutePlanner::record(uint32_t node) {
+    auto& r = records_[node];
+    if (r.query != query_) {
+        r = Record{};
+        r.query = query_;
+    }
+    return r;
+}
+
+bool RoutePlanner::findRoute(AIGraphNode* start, AIGraphNode* goal,
+                             std::vector<AIGraphNode*>& route) {
+    route.clear();
+    expanded_ = 0;
+    if (!start || !goal || start->type != goal->type || goal->disabled) {
+        return false;
+    }
+
+    const auto& nodes = graph_.nodes;
+    if (records_.size() < nodes.size()) {
+        records_.resize(nodes.size());
+    }
+    if (++query_ == 0) {
+        // Wrapped around, old records could pass as current
+        std::fill(records_.begin(), records_.end(), Record{});
+        query_ = 1;
+    }
+    open_.clear();
+
+    const auto type = start->type;
+    auto& startRecord = record(start->index);
+    startRecord.parent = start->index;
+    startRecord.reached = true;
+    open_.push_back({glm::distance(start->position, goal->position),
+                     start->index});
+
+    while (!open_.empty()) {
+        std::pop_heap(open_.begin(), open_.end());
+        const auto current = open_.back().node;
+        open_.pop_back();
+
+        auto& currentRecord = record(current);
+        // Nodes are pushed again when a cheaper way is found, skip the rest
+        if (currentRecord.closed) {
+            continue;
+        }
+        currentRecord.closed = true;
+        expanded_++;
+
+        const auto* node = nodes[current].get();
+        if (node == goal) {
+            for (auto n = current;; n = records_[n].parent) {
+                route.push_back(nodes[n].get());
+                if (n == start->index) {
+                    break;
+                }
+            }
+            std::reverse(route.begin(), route.end());
+            return true;
+        }
+
+        const auto cost = currentRecord.cost;
+        for (const auto* next : node->connections) {
+            if (next->type != type || next->disabled) {
+                continue;
+            }
+            auto& nextRecord = record(next->index);
+            const auto nextCost =
+                cost + glm::distance(node->position, next->position);
+            if (nextRecord.closed ||
+                (nextRecord.reached && nextRecord.cost <= nextCost)) {
+                continue;
+            }
+            nextRecord.reached = true;
+            nextRecord.cost = nextCost;
+            nextRecord.parent = current;
+            open_.push_back(
+                {nextCost + glm::distance(next->position, goal->position),
+                 next->index});
+            std::push_heap(open_.begin(), open_.end());
+        }
+    }
+
+    return false;
+}
+
+bool RoutePlanner::findRoute(const glm::vec3& from, const glm::vec3& to,
+                             NodeType type, std::vector<AIGraphNode*>& route) {
+    const auto usable = [](const AIGraphNode& node) { return !node.disabled; };
+    return findRoute(graph_.findNearestNode(from, type, usable),
+                     graph_.findNearestNode(to, type, usable), route);
+}
+
+}  // namespace ai
@@ -0,0 +1,86 @@
+#ifndef _RWENGINE_ROUTEPLANNER_HPP_
+#define _RWENGINE_ROUTEPLANNER_HPP_
+
+#include <glm/vec3.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ai {
+
+enum class NodeType;
+class AIGraph;
+struct AIGraphNode;
+
+/**
+ * @brief A* search for routes over the AI graph
+ *
+ * The planner keeps its memory between queries: node records are marked
+ * with the query that wrote them instead of being cleared, and the open set
+ * keeps its capacity. A query only costs the nodes it explores, not the
+ * size of the graph.
+ *
+ * Routes only use nodes of the start node's type, and never pass through
+ * disabled nodes. A planner must only be used by one thread at a time.
+ */
+class RoutePlanner {
+public:
+    explicit RoutePlanner(const AIGraph& graph);
+
+    /**
+     * Finds the shortest route from start to goal
+     * @param route Receives the nodes from start to goal, both included
+     * @return false if there is no route
+     */
+    bool findRoute(AIGraphNode* start, AIGraphNode* goal,
+                   std::vector<AIGraphNode*>& route);
+
+    /**
+     * Finds the shortest route between the nodes of the given type closest
+     * to from and to
+     */
+    bool findRoute(const glm::vec3& from, const glm::vec3& to, NodeType type,
+                   std::vector<AIGraphNode*>& route);
+
+    /**
+     * @return the number of nodes the last query expanded
+     */
+    size_t getExpandedCount() const {
+        return expanded_;
+    }
+
+private:
+    struct Record {
+        /// The query this record belongs to, older records are unvisited
+        uint32_t query = 0;
+        uint32_t parent = 0;
+        /// Cost of the cheapest way found so far
+        float cost = 0.f;
+        bool reached = false;
+        bool closed = false;
+    };
+
+    struct OpenNode {
+        /// Cost so far plus the distance left
+        float estimate;
+        uint32_t node;
+
+        bool operator<(const OpenNode& other) const {
+            // std::push_heap builds a max heap
+            return estimate > other.estimate;
+        }
+    };
+
+    Record& record(uint32_t node);
+
+    const AIGraph& graph_;
+    std::vector<Record> records_;
+    std::vector<OpenNode> open_;
+    uint32_t query_ = 0;
+    size_t expanded_ = 0;
+};
+
+}  // namespace ai
+
+#endif
@@ -31,52 +31,178 @@ TrafficDirector::TrafficDirector(AIGraph* g, GameWorld* w)
     , world(w) {
 }
 
+namespace {
+/// Vehicle generators are indexed in cells this wide
+constexpr float kGeneratorCellSize = 50.f;
+/// Generators below this height are moved to the ground
+constexpr float kGeneratorGroundHeight = -90.f;
+
+glm::ivec2 occupancyCell(const glm::vec3& position, float cellSize) {
+    return glm::ivec2(static_cast<int>(std::floor(position.x / cellSize)),
+                      static_cast<int>(std::floor(position.y / cellSize)));
+}
+
+int64_t occupancyKey(int x, int y) {
+    return static_cast<int64_t>(static_cast<uint64_t>(x) << 32 |
+                                static_cast<uint32_t>(y));
+}
+
+bool compareOccupancyKey(const std::pair<int64_t, glm::vec3>& a,
+                         const std::pair<int64_t, glm::vec3>& b) {
+    return a.first < b.first;
+}
+}  // namespace
+
+void TrafficDirector::updateCandidates(const glm::vec3& center,
+                                       float radius) {
+    const auto planecoords = glm::vec2(center);
+    const auto minCell = AIGraph::getGridCell(planecoords - glm::vec2(radius));
+    const auto maxCell = AIGraph::getGridCell(planecoords + glm::vec2(radius));
+
+    // Nodes are only ever added to the graph
+    const auto graphSize = graph->externalNodes.size();
+    if (minCell == candidateMin && maxCell == candidateMax &&
+        graphSize == candidateGraphSize) {
+        return;
+    }
+
+    candidates.clear();
+    graph->gatherExternalNodesInCells(minCell, maxCell, candidates);
+    candidateMin = minCell;
+    candidateMax = maxCell;
+    candidateGraphSize = graphSize;
+}
+
+void TrafficDirector::updateOccupancy(const glm::vec3& center, float radius,
+                                      float blockDistance) {
+    occupancy.clear();
+    anyOccupant = !world->pedestrianPool.objects.empty() ||
+                  !world->vehiclePool.objects.empty();
+    if (!std::isfinite(blockDistance)) {
+        return;
+    }
+
+    // Only objects this close can block a node within radius
+    const float reach = radius + blockDistance;
+    const float cellSize = std::max(blockDistance, 1.f);
+    const auto center2D = glm::vec2(center);
+    // Only characters and vehicles are in the dynamic store
+    const auto& transforms = world->dynamicTransforms;
+    const auto& positions = transforms.getPositions();
+    for (size_t i = 0; i < positions.size(); ++i) {
+        // Distance first, so only nearby objects are touched
+        const auto& position = positions[i];
+        if (glm::distance2(center2D, glm::vec2(position)) > reach * reach) {
+            continue;
+        }
+        if (!transforms.getOwner(static_cast<TransformStore::Handle>(i))) {
+            continue;
+        }
+        const auto cell = occupancyCell(position, cellSize);
+        occupancy.emplace_back(occupancyKey(cell.x, cell.y), position);
+    }
+    std::sort(occupancy.begin(), occupancy.end(), compareOccupancyKey);
+}
+
+bool TrafficDirector::isOccupied(const glm::vec3& position,
+                                 float blockDistance) const {
+    if (!std::isfinite(blockDistance)) {
+        return anyOccupant;
+    }
+
+    // Cells are at least blockDistance wide, so only the neighbouring cells
+    // can hold anything close enough
+    const float blockDistance2 = blockDistance * blockDistance;
+    const auto cell = occupancyCell(position, std::max(blockDistance, 1.f));
+    for (int x = cell.x - 1; x <= cell.x + 1; ++x) {
+        for (int y = cell.y - 1; y <= cell.y + 1; ++y) {
+            const std::pair<int64_t, glm::vec3> key{occupancyKey(x, y), {}};
+            auto range = std::equal_range(occupancy.begin(), occupancy.end(),
+                                          key, compareOccupancyKey);
+            for (auto it = range.first; it != range.second; ++it) {
+                if (glm::distance2(position, it->second) <= blockDistance2) {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+void TrafficDirector::updateGeneratorIndex() {
+    const auto& generators = world->state->vehicleGenerators;
+    if (&generators != indexedGenerators ||
+        generators.size() < indexedGeneratorCount) {
+        generatorCells.clear();
+        generatorPositions.clear();
+        indexedGenerators = &generators;
+        indexedGeneratorCount = 0;
+    }
+
+    for (auto index = indexedGeneratorCount; index < generators.size();
+         ++index) {
+        const auto& position = generators[index].position;
+        const auto cell = occupancyCell(position, kGeneratorCellSize);
+        generatorCells[occupancyKey(cell.x, cell.y)].push_back(index);
+        generatorPositions.push_back(
+            {position, position.z >= kGeneratorGroundHeight});
+    }
+    indexedGeneratorCount = generators.size();
+}
+
+glm::vec3 TrafficDirector::getGeneratorPosition(size_t index) {
+    auto& entry = generatorPositions[index];
+    if (!entry.resolved) {
+        // Keep casting until something is hit, the ground may not be
+        // loaded yet
+        const auto ground = world->getGroundAtPosition(entry.position);
+        if (ground == entry.position) {
+            return ground;
+        }
+        entry.position = ground;
+        entry.resolved = true;
+    }
+    return entry.position;
+}
+
 std::vector<ai::AIGraphNode*> TrafficDirector::findAvailableNodes(
     ai::NodeType type, const ViewCamera& camera, float radius) {
     std::vector<ai::AIGraphNode*> available;
     available.reserve(20);
 
-    graph->gatherExternalNodesNear(camera.position, radius, available, type);
+    updateCandidates(camera.position, radius);
 
     float density = type == ai::NodeType::Vehicle ? carDensity : pedDensity;
-    float minDist = (15.f / density) * (15.f / density);
+    float blockDistance = 15.f / density;
+    float radius2 = radius * radius;
     float halfRadius2 = std::pow(radius / 2.f, 2.f);
 
-    // Check if any of the nearby nodes are blocked by a pedestrian or vehicle standing on
-    // it
-    // or because it's inside the view frustum
-    for (auto it = available.begin(); it != available.end();) {
-        bool blocked = false;
-        float dist2 = glm::distance2(camera.position, (*it)->position);
-
-        for (const auto& obj : world->pedestrianPool.objects) {
-            if (glm::distance2((*it)->position, obj.second->getPosition()) <=
-                minDist) {
-                blocked = true;
-                break;
-            }
+    updateOccupancy(camera.position, radius, blockDistance);
+
+    // Check if any of the nearby nodes are blocked by a pedestrian or vehicle
+    // standing on it, or because it's inside the view frustum
+    for (AIGraphNode* node : candidates) {
+        if (node->type != type) {
+            continue;
         }
 
-        for (const auto& obj : world->vehiclePool.objects) {
-            if (glm::distance2((*it)->position, obj.second->getPosition()) <=
-                minDist) {
-                blocked = true;
-                break;
-            }
+        float dist2 = glm::distance2(camera.position, node->position);
+        if (dist2 >= radius2) {
+            continue;
+        }
+
+        if (isOccupied(node->position, blockDistance)) {
+            continue;
         }
 
         // Check that we're not going to spawn something right where the player
         // is looking
         if (dist2 <= halfRadius2 &&
-            camera.frustum.intersects((*it)->position, 1.f)) {
-            blocked = true;
+            camera.frustum.intersects(node->position, 1.f)) {
+            continue;
         }
 
-        if (blocked) {
-            it = available.erase(it);
-        } else {
-            it++;
-        }
+        available.push_back(node);
     }
 
     return available;
@@ -105,28 +231,43 @@ std::vector<GameObject*> TrafficDirector::populateNearby(
     float halfRadius2 = std::pow(radius / 2.f, 2.f);
 
     // Spawn vehicles at vehicle generators
-    auto camera2D = glm::vec2(camera.position);
-    for (auto& gen : world->state->vehicleGenerators) {
-        /// @todo verify how vehicle generator proximity is determined
-        auto gen2D = glm::vec2(gen.position);
-        float dist2 = glm::distance2(camera2D, gen2D);
-        if (dist2 < radius * radius) {
-            auto position = gen.position;
-            // Check that the on-ground position is not in view
-            if (gen.position.z < -90.f) {
-                position = world->getGroundAtPosition(position);
+    updateGeneratorIndex();
+    auto& generators = world->state->vehicleGenerators;
+    const auto timeMS = static_cast<int>(world->state->basic.timeMS);
+    const auto camera2D = glm::vec2(camera.position);
+    const auto minCell =
+        occupancyCell(camera.position - glm::vec3(radius), kGeneratorCellSize);
+    const auto maxCell =
+        occupancyCell(camera.position + glm::vec3(radius), kGeneratorCellSize);
+    for (int x = minCell.x; x <= maxCell.x; ++x) {
+        for (int y = minCell.y; y <= maxCell.y; ++y) {
+            const auto cell = generatorCells.find(occupancyKey(x, y));
+            if (cell == generatorCells.end()) {
+                continue;
             }
 
-            if (dist2 <= halfRadius2 &&
-                camera.frustum.intersects(position, 1.f)) {
-                if (!gen.alwaysSpawn) {
-                    // Don't spawn in the view frustum unless we're forced to
+            for (const auto index : cell->second) {
+                auto& gen = generators[index];
+                /// @todo verify how vehicle generator proximity is determined
+                auto gen2D = glm::vec2(gen.position);
+                float dist2 = glm::distance2(camera2D, gen2D);
+                if (dist2 >= radius * radius || !gen.isReady(timeMS)) {
                     continue;
                 }
-            }
-            auto spawned = world->tryToSpawnVehicle(gen);
-            if (spawned) {
-                created.push_back(spawned);
+
+                // Check that the on-ground position is not in view
+                const auto position = getGeneratorPosition(index);
+                if (dist2 <= halfRadius2 &&
+                    camera.frustum.intersects(position, 1.f)) {
+                    if (!gen.alwaysSpawn) {
+                        // Only forced generators spawn in view
+                        continue;
+                    }
+                }
+                auto spawned = world->tryToSpawnVehicle(gen, position);
+                if (spawned) {
+                    created.push_back(spawned);
+                }
             }
         }
     }
@@ -135,7 +276,7 @@ std::vector<GameObject*> TrafficDirector::populateNearby(
     std::vector<uint16_t> peds = {1};
 
     // Determine which zone the viewpoint is in
-    auto zone = world->data->findZoneAt(camera.position);
+    auto zone = world->data->findZoneAt(camera.position, zoneCache);
     bool day = (world->state->basic.gameHour >= 8 &&
                 world->state->basic.gameHour <= 19);
     int groupid = zone ? (day ? zone->pedGroupDay : zone->pedGroupNight) : 0;
@@ -263,6 +404,39 @@ std::vector<GameObject*> TrafficDirector::populateNearby(
     return created;
 }
 
+void TrafficDirector::cleanupTraffic(const ViewCamera& camera, float radius,
+                                     size_t budget) {
+    const auto cleanupPool = [&](GameWorld::ObjectPool& pool,
+                                 GameObjectID& cursor) {
+        auto& objects = pool.objects;
+        const auto count = std::min(budget, objects.size());
+        auto it = objects.lower_bound(cursor);
+        for (size_t checked = 0; checked < count; ++checked) {
+            if (it == objects.end()) {
+                it = objects.begin();
+            }
+            GameObject* object = (it++)->second.get();
+
+            if (object->getLifetime() != GameObject::TrafficLifetime) {
+                continue;
+            }
+            if (glm::distance(camera.position, object->getPosition()) >=
+                    radius &&
+                !camera.frustum.intersects(object->getPosition(), 1.f)) {
+                world->destroyObjectQueued(object);
+            }
+        }
+        // Objects are only removed from the pool below, the next one is
+        // still valid
+        cursor = it == objects.end() ? 0 : it->first;
+    };
+
+    cleanupPool(world->pedestrianPool, pedestrianCleanupCursor);
+    cleanupPool(world->vehiclePool, vehicleCleanupCursor);
+
+    world->destroyQueuedObjects();
+}
+
 void TrafficDirector::setPopulationLimits(int maxPeds, int maxCars) {
     maximumPedestrians = maxPeds;
     maximumCars = maxCars;
@@ -1,11 +1,22 @@
 #ifndef _RWENGINE_TRAFFICDIRECTOR_HPP_
 #define _RWENGINE_TRAFFICDIRECTOR_HPP_
 
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+
+#include <data/ZoneIndex.hpp>
+#include <objects/ObjectTypes.hpp>
+
 class GameWorld;
 class GameObject;
 class ViewCamera;
+struct VehicleGenerator;
 
 namespace ai {
 
@@ -32,18 +43,84 @@ public:
     std::vector<GameObject*> populateNearby(const ViewCamera& camera,
                                             float radius, int maxSpawn = -1);
 
+    /**
+     * Destroys traffic that is at least radius away from the camera and out
+     * of view. Only checks up to budget objects of each pool per call,
+     * continuing where the last call stopped.
+     */
+    void cleanupTraffic(const ViewCamera& camera, float radius,
+                        size_t budget);
+
     /**
      * Sets the maximum number of pedestrians and cars in the traffic system
      */
     void setPopulationLimits(int maxPeds, int maxCars);
 
 private:
+    /**
+     * Refreshes the external nodes near center when the grid cells covered
+     * by radius, or the graph, have changed
+     */
+    void updateCandidates(const glm::vec3& center, float radius);
+
+    /**
+     * Buckets the pedestrians and vehicles that can block nodes within
+     * radius of center, in cells of blockDistance
+     */
+    void updateOccupancy(const glm::vec3& center, float radius,
+                         float blockDistance);
+
+    bool isOccupied(const glm::vec3& position, float blockDistance) const;
+
+    /**
+     * Indexes the vehicle generators added since the last call, or all of
+     * them if the list was replaced
+     */
+    void updateGeneratorIndex();
+
+    /**
+     * @return where the generator at index spawns, on the ground for
+     * generators placed below the map
+     */
+    glm::vec3 getGeneratorPosition(size_t index);
+
+    /// External nodes in the grid cells from candidateMin to candidateMax
+    std::vector<AIGraphNode*> candidates;
+    glm::ivec2 candidateMin{1, 1};
+    glm::ivec2 candidateMax{0, 0};
+    size_t candidateGraphSize = 0;
+
+    /// Pedestrian and vehicle positions sorted by occupancy cell
+    std::vector<std::pair<int64_t, glm::vec3>> occupancy;
+    bool anyOccupant = false;
+
+    /// Indices of the vehicle generators in each grid cell
+    std::unordered_map<int64_t, std::vector<size_t>> generatorCells;
+    /// The list indexed in generatorCells, generators are only ever appended
+    const std::vector<VehicleGenerator>* indexedGenerators = nullptr;
+    size_t indexedGeneratorCount = 0;
+
+    struct GeneratorPosition {
+        glm::vec3 position;
+        /// False until the ground below a generator placed under the map
+        /// has been found
+        bool resolved;
+    };
+    std::vector<GeneratorPosition> generatorPositions;
+
+    /// Where cleanupTraffic continues in the pedestrian and vehicle pools
+    GameObjectID pedestrianCleanupCursor = 0;
+    GameObjectID vehicleCleanupCursor = 0;
+
     AIGraph* graph = nullptr;
     GameWorld* world = nullptr;
     float pedDensity = 1.f;
     float carDensity = 1.f;
     size_t maximumPedestrians = 20;
     size_t maximumCars = 10;
+
+    /// The camera rarely leaves its zone between ticks
+    ZoneIndex::Cache zoneCache;
 };
 
 }  // namespace ai
@@ -315,6 +315,28 @@ bool SoundManager::loadMusic(const std::string& name,
     return loadSound(name, fileName);
 }
 
+bool SoundManager::loadMusic(const std::string& name,
+                             std::shared_ptr<SoundSource> source) {
+    if (!source || source->data.empty()) {
+        return false;
+    }
+
+    auto sound_iter = sounds.find(name);
+    if (sound_iter != sounds.end()) {
+        return sound_iter->second.isLoaded;
+    }
+
+    auto [it, emplaced] = sounds.emplace(std::piecewise_construct,
+                                         std::forward_as_tuple(name),
+                                         std::forward_as_tuple());
+    auto& sound = it->second;
+    sound.source = std::move(source);
+    sound.buffer = std::make_unique<SoundBuffer>();
+    sound.isLoaded = sound.buffer->bufferData(*sound.source);
+
+    return sound.isLoaded;
+}
+
 void SoundManager::playMusic(const std::string& name) {
     auto sound = sounds.find(name);
     if (sound != sounds.end()) {
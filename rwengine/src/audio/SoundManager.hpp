@@ -11,10 +11,12 @@
 #include <rw/filesystem.hpp>
 #include <loaders/LoaderSDT.hpp>
 
+#include <memory>
 #include <string>
 #include <unordered_map>
 
 class GameWorld;
+class SoundSource;
 class ViewCamera;
 
 /// Game's sound manager.
@@ -75,6 +77,11 @@ public:
     bool playBackground(const std::string& fileName);
 
     bool loadMusic(const std::string& name, const std::string& fileName);
+
+    /// Load music from a source decoded elsewhere, e.g. on a worker thread.
+    /// Only the OpenAL upload happens here.
+    bool loadMusic(const std::string& name,
+                   std::shared_ptr<SoundSource> source);
     void playMusic(const std::string& name);
     void stopMusic(const std::string& name);
 
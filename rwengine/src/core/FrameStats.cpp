@@ -0,0 +1,33 @@
+#include "core/FrameStats.hpp"
+
+#include <rw/debug.hpp>
+
+std::array<float, FrameStats::SectionCount> FrameStats::times_{};
+
+const char* FrameStats::getSectionName(Section section) {
+    switch (section) {
+        case TickWorld:
+            return "tickWorld";
+        case StepSimulation:
+            return "stepSimulation";
+        case CreateRenderList:
+            return "createObjectRenderList";
+        case DrawBatched:
+            return "drawBatched";
+        default:
+            RW_ERROR("Invalid frame section " << section);
+            return "";
+    }
+}
+
+void FrameStats::reset() {
+    times_.fill(0.f);
+}
+
+float FrameStats::getTime(Section section) {
+    return times_[section];
+}
+
+void FrameStats::addTime(Section section, float milliseconds) {
+    times_[section] += milliseconds;
+}
@@ -0,0 +1,67 @@
+#ifndef _RWENGINE_FRAMESTATS_HPP_
+#define _RWENGINE_FRAMESTATS_HPP_
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+
+/**
+ * @brief CPU time spent in the main parts of the current frame.
+ *
+ * Unlike the profiler this is always enabled, there are only a handful of
+ * sections per frame. The main loop calls reset() at the start of a frame,
+ * anything that wants per frame timings reads them before the next reset.
+ * Sections may only be timed on the main thread.
+ */
+class FrameStats {
+public:
+    enum Section {
+        TickWorld,
+        StepSimulation,
+        CreateRenderList,
+        DrawBatched,
+        SectionCount
+    };
+
+    static const char* getSectionName(Section section);
+
+    static void reset();
+
+    /**
+     * @return milliseconds spent in the section since the last reset
+     */
+    static float getTime(Section section);
+
+    static void addTime(Section section, float milliseconds);
+
+    /**
+     * Adds the time until the end of the scope to a section
+     */
+    class ScopedTimer {
+    public:
+        explicit ScopedTimer(Section section)
+            : section_(section), start_(std::chrono::steady_clock::now()) {
+        }
+
+        ~ScopedTimer() {
+            std::chrono::duration<float, std::milli> elapsed =
+                std::chrono::steady_clock::now() - start_;
+            addTime(section_, elapsed.count());
+        }
+
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    private:
+        Section section_;
+        std::chrono::steady_clock::time_point start_;
+    };
+
+private:
+    static std::array<float, SectionCount> times_;
+};
+
+#define RW_FRAME_SECTION(section) \
+    FrameStats::ScopedTimer rwFrameSectionTimer(FrameStats::section)
+
+#endif
@@ -0,0 +1,217 @@
+#include "core/JobSystem.hpp"
+
+#include <string>
+
+#include <rw/debug.hpp>
+
+#include "core/Profiler.hpp"
+
+namespace {
+thread_local const JobSystem* tlsJobSystem = nullptr;
+thread_local int tlsWorkerIndex = -1;
+}  // namespace
+
+TaskGraph::TaskID TaskGraph::add(std::function<void()> task) {
+    nodes_.push_back({std::move(task), {}, 0});
+    return nodes_.size() - 1;
+}
+
+void TaskGraph::precede(TaskID before, TaskID after) {
+    RW_ASSERT(before < nodes_.size() && after < nodes_.size());
+    nodes_[before].successors.push_back(after);
+    nodes_[after].dependencies++;
+}
+
+JobSystem::JobSystem(unsigned workerCount) {
+    workers_.reserve(workerCount);
+    for (unsigned i = 0; i < workerCount; ++i) {
+        workers_.push_back(std::make_unique<Worker>());
+    }
+    // Start the threads only once every queue exists, they steal from all
+    for (unsigned i = 0; i < workerCount; ++i) {
+        workers_[i]->thread = std::thread(&JobSystem::workerMain, this, i);
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (auto& worker : workers_) {
+        worker->thread.join();
+    }
+}
+
+unsigned JobSystem::defaultWorkerCount() {
+    auto cores = std::thread::hardware_concurrency();
+    return cores > 1 ? cores - 1 : 0;
+}
+
+void JobSystem::submit(JobCounter& counter, Job job) {
+    counter.pending_.fetch_add(1, std::memory_order_relaxed);
+    Task task{std::move(job), &counter};
+    if (isSingleThreaded()) {
+        execute(task);
+        return;
+    }
+    push(std::move(task));
+}
+
+void JobSystem::wait(JobCounter& counter) {
+    while (!counter.isDone()) {
+        if (!runQueuedTask()) {
+            std::this_thread::yield();
+        }
+    }
+
+    std::exception_ptr error;
+    {
+        std::lock_guard<std::mutex> lock(counter.errorMutex_);
+        std::swap(error, counter.error_);
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+void JobSystem::run(const TaskGraph& graph) {
+    const auto& nodes = graph.nodes_;
+    auto remaining = std::make_unique<std::atomic<size_t>[]>(nodes.size());
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        remaining[i].store(nodes[i].dependencies, std::memory_order_relaxed);
+    }
+
+    JobCounter counter;
+    std::atomic<size_t> finished{0};
+
+    // Each task schedules the successors it was the last dependency of.
+    std::function<void(TaskGraph::TaskID)> schedule =
+        [&](TaskGraph::TaskID id) {
+            submit(counter, [&, id] {
+                nodes[id].task();
+                finished.fetch_add(1, std::memory_order_relaxed);
+                for (auto next : nodes[id].successors) {
+                    if (remaining[next].fetch_sub(
+                            1, std::memory_order_acq_rel) == 1) {
+                        schedule(next);
+                    }
+                }
+            });
+        };
+
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        if (nodes[i].dependencies == 0) {
+            schedule(i);
+        }
+    }
+
+    wait(counter);
+
+    RW_CHECK(finished.load() == nodes.size(),
+             "TaskGraph has a dependency cycle, "
+                 << nodes.size() - finished.load() << " tasks didn't run");
+}
+
+void JobSystem::workerMain(unsigned index) {
+    tlsJobSystem = this;
+    tlsWorkerIndex = static_cast<int>(index);
+
+    std::string name = "Worker " + std::to_string(index);
+    RW_PROFILE_THREAD(name.c_str());
+    RW_UNUSED(name);
+
+    for (;;) {
+        if (runQueuedTask()) {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        wake_.wait(lock, [this] {
+            return stopping_ || queued_.load(std::memory_order_acquire) > 0;
+        });
+        if (stopping_ && queued_.load(std::memory_order_acquire) == 0) {
+            return;
+        }
+    }
+}
+
+int JobSystem::currentWorker() const {
+    return tlsJobSystem == this ? tlsWorkerIndex : -1;
+}
+
+bool JobSystem::runQueuedTask() {
+    if (queued_.load(std::memory_order_acquire) == 0) {
+        return false;
+    }
+
+    const int self = currentWorker();
+    const auto count = workers_.size();
+
+    Task task;
+    bool found = false;
+
+    if (self >= 0) {
+        auto& own = *workers_[static_cast<size_t>(self)];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            found = true;
+        }
+    }
+
+    // Steal the oldest task from another queue, starting after our own
+    const size_t start = self >= 0 ? static_cast<size_t>(self) + 1 : 0;
+    for (size_t i = 0; i < count && !found; ++i) {
+        auto& victim = *workers_[(start + i) % count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            found = true;
+        }
+    }
+
+    if (!found) {
+        return false;
+    }
+
+    queued_.fetch_sub(1, std::memory_order_acq_rel);
+    {
+        RW_PROFILE_SCOPE("Job");
+        execute(task);
+    }
+    return true;
+}
+
+void JobSystem::push(Task task) {
+    const int self = currentWorker();
+    auto index = self >= 0 ? static_cast<unsigned>(self)
+                           : nextWorker_.fetch_add(1) % getWorkerCount();
+    auto& worker = *workers_[index];
+    {
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        worker.tasks.push_back(std::move(task));
+    }
+    {
+        // Increment under the lock, so a worker can't miss the wake up
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        queued_.fetch_add(1, std::memory_order_release);
+    }
+    wake_.notify_one();
+}
+
+void JobSystem::execute(Task& task) {
+    try {
+        task.job();
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(task.counter->errorMutex_);
+        if (!task.counter->error_) {
+            task.counter->error_ = std::current_exception();
+        }
+    }
+    // The counter may be gone as soon as it reaches zero
+    task.counter->pending_.fetch_sub(1, std::memory_order_acq_rel);
+}
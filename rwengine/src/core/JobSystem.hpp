@@ -0,0 +1,188 @@
+#ifndef _RWENGINE_JOBSYSTEM_HPP_
+#define _RWENGINE_JOBSYSTEM_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Tracks a group of jobs so that they can be waited on together.
+ *
+ * A counter must outlive the jobs submitted with it, JobSystem::wait() makes
+ * sure of that.
+ */
+class JobCounter {
+public:
+    bool isDone() const {
+        return pending_.load(std::memory_order_acquire) == 0;
+    }
+
+private:
+    friend class JobSystem;
+
+    std::atomic<size_t> pending_{0};
+    std::mutex errorMutex_;
+    std::exception_ptr error_;
+};
+
+/**
+ * @brief A set of tasks and the order they have to run in.
+ *
+ * A task is started once every task that precedes it has finished. The same
+ * graph can be run any number of times.
+ */
+class TaskGraph {
+public:
+    using TaskID = size_t;
+
+    TaskID add(std::function<void()> task);
+
+    /**
+     * Makes the task after wait for the task before to finish
+     */
+    void precede(TaskID before, TaskID after);
+
+    size_t size() const {
+        return nodes_.size();
+    }
+
+private:
+    friend class JobSystem;
+
+    struct Node {
+        std::function<void()> task;
+        std::vector<TaskID> successors;
+        size_t dependencies = 0;
+    };
+
+    std::vector<Node> nodes_;
+};
+
+/**
+ * @class JobSystem
+ * Runs jobs on a pool of worker threads.
+ *
+ * Every worker has its own queue. Jobs submitted from a worker go to the
+ * back of its own queue and are taken from there again, so related work
+ * stays on the same thread. Idle workers steal from the front of the other
+ * workers' queues. Jobs submitted from other threads are spread over the
+ * workers.
+ *
+ * Threads waiting for jobs run queued jobs until the ones they wait for have
+ * finished, so waiting inside a job doesn't deadlock.
+ *
+ * With no worker threads every job runs immediately on the thread that
+ * submits it, which makes the order of execution deterministic. This is
+ * meant for tests and for machines with a single core.
+ */
+class JobSystem {
+public:
+    using Job = std::function<void()>;
+
+    /**
+     * @param workerCount number of worker threads to start, 0 runs all jobs
+     * on the submitting thread.
+     */
+    explicit JobSystem(unsigned workerCount = defaultWorkerCount());
+
+    /**
+     * Finishes all queued jobs and stops the workers.
+     */
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    /**
+     * @return one worker for each core, besides the one the caller runs on
+     */
+    static unsigned defaultWorkerCount();
+
+    unsigned getWorkerCount() const {
+        return static_cast<unsigned>(workers_.size());
+    }
+
+    bool isSingleThreaded() const {
+        return workers_.empty();
+    }
+
+    /**
+     * Queues a job, counter is decremented once it has run
+     */
+    void submit(JobCounter& counter, Job job);
+
+    /**
+     * Runs jobs until every job submitted with counter has finished
+     *
+     * If any of those jobs threw, the first exception is rethrown here.
+     */
+    void wait(JobCounter& counter);
+
+    /**
+     * Runs every task in the graph and waits for them to finish
+     */
+    void run(const TaskGraph& graph);
+
+    /**
+     * Calls fn(first, last) over consecutive ranges covering [begin, end)
+     * and waits for them to finish.
+     *
+     * @param grain the largest range passed to a single call. Larger grains
+     * mean less scheduling overhead and less load balancing.
+     */
+    template <class Fn>
+    void parallelFor(size_t begin, size_t end, size_t grain, Fn&& fn) {
+        grain = std::max<size_t>(grain, 1);
+        JobCounter counter;
+        for (size_t first = begin; first < end;) {
+            size_t last = end - first > grain ? first + grain : end;
+            submit(counter, [&fn, first, last] { fn(first, last); });
+            first = last;
+        }
+        wait(counter);
+    }
+
+private:
+    struct Task {
+        Job job;
+        JobCounter* counter = nullptr;
+    };
+
+    struct Worker {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+        std::thread thread;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+
+    /// Number of tasks in all of the queues
+    std::atomic<size_t> queued_{0};
+    std::atomic<unsigned> nextWorker_{0};
+    bool stopping_ = false;
+
+    std::mutex sleepMutex_;
+    std::condition_variable wake_;
+
+    void workerMain(unsigned index);
+
+    /// @return the index of the calling worker, or -1 for other threads
+    int currentWorker() const;
+
+    /// Runs one queued task, preferring the calling worker's own queue
+    bool runQueuedTask();
+
+    void push(Task task);
+
+    static void execute(Task& task);
+};
+
+#endif
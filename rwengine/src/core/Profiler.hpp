@@ -1,7 +1,23 @@
 #ifndef _RWENGINE_PROFILER_HPP_
 #define _RWENGINE_PROFILER_HPP_
 
-#ifdef RW_PROFILER
+#if defined(RW_PROFILER) && defined(RW_PROFILER_TRACE)
+#include <core/TraceProfiler.hpp>
+#define RW_PROFILE_CONCAT_(a, b) a##b
+#define RW_PROFILE_CONCAT(a, b) RW_PROFILE_CONCAT_(a, b)
+#define RW_PROFILE_THREAD(name) TraceProfiler::setThreadName(name)
+#define RW_PROFILE_FRAME_BOUNDARY() TraceProfiler::frame()
+#define RW_PROFILE_SCOPE(label) \
+    TraceProfiler::Scope RW_PROFILE_CONCAT(rwProfileScope, __LINE__)(label)
+#define RW_PROFILE_SCOPEC(label, colour) RW_PROFILE_SCOPE(label)
+#define RW_PROFILE_COUNTER_ADD(name, qty) \
+    TraceProfiler::counterAdd(name, static_cast<int64_t>(qty))
+#define RW_PROFILE_COUNTER_SET(name, qty) \
+    TraceProfiler::counterSet(name, static_cast<int64_t>(qty))
+#define RW_TIMELINE_ENTER(name, color) TraceProfiler::timelineEnter(name)
+#define RW_TIMELINE_LEAVE(name) TraceProfiler::timelineLeave(name)
+#define RW_PROFILE_WRITE_TRACE(path) TraceProfiler::writeChromeTrace(path)
+#elif defined(RW_PROFILER)
 #include <microprofile.h>
 #define RW_PROFILE_THREAD(name) MicroProfileOnThreadCreate(name)
 #define RW_PROFILE_FRAME_BOUNDARY() MicroProfileFlip(nullptr)
@@ -11,6 +27,7 @@
 #define RW_PROFILE_COUNTER_SET(name, qty) MICROPROFILE_COUNTER_SET(name, qty)
 #define RW_TIMELINE_ENTER(name, color) MICROPROFILE_TIMELINE_ENTER_STATIC(color, name)
 #define RW_TIMELINE_LEAVE(name) MICROPROFILE_TIMELINE_LEAVE_STATIC(name)
+#define RW_PROFILE_WRITE_TRACE(path) false
 #else
 #define RW_PROFILE_THREAD(name) do {} while (0)
 #define RW_PROFILE_FRAME_BOUNDARY() do {} while (0)
@@ -20,6 +37,7 @@
 #define RW_PROFILE_COUNTER_SET(name, qty) do {} while (0)
 #define RW_TIMELINE_ENTER(name, color) do {} while (0)
 #define RW_TIMELINE_LEAVE(name) do {} while (0)
+#define RW_PROFILE_WRITE_TRACE(path) false
 #endif
 
 #endif
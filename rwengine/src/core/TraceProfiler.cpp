@@ -0,0 +1,257 @@
+#include "core/TraceProfiler.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+struct Chunk {
+    static constexpr size_t kSize = 4096;
+
+    std::array<TraceProfiler::Event, kSize> events;
+    /// Number of events that may be read, only the owning thread writes
+    std::atomic<size_t> count{0};
+    std::atomic<Chunk*> next{nullptr};
+};
+
+struct ThreadBuffer {
+    uint32_t id = 0;
+    /// Guarded by the registry's mutex
+    std::string name;
+
+    Chunk* head = nullptr;
+    /// Only used by the owning thread
+    Chunk* tail = nullptr;
+    size_t recorded = 0;
+
+    std::atomic<size_t> dropped{0};
+};
+
+struct Registry {
+    const std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> threads;
+};
+
+// Never destroyed, threads may still record while statics are torn down.
+// Buffers live as long as the registry, so traces include exited threads.
+Registry& registry() {
+    static auto* instance = new Registry;
+    return *instance;
+}
+
+thread_local ThreadBuffer* tlsBuffer = nullptr;
+
+ThreadBuffer& threadBuffer() {
+    if (!tlsBuffer) {
+        auto buffer = std::make_unique<ThreadBuffer>();
+        buffer->head = buffer->tail = new Chunk;
+
+        auto& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        buffer->id = static_cast<uint32_t>(reg.threads.size()) + 1;
+        buffer->name = "Thread " + std::to_string(buffer->id);
+        tlsBuffer = buffer.get();
+        reg.threads.push_back(std::move(buffer));
+    }
+    return *tlsBuffer;
+}
+
+/// Calls fn(event) for every event the buffer has published
+template <class Fn>
+void forEachEvent(const ThreadBuffer& buffer, Fn&& fn) {
+    for (const Chunk* chunk = buffer.head; chunk;
+         chunk = chunk->next.load(std::memory_order_acquire)) {
+        const auto count = chunk->count.load(std::memory_order_acquire);
+        for (size_t i = 0; i < count; ++i) {
+            fn(chunk->events[i]);
+        }
+    }
+}
+
+void writeString(std::ostream& out, const char* str) {
+    out << '"';
+    for (; *str; ++str) {
+        const auto c = static_cast<unsigned char>(*str);
+        if (c == '"' || c == '\\') {
+            out << '\\' << *str;
+        } else if (c < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            out << escaped;
+        } else {
+            out << *str;
+        }
+    }
+    out << '"';
+}
+
+/// Trace timestamps are microseconds, keep the nanoseconds as decimals
+void writeMicroseconds(std::ostream& out, uint64_t nanoseconds) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%llu.%03u",
+                  static_cast<unsigned long long>(nanoseconds / 1000),
+                  static_cast<unsigned>(nanoseconds % 1000));
+    out << buffer;
+}
+
+struct CounterEvent {
+    uint32_t thread;
+    TraceProfiler::Event event;
+};
+}  // namespace
+
+uint64_t TraceProfiler::now() {
+    const auto& reg = registry();
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - reg.start)
+            .count());
+}
+
+void TraceProfiler::record(const char* name, uint64_t time, int64_t value,
+                           EventType type) {
+    auto& buffer = threadBuffer();
+    if (buffer.recorded >= kMaxEventsPerThread) {
+        buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    auto* chunk = buffer.tail;
+    auto index = chunk->count.load(std::memory_order_relaxed);
+    if (index == Chunk::kSize) {
+        auto* next = new Chunk;
+        chunk->next.store(next, std::memory_order_release);
+        buffer.tail = chunk = next;
+        index = 0;
+    }
+
+    chunk->events[index] = {name, time, value, type};
+    chunk->count.store(index + 1, std::memory_order_release);
+    buffer.recorded++;
+}
+
+void TraceProfiler::setThreadName(const char* name) {
+    auto& buffer = threadBuffer();
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    buffer.name = name;
+}
+
+size_t TraceProfiler::getEventCount() {
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    size_t count = 0;
+    for (const auto& buffer : reg.threads) {
+        forEachEvent(*buffer, [&count](const Event&) { count++; });
+    }
+    return count;
+}
+
+size_t TraceProfiler::getDroppedCount() {
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    size_t count = 0;
+    for (const auto& buffer : reg.threads) {
+        count += buffer->dropped.load(std::memory_order_relaxed);
+    }
+    return count;
+}
+
+void TraceProfiler::writeChromeTrace(std::ostream& out) {
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+
+    bool first = true;
+    const auto begin = [&](const char* phase, const char* name,
+                           uint32_t thread) {
+        out << (first ? "\n" : ",\n") << "{\"ph\":\"" << phase
+            << "\",\"pid\":1,\"tid\":" << thread << ",\"name\":";
+        writeString(out, name);
+        first = false;
+    };
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    std::vector<CounterEvent> counters;
+    for (const auto& buffer : reg.threads) {
+        begin("M", "thread_name", buffer->id);
+        out << ",\"args\":{\"name\":";
+        writeString(out, buffer->name.c_str());
+        out << "}}";
+
+        forEachEvent(*buffer, [&](const Event& event) {
+            switch (event.type) {
+                case EventType::Scope:
+                    begin("X", event.name, buffer->id);
+                    out << ",\"ts\":";
+                    writeMicroseconds(out, event.time);
+                    out << ",\"dur\":";
+                    writeMicroseconds(out, static_cast<uint64_t>(event.value));
+                    out << '}';
+                    break;
+                case EventType::Frame:
+                    begin("i", event.name, buffer->id);
+                    out << ",\"s\":\"g\",\"ts\":";
+                    writeMicroseconds(out, event.time);
+                    out << '}';
+                    break;
+                case EventType::TimelineEnter:
+                case EventType::TimelineLeave:
+                    begin(event.type == EventType::TimelineEnter ? "b" : "e",
+                          event.name, buffer->id);
+                    out << ",\"cat\":\"timeline\",\"id\":\"0x" << std::hex
+                        << std::hash<std::string>()(event.name) << std::dec
+                        << "\",\"ts\":";
+                    writeMicroseconds(out, event.time);
+                    out << '}';
+                    break;
+                case EventType::CounterAdd:
+                case EventType::CounterSet:
+                    counters.push_back({buffer->id, event});
+                    break;
+            }
+        });
+    }
+
+    // Additions from different threads only add up in time order
+    std::stable_sort(counters.begin(), counters.end(),
+                     [](const CounterEvent& a, const CounterEvent& b) {
+                         return a.event.time < b.event.time;
+                     });
+    std::unordered_map<std::string, int64_t> values;
+    for (const auto& counter : counters) {
+        auto& value = values[counter.event.name];
+        if (counter.event.type == EventType::CounterAdd) {
+            value += counter.event.value;
+        } else {
+            value = counter.event.value;
+        }
+        begin("C", counter.event.name, counter.thread);
+        out << ",\"ts\":";
+        writeMicroseconds(out, counter.event.time);
+        out << ",\"args\":{\"value\":" << value << "}}";
+    }
+
+    out << "\n]}\n";
+}
+
+bool TraceProfiler::writeChromeTrace(const std::string& path) {
+    std::ofstream out(path);
+    if (!out) {
+        return false;
+    }
+    writeChromeTrace(out);
+    return !!out;
+}
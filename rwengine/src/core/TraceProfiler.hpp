@@ -0,0 +1,116 @@
+#ifndef _RWENGINE_TRACEPROFILER_HPP_
+#define _RWENGINE_TRACEPROFILER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+/**
+ * @brief Lightweight profiler that records into memory and writes Chrome
+ * trace files.
+ *
+ * Every thread records into its own buffer, so recording an event takes no
+ * locks: it reads the clock, fills in the next slot and publishes it with a
+ * single atomic store. Buffers hold up to kMaxEventsPerThread events, any
+ * further events are counted and dropped.
+ *
+ * The trace can be written at any time, also while other threads are
+ * recording. It is in the Chrome trace event format, which both
+ * chrome://tracing and the Perfetto UI open.
+ *
+ * Names are stored by pointer and must outlive the profiler, string
+ * literals and __func__ are fine. Thread names are copied.
+ */
+class TraceProfiler {
+public:
+    static constexpr size_t kMaxEventsPerThread = size_t{1} << 20;
+
+    enum class EventType : uint8_t {
+        Scope,
+        CounterAdd,
+        CounterSet,
+        TimelineEnter,
+        TimelineLeave,
+        Frame,
+    };
+
+    struct Event {
+        const char* name;
+        /// Nanoseconds since the profiler started
+        uint64_t time;
+        /// Duration in nanoseconds for scopes, the amount for counters
+        int64_t value;
+        EventType type;
+    };
+
+    /**
+     * Records a scope from construction to destruction
+     */
+    class Scope {
+    public:
+        explicit Scope(const char* name) : name_(name), start_(now()) {
+        }
+
+        ~Scope() {
+            record(name_, start_, static_cast<int64_t>(now() - start_),
+                   EventType::Scope);
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        const char* name_;
+        uint64_t start_;
+    };
+
+    /**
+     * @return nanoseconds since the profiler started
+     */
+    static uint64_t now();
+
+    static void record(const char* name, uint64_t time, int64_t value,
+                       EventType type);
+
+    static void setThreadName(const char* name);
+
+    static void frame() {
+        record("Frame", now(), 0, EventType::Frame);
+    }
+
+    static void counterAdd(const char* name, int64_t amount) {
+        record(name, now(), amount, EventType::CounterAdd);
+    }
+
+    static void counterSet(const char* name, int64_t value) {
+        record(name, now(), value, EventType::CounterSet);
+    }
+
+    static void timelineEnter(const char* name) {
+        record(name, now(), 0, EventType::TimelineEnter);
+    }
+
+    static void timelineLeave(const char* name) {
+        record(name, now(), 0, EventType::TimelineLeave);
+    }
+
+    /**
+     * @return the number of events recorded on all threads
+     */
+    static size_t getEventCount();
+
+    /**
+     * @return the number of events lost because a buffer was full
+     */
+    static size_t getDroppedCount();
+
+    /**
+     * Writes every event recorded so far as Chrome trace JSON
+     */
+    static void writeChromeTrace(std::ostream& out);
+
+    static bool writeChromeTrace(const std::string& path);
+};
+
+#endif
@@ -3,10 +3,124 @@
 
 #include <glm/vec3.hpp>
 
-#include <map>
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
 #include <string>
 #include <vector>
 
+/**
+ * @brief Keyframes sorted by time, with the times and values kept apart
+ *
+ * Lookups take a cursor holding the key found by the previous lookup, so
+ * sampling at increasing times only steps over the keys passed since then.
+ * Any other time falls back to a binary search, a stale cursor is only slow.
+ */
+template <class T>
+class KeyframeTrack {
+public:
+    void reserve(size_t count) {
+        times.reserve(count);
+        values.reserve(count);
+    }
+
+    /**
+     * Adds a key, replacing the key at the same time if there is one.
+     * Keys added in order are appended.
+     */
+    void add(float time, const T& value) {
+        if (times.empty() || times.back() < time) {
+            times.push_back(time);
+            values.push_back(value);
+            return;
+        }
+
+        const auto it = std::lower_bound(times.begin(), times.end(), time);
+        const auto index = std::distance(times.begin(), it);
+        if (*it == time) {
+            values[index] = value;
+        } else {
+            times.insert(it, time);
+            values.insert(values.begin() + index, value);
+        }
+    }
+
+    void clear() {
+        times.clear();
+        values.clear();
+    }
+
+    bool empty() const {
+        return times.empty();
+    }
+
+    size_t size() const {
+        return times.size();
+    }
+
+    const std::vector<float>& getTimes() const {
+        return times;
+    }
+
+    const std::vector<T>& getValues() const {
+        return values;
+    }
+
+    /**
+     * @return the index of the last key at or before time, 0 before the
+     * first key. The track must not be empty.
+     */
+    size_t find(float time, size_t& cursor) const {
+        constexpr size_t kMaxSteps = 4;
+
+        if (cursor < times.size() && times[cursor] <= time) {
+            for (size_t step = 0; step < kMaxSteps; ++step) {
+                if (cursor + 1 == times.size() || times[cursor + 1] > time) {
+                    return cursor;
+                }
+                ++cursor;
+            }
+        }
+
+        auto it = std::upper_bound(times.begin(), times.end(), time);
+        if (it != times.begin()) {
+            --it;
+        }
+        cursor = static_cast<size_t>(std::distance(times.begin(), it));
+        return cursor;
+    }
+
+    /**
+     * @return the value at time, linearly interpolated between keys and
+     * clamped to the first and last keys. T() if the track is empty.
+     */
+    T sample(float time, size_t& cursor) const {
+        if (times.empty()) {
+            return T();
+        }
+
+        const auto index = find(time, cursor);
+        if (time <= times[index] || index + 1 == times.size()) {
+            return values[index];
+        }
+
+        const auto& a = values[index];
+        const auto& b = values[index + 1];
+        const float fac =
+            (time - times[index]) / (times[index + 1] - times[index]);
+        return a + (b - a) * fac;
+    }
+
+    T sample(float time) const {
+        size_t cursor = times.size();
+        return sample(time, cursor);
+    }
+
+private:
+    std::vector<float> times;
+    std::vector<T> values;
+};
+
 /**
  * @brief Stores data from .CUT files
  */
@@ -26,28 +140,40 @@ struct CutsceneMetadata {
     glm::vec3 sceneOffset{};
 
     std::vector<ModelEntry> models;
-    std::map<float, TextEntry> texts;
+    KeyframeTrack<TextEntry> texts;
 };
 
 /**
  * @brief Stores the Camera animation data from .DAT files
  */
 struct CutsceneTracks {
-    std::map<float, float> zoom;
-    std::map<float, float> rotation;
-    std::map<float, glm::vec3> position;
-    std::map<float, glm::vec3> target;
+    /// Keys found by the previous lookups, kept by whoever plays the tracks
+    struct Cursor {
+        size_t zoom = 0;
+        size_t rotation = 0;
+        size_t position = 0;
+        size_t target = 0;
+    };
+
+    KeyframeTrack<float> zoom;
+    KeyframeTrack<float> rotation;
+    KeyframeTrack<glm::vec3> position;
+    KeyframeTrack<glm::vec3> target;
     /* Rotation is angle around the target vector */
 
     float duration{0.f};
 
     glm::vec3 getPositionAt(float time) const;
+    glm::vec3 getPositionAt(float time, Cursor& cursor) const;
 
     glm::vec3 getTargetAt(float time) const;
+    glm::vec3 getTargetAt(float time, Cursor& cursor) const;
 
     float getZoomAt(float time) const;
+    float getZoomAt(float time, Cursor& cursor) const;
 
     float getRotationAt(float time) const;
+    float getRotationAt(float time, Cursor& cursor) const;
 };
 
 struct CutsceneData {
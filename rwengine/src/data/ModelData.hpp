@@ -10,6 +10,7 @@
 
 #include <array>
 #include <cstdint>
+#include <limits>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -174,12 +175,39 @@ public:
     }
 
     Atomic* getDistanceAtomic(float d) {
-        for (auto i = 0; i < getNumAtomics(); ++i) {
+        const auto index = getDistanceAtomicIndex(d);
+        return index < getNumAtomics() ? atomics_[index].get() : nullptr;
+    }
+
+    /**
+     * @brief getDistanceAtomicIndex selects the atomic for a distance
+     *
+     * To stop models popping back and forth around a LOD distance, current
+     * is kept while d is within hysteresis (a fraction of the distance) of
+     * its range.
+     * @param current the index selected last time, or -1
+     * @return the index of the atomic, or getNumAtomics() when d is past
+     * all of their distances
+     */
+    int getDistanceAtomicIndex(float d, int current = -1,
+                               float hysteresis = 0.f) const {
+        const int count = getNumAtomics();
+        if (current >= 0 && current <= count) {
+            const auto lower = current > 0 ? loddistances_[current - 1] : 0.f;
+            const auto upper = current < count
+                                   ? loddistances_[current]
+                                   : std::numeric_limits<float>::infinity();
+            if (d >= lower * (1.f - hysteresis) &&
+                d < upper * (1.f + hysteresis)) {
+                return current;
+            }
+        }
+        for (auto i = 0; i < count; ++i) {
             if (d < loddistances_[i]) {
-                return atomics_[i].get();
+                return i;
             }
         }
-        return nullptr;
+        return count;
     }
 
     void setNumAtomics(int num) {
@@ -54,6 +54,13 @@ struct VehicleGenerator {
         , remainingSpawns(remainingSpawns_) {
     }
 
+    /**
+     * @return true if the generator has spawns left and its delay has passed
+     */
+    bool isReady(int timeMS) const {
+        return remainingSpawns > 0 && lastSpawnTime + minDelay <= timeMS;
+    }
+
     size_t getScriptObjectID() const {
         return generatorID;
     }
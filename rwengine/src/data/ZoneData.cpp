@@ -15,13 +15,17 @@ bool ZoneData::containsPoint(const glm::vec3 &point) const {
 }
 
 ZoneData *ZoneData::findLeafAtPoint(const glm::vec3 &point) {
+    // Children are contained by their parent, skip the whole branch early
+    if (!containsPoint(point)) {
+        return nullptr;
+    }
     for (ZoneData* child : children_) {
         auto descendent = child->findLeafAtPoint(point);
         if (descendent) {
             return descendent;
         }
     }
-    return containsPoint(point) ? this : nullptr;
+    return this;
 }
 
 bool ZoneData::insertZone(ZoneData &inner) {
@@ -0,0 +1,191 @@
+#include "data/ZoneIndex.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "data/ZoneData.hpp"
+
+namespace {
+void addNodes(ZoneData& zone, int32_t parent, std::vector<ZoneData*>& zones,
+              std::vector<int32_t>& parents, std::vector<uint32_t>& ends) {
+    const auto index = static_cast<uint32_t>(zones.size());
+    zones.push_back(&zone);
+    parents.push_back(parent);
+    ends.push_back(0);
+    for (ZoneData* child : zone.children_) {
+        addNodes(*child, static_cast<int32_t>(index), zones, parents, ends);
+    }
+    ends[index] = static_cast<uint32_t>(zones.size());
+}
+}  // namespace
+
+void ZoneIndex::build(ZoneData& root) {
+    clear();
+
+    std::vector<ZoneData*> zones;
+    std::vector<int32_t> parents;
+    std::vector<uint32_t> ends;
+    addNodes(root, -1, zones, parents, ends);
+
+    nodes_.reserve(zones.size());
+    for (size_t i = 0; i < zones.size(); ++i) {
+        nodes_.push_back({zones[i], parents[i], ends[i]});
+    }
+
+    // Children lie inside their parent, so the root's area covers them all
+    origin_ = glm::vec2(root.min.x, root.min.y);
+    extent_ = glm::vec2(root.max.x - root.min.x, root.max.y - root.min.y);
+    cellSize_ = glm::vec2(std::max(extent_.x / kCellsPerAxis, 1.f),
+                          std::max(extent_.y / kCellsPerAxis, 1.f));
+
+    const auto cellRange = [&](const ZoneData& zone, int axis, int& first,
+                               int& last) {
+        const auto toCell = [&](float v) {
+            const auto cell = static_cast<int>(
+                std::floor((v - origin_[axis]) / cellSize_[axis]));
+            return std::min(std::max(cell, 0), kCellsPerAxis - 1);
+        };
+        first = toCell(zone.min[axis]);
+        last = toCell(zone.max[axis]);
+    };
+
+    // Count the nodes in each cell, then fill them in. Nodes are added in
+    // depth first order, which find() relies on.
+    cellStart_.assign(kCellsPerAxis * kCellsPerAxis + 1, 0);
+    for (int pass = 0; pass < 2; ++pass) {
+        std::vector<uint32_t> next;
+        if (pass == 1) {
+            for (size_t c = 1; c < cellStart_.size(); ++c) {
+                cellStart_[c] += cellStart_[c - 1];
+            }
+            cellNodes_.resize(cellStart_.back());
+            next.assign(cellStart_.begin(), cellStart_.end() - 1);
+        }
+
+        for (uint32_t n = 0; n < nodes_.size(); ++n) {
+            int x0, x1, y0, y1;
+            cellRange(*nodes_[n].zone, 0, x0, x1);
+            cellRange(*nodes_[n].zone, 1, y0, y1);
+            for (int y = y0; y <= y1; ++y) {
+                for (int x = x0; x <= x1; ++x) {
+                    const auto cell = y * kCellsPerAxis + x;
+                    if (pass == 0) {
+                        cellStart_[cell + 1]++;
+                    } else {
+                        cellNodes_[next[cell]++] = n;
+                    }
+                }
+            }
+        }
+    }
+}
+
+void ZoneIndex::clear() {
+    nodes_.clear();
+    cellStart_.clear();
+    cellNodes_.clear();
+    origin_ = glm::vec2();
+    extent_ = glm::vec2();
+    cellSize_ = glm::vec2();
+    // Invalidates every cache filled from the old nodes
+    generation_++;
+}
+
+int ZoneIndex::cellAt(const glm::vec3& point) const {
+    const auto x = point.x - origin_.x;
+    const auto y = point.y - origin_.y;
+    // Written so that NaNs are outside too
+    if (!(x >= 0.f && x <= extent_.x && y >= 0.f && y <= extent_.y)) {
+        return -1;
+    }
+    const auto cx = std::min(static_cast<int>(x / cellSize_.x),
+                             kCellsPerAxis - 1);
+    const auto cy = std::min(static_cast<int>(y / cellSize_.y),
+                             kCellsPerAxis - 1);
+    return cy * kCellsPerAxis + cx;
+}
+
+ZoneData* ZoneIndex::find(const glm::vec3& point) const {
+    return find(point, nullptr);
+}
+
+ZoneData* ZoneIndex::find(const glm::vec3& point, Cache& cache) const {
+    if (cache.generation == generation_ && point.x > cache.min.x &&
+        point.y > cache.min.y && point.z > cache.min.z &&
+        point.x < cache.max.x && point.y < cache.max.y &&
+        point.z < cache.max.z) {
+        return cache.zone;
+    }
+    return find(point, &cache);
+}
+
+ZoneData* ZoneIndex::find(const glm::vec3& point, Cache* cache) const {
+    if (cache) {
+        cache->generation = 0;
+    }
+
+    // Nothing indexed, there are no cells to look in
+    if (nodes_.empty()) {
+        return nullptr;
+    }
+
+    const auto cell = cellAt(point);
+    if (cell < 0) {
+        return nullptr;
+    }
+
+    // The result only changes when the point crosses the edge of a zone
+    // that was tested, shrink the box to the side of each edge it is on.
+    const auto inf = std::numeric_limits<float>::infinity();
+    const auto cx = cell % kCellsPerAxis;
+    const auto cy = cell / kCellsPerAxis;
+    glm::vec3 min(origin_.x + cellSize_.x * cx, origin_.y + cellSize_.y * cy,
+                  -inf);
+    glm::vec3 max(min.x + cellSize_.x, min.y + cellSize_.y, inf);
+
+    // Nodes are in depth first order: descend into the first child that
+    // contains the point, like ZoneData::findLeafAtPoint.
+    int32_t current = -1;
+    uint32_t end = static_cast<uint32_t>(nodes_.size());
+    for (auto i = cellStart_[cell]; i < cellStart_[cell + 1]; ++i) {
+        const auto n = cellNodes_[i];
+        if (n >= end) {
+            break;
+        }
+        const auto& node = nodes_[n];
+        if (node.parent != current) {
+            continue;
+        }
+
+        const auto& zone = *node.zone;
+        if (zone.containsPoint(point)) {
+            current = static_cast<int32_t>(n);
+            end = node.end;
+            for (int a = 0; a < 3; ++a) {
+                min[a] = std::max(min[a], zone.min[a]);
+                max[a] = std::min(max[a], zone.max[a]);
+            }
+        } else {
+            for (int a = 0; a < 3; ++a) {
+                if (point[a] < zone.min[a]) {
+                    max[a] = std::min(max[a], zone.min[a]);
+                    break;
+                }
+                if (point[a] > zone.max[a]) {
+                    min[a] = std::max(min[a], zone.max[a]);
+                    break;
+                }
+            }
+        }
+    }
+
+    ZoneData* result = current < 0 ? nullptr : nodes_[current].zone;
+    if (cache) {
+        cache->generation = generation_;
+        cache->zone = result;
+        cache->min = min;
+        cache->max = max;
+    }
+    return result;
+}
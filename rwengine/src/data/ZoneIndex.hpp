@@ -0,0 +1,91 @@
+#ifndef _RWENGINE_ZONEINDEX_HPP_
+#define _RWENGINE_ZONEINDEX_HPP_
+
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+
+#include <cstdint>
+#include <vector>
+
+struct ZoneData;
+
+/**
+ * @brief Grid over a zone hierarchy for point lookups
+ *
+ * Each cell of a grid over the root zone lists the zones that overlap it in
+ * hierarchy order. A lookup only tests the zones near the point, and gives
+ * the same zone as ZoneData::findLeafAtPoint on the root.
+ *
+ * The index points into the zones it was built from, it must be rebuilt
+ * whenever they or their hierarchy change.
+ */
+class ZoneIndex {
+public:
+    static constexpr int kCellsPerAxis = 64;
+
+    /**
+     * The result of a caller's last lookup and the box around it where the
+     * result stays the same. Callers that look up nearby points over and
+     * over, like the camera every tick, should keep one around.
+     */
+    struct Cache {
+        uint32_t generation = 0;
+        ZoneData* zone = nullptr;
+        glm::vec3 min{};
+        glm::vec3 max{};
+    };
+
+    /**
+     * Indexes root and every zone below it
+     */
+    void build(ZoneData& root);
+
+    void clear();
+
+    bool empty() const {
+        return nodes_.empty();
+    }
+
+    /**
+     * @return the deepest zone containing point, or nullptr when the root
+     * doesn't contain it
+     */
+    ZoneData* find(const glm::vec3& point) const;
+
+    /**
+     * @copydoc find(const glm::vec3&) const
+     * Returns the cached zone without a lookup if point is still inside the
+     * cached box.
+     */
+    ZoneData* find(const glm::vec3& point, Cache& cache) const;
+
+private:
+    struct Node {
+        ZoneData* zone;
+        /// Index of the parent node, -1 for the root
+        int32_t parent;
+        /// One past the index of the last node below this one
+        uint32_t end;
+    };
+
+    /// @return the cell containing point, or -1 if it is outside the grid
+    int cellAt(const glm::vec3& point) const;
+
+    ZoneData* find(const glm::vec3& point, Cache* cache) const;
+
+    /// Zones in depth first order, parents come before their children
+    std::vector<Node> nodes_;
+
+    /// Where each cell's nodes begin in cellNodes_, and one past the end
+    std::vector<uint32_t> cellStart_;
+    std::vector<uint32_t> cellNodes_;
+
+    glm::vec2 origin_{};
+    glm::vec2 extent_{};
+    glm::vec2 cellSize_{};
+
+    /// Increased on every build, so old caches are not used
+    uint32_t generation_ = 0;
+};
+
+#endif
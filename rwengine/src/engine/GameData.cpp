@@ -44,6 +44,16 @@ GameData::GameData(Logger* log, const rwfs::path& path)
 void GameData::load() {
     index.indexTree(datpath);
 
+    if (loaderCache.isEnabled()) {
+        rwfs::error_code ec;
+        rwfs::create_directories(loaderCache.getCacheDirectory(), ec);
+        if (ec) {
+            logger->warning("Data", "Disabling data cache, can't create " +
+                                        loaderCache.getCacheDirectory().string());
+            loaderCache = LoaderCache();
+        }
+    }
+
     loadIMG("models/gta3.img");
     /// @todo cuts.img files should be loaded differently to gta3.img
     loadIMG("anim/cuts.img");
@@ -73,6 +83,7 @@ void GameData::load() {
     // Clear existing zones
     gamezones = ZoneDataList{
         {"CITYZON", 0, {-4000.f, -4000.f, -500.f}, {4000.f, 4000.f, 500.f}, 0, 0, 0}};
+    buildZoneHierarchy();
 
     loadLevelFile("data/default.dat");
     loadLevelFile("data/gta3.dat");
@@ -140,7 +151,15 @@ void GameData::loadIDE(const std::string& path) {
     auto systempath = index.findFilePath(path).string();
     LoaderIDE idel;
 
-    if (idel.load(systempath, pedstats)) {
+    bool loaded = loaderCache.loadIDE(systempath, pedstats, idel);
+    if (!loaded) {
+        loaded = idel.load(systempath, pedstats);
+        if (loaded) {
+            loaderCache.storeIDE(systempath, pedstats, idel);
+        }
+    }
+
+    if (loaded) {
         std::move(idel.objects.begin(), idel.objects.end(),
                   std::inserter(modelinfo, modelinfo.end()));
     } else {
@@ -175,7 +194,15 @@ void GameData::loadCOL(const size_t zone, const std::string& name) {
 
     auto systempath = index.findFilePath(name).string();
 
-    if (col.load(systempath)) {
+    bool loaded = loaderCache.loadCOL(systempath, col);
+    if (!loaded) {
+        loaded = col.load(systempath);
+        if (loaded) {
+            loaderCache.storeCOL(systempath, col);
+        }
+    }
+
+    if (loaded) {
         // Associate loaded collisions with models
         for (auto& c : col.collisions) {
             // Find by name
@@ -199,27 +226,50 @@ void GameData::loadIPL(const std::string& path) {
     iplLocations.insert({path, systempath});
 }
 
+bool GameData::parseIPL(const std::string& path, LoaderIPL& ipl) const {
+    if (loaderCache.loadIPL(path, ipl)) {
+        return true;
+    }
+    if (!ipl.load(path)) {
+        return false;
+    }
+    loaderCache.storeIPL(path, ipl);
+    return true;
+}
+
 bool GameData::loadZone(const std::string& path) {
     LoaderIPL ipll;
 
     // Load the zones
-    if (!ipll.load(path)) {
+    if (!parseIPL(path, ipll)) {
         logger->error("Data", "Failed to load zones from " + path);
         return false;
     }
 
     gamezones.insert(gamezones.end(), ipll.zones.begin(), ipll.zones.end());
+    buildZoneHierarchy();
+
+    return true;
+}
+
+void GameData::buildZoneHierarchy() {
+    zoneIndex.clear();
+    if (gamezones.empty()) {
+        return;
+    }
 
-    // Build zone hierarchy
     for (ZoneData& zone : gamezones) {
         zone.children_.clear();
+        zone.parent_ = nullptr;
+    }
+    for (ZoneData& zone : gamezones) {
         if (&zone == &gamezones.front()) {
             continue;
         }
         gamezones[0].insertZone(zone);
     }
 
-    return true;
+    zoneIndex.build(gamezones[0]);
 }
 
 enum ColSection {
@@ -294,7 +344,7 @@ void GameData::loadHandling(const std::string& path) {
 SCMFile GameData::loadSCM(const std::string& path) {
     auto scm_h = index.openFileRaw(path);
     SCMFile scm{};
-    scm.loadFile(scm_h.data.get(), scm_h.length);
+    scm.loadFile(scm_h.data, scm_h.length);
     return scm;
 }
 
@@ -527,7 +577,7 @@ void GameData::loadIFP(const std::string& name, bool cutsceneAnimation) {
     auto f = index.openFile(name);
 
     if (f.data) {
-        if (LoaderIFP loader{}; loader.loadFromMemory(f.data.get())) {
+        if (LoaderIFP loader{}; loader.loadFromMemory(f.data)) {
             auto& dest = cutsceneAnimation ? animationsCutscene : animations;
             dest.insert(loader.animations.begin(), loader.animations.end());
         }
@@ -723,8 +773,12 @@ ZoneData *GameData::findZone(const std::string &name) {
 
 ZoneData *GameData::findZoneAt(const glm::vec3 &pos) {
     RW_CHECK(!gamezones.empty(), "No game zones loaded");
-    ZoneData* zone = gamezones[0].findLeafAtPoint(pos);
-    return zone;
+    return zoneIndex.find(pos);
+}
+
+ZoneData *GameData::findZoneAt(const glm::vec3 &pos, ZoneIndex::Cache &cache) {
+    RW_CHECK(!gamezones.empty(), "No game zones loaded");
+    return zoneIndex.find(pos, cache);
 }
 
 int GameData::getWaterIndexAt(const glm::vec3& ws) const {
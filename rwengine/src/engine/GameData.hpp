@@ -21,13 +21,16 @@
 #include <data/WeaponData.hpp>
 #include <data/Weather.hpp>
 #include <data/ZoneData.hpp>
+#include <data/ZoneIndex.hpp>
 #include <fonts/GameTexts.hpp>
 #include <loaders/LoaderDFF.hpp>
+#include <loaders/LoaderCache.hpp>
 #include <loaders/LoaderIMG.hpp>
 #include <loaders/LoaderTXD.hpp>
 #include <objects/VehicleInfo.hpp>
 
 class Logger;
+class LoaderIPL;
 struct WeaponData;
 class GameWorld;
 class TextureAtlas;
@@ -91,6 +94,12 @@ public:
 
     void loadIPL(const std::string& path);
 
+    /**
+     * Parses an IPL file, using the loader cache when it is valid
+     * @param path Path to the IPL file on disk
+     */
+    bool parseIPL(const std::string& path, LoaderIPL& ipl) const;
+
     /**
      * Loads the Zones from a zon/IPL file
      */
@@ -195,6 +204,11 @@ public:
 
     FileIndex index;
 
+    /**
+     * Binary cache for parsed IDE, IPL and COL files, disabled by default
+     */
+    LoaderCache loaderCache;
+
     /**
      * Files that have been loaded previously
      */
@@ -214,10 +228,27 @@ public:
 
     ZoneDataList mapzones;
 
+    /**
+     * Lookup grid over gamezones, used by findZoneAt
+     */
+    ZoneIndex zoneIndex;
+
+    /**
+     * Rebuilds the zone hierarchy under the first zone, and the zone index.
+     * Call after changing gamezones.
+     */
+    void buildZoneHierarchy();
+
     ZoneData* findZone(const std::string& name);
 
     ZoneData* findZoneAt(const glm::vec3& pos);
 
+    /**
+     * Looks up the zone at pos, reusing the caller's last result while pos
+     * stays in the area it is valid for.
+     */
+    ZoneData* findZoneAt(const glm::vec3& pos, ZoneIndex::Cache& cache);
+
     std::unordered_map<ModelID, std::unique_ptr<BaseModelInfo>> modelinfo;
 
     uint16_t findModelObject(const std::string model);
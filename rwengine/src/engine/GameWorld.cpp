@@ -9,6 +9,12 @@
 #pragma warning(default : 4305)
 #endif
 
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <initializer_list>
+#include <stdexcept>
+
 #include <glm/gtx/norm.hpp>
 
 #include <data/Clump.hpp>
@@ -19,12 +25,15 @@
 #include "engine/GameData.hpp"
 #include "engine/GameState.hpp"
 #include "engine/Payphone.hpp"
+#include "engine/WorldCheckpoint.hpp"
 
 #include "ai/AIGraphNode.hpp"
 #include "ai/DefaultAIController.hpp"
 #include "ai/PlayerController.hpp"
 #include "ai/TrafficDirector.hpp"
 
+#include "audio/SoundSource.hpp"
+
 #include "dynamics/HitTest.hpp"
 
 #include "data/CutsceneData.hpp"
@@ -53,6 +62,8 @@
 // Behaviour Tuning
 constexpr float kMaxTrafficSpawnRadius = 100.f;
 constexpr float kMaxTrafficCleanupRadius = kMaxTrafficSpawnRadius * 1.25f;
+// Traffic objects of each type checked for cleanup per tick
+constexpr size_t kTrafficCleanupBudget = 8;
 
 namespace {
 template <typename T>
@@ -113,7 +124,7 @@ GameWorld::~GameWorld() {
 bool GameWorld::placeItems(const std::string& name) {
     LoaderIPL ipll;
 
-    if (ipll.load(name)) {
+    if (data->parseIPL(name, ipll)) {
         // Find the object.
         for (const auto& inst : ipll.m_instances) {
             if (!createInstance(inst->id, inst->pos, inst->rot)) {
@@ -162,8 +173,7 @@ InstanceObject* GameWorld::createInstance(const uint16_t id,
 
         auto ptr = instance.get();
 
-        instancePool.insert(std::move(instance));
-        allObjects.push_back(ptr);
+        insertObject(std::move(instance));
 
         modelInstances.emplace(oi->name, ptr);
 
@@ -174,38 +184,12 @@ InstanceObject* GameWorld::createInstance(const uint16_t id,
 }
 
 void GameWorld::createTraffic(const ViewCamera& viewCamera) {
-    ai::TrafficDirector director(&aigraph, this);
-
-    director.populateNearby(viewCamera, kMaxTrafficSpawnRadius, 5);
+    trafficDirector.populateNearby(viewCamera, kMaxTrafficSpawnRadius, 5);
 }
 
 void GameWorld::cleanupTraffic(const ViewCamera& focus) {
-    for (auto& p : pedestrianPool.objects) {
-        if (p.second->getLifetime() != GameObject::TrafficLifetime) {
-            continue;
-        }
-
-        if (glm::distance(focus.position, p.second->getPosition()) >=
-            kMaxTrafficCleanupRadius) {
-            if (!focus.frustum.intersects(p.second->getPosition(), 1.f)) {
-                destroyObjectQueued(p.second.get());
-            }
-        }
-    }
-    for (auto& p : vehiclePool.objects) {
-        if (p.second->getLifetime() != GameObject::TrafficLifetime) {
-            continue;
-        }
-
-        if (glm::distance(focus.position, p.second->getPosition()) >=
-            kMaxTrafficCleanupRadius) {
-            if (!focus.frustum.intersects(p.second->getPosition(), 1.f)) {
-                destroyObjectQueued(p.second.get());
-            }
-        }
-    }
-
-    destroyQueuedObjects();
+    trafficDirector.cleanupTraffic(focus, kMaxTrafficCleanupRadius,
+                                   kTrafficCleanupBudget);
 }
 
 CutsceneObject* GameWorld::createCutsceneObject(const uint16_t id,
@@ -234,8 +218,7 @@ CutsceneObject* GameWorld::createCutsceneObject(const uint16_t id,
     auto instance = std::make_unique<CutsceneObject>(this, pos, rot, model, modelinfo);
     auto ptr = instance.get();
 
-    cutscenePool.insert(std::move(instance));
-    allObjects.push_back(ptr);
+    insertObject(std::move(instance));
 
     return ptr;
 }
@@ -318,8 +301,7 @@ VehicleObject* GameWorld::createVehicle(const uint16_t id, const glm::vec3& pos,
     auto ptr = vehicle.get();
     vehicle->setGameObjectID(gid);
 
-    vehiclePool.insert(std::move(vehicle));
-    allObjects.push_back(ptr);
+    insertObject(std::move(vehicle));
 
     return ptr;
 }
@@ -342,8 +324,7 @@ CharacterObject* GameWorld::createPedestrian(const uint16_t id,
     auto ped = std::make_unique<CharacterObject>(this, pos, rot, pt, controller);
     auto ptr = ped.get();
     ped->setGameObjectID(gid);
-    pedestrianPool.insert(std::move(ped));
-    allObjects.push_back(ptr);
+    insertObject(std::move(ped));
     return ptr;
 }
 
@@ -372,8 +353,7 @@ CharacterObject* GameWorld::createPlayer(const glm::vec3& pos,
     ped->setGameObjectID(gid);
     ped->setLifetime(GameObject::PlayerLifetime);
     players.push_back(controller);
-    pedestrianPool.insert(std::move(ped));
-    allObjects.push_back(ptr);
+    insertObject(std::move(ped));
     return ptr;
 }
 
@@ -424,8 +404,7 @@ PickupObject* GameWorld::createPickup(const glm::vec3& pos, int id, int type) {
 
     auto ptr = pickup.get();
 
-    pickupPool.insert(std::move(pickup));
-    allObjects.push_back(ptr);
+    insertObject(std::move(pickup));
 
     return ptr;
 }
@@ -509,7 +488,79 @@ GameObject* GameWorld::getBlipTarget(const BlipData& blip) const {
     }
 }
 
+std::vector<GameObject*> GameWorld::findObjectsInRadius(
+    const glm::vec3& center, float radius) const {
+    std::vector<GameObject*> found;
+    transforms.findInRadius(center, radius, found);
+    dynamicTransforms.findInRadius(center, radius, found);
+    return found;
+}
+
+std::vector<GameObject*> GameWorld::findDynamicObjectsInRadius(
+    const glm::vec3& center, float radius) const {
+    std::vector<GameObject*> found;
+    dynamicTransforms.findInRadius(center, radius, found);
+    return found;
+}
+
+void GameWorld::insertObject(std::unique_ptr<GameObject> object) {
+    auto ptr = object.get();
+    getTypeObjectPool(ptr).insert(std::move(object));
+    allObjects.push_back(ptr);
+
+    if (auto modelinfo = ptr->getModelInfo<BaseModelInfo>()) {
+        modelObjects[modelinfo->id()].push_back(ptr);
+    }
+}
+
+const std::vector<GameObject*>& GameWorld::getModelObjects(
+    uint16_t model) const {
+    static const std::vector<GameObject*> kNone;
+    auto it = modelObjects.find(model);
+    return it == modelObjects.end() ? kNone : it->second;
+}
+
+bool GameWorld::removeModelObject(GameObject* object, uint16_t model) {
+    auto it = modelObjects.find(model);
+    if (it == modelObjects.end()) {
+        return false;
+    }
+    auto& objects = it->second;
+    auto found = std::find(objects.begin(), objects.end(), object);
+    if (found == objects.end()) {
+        return false;
+    }
+    *found = objects.back();
+    objects.pop_back();
+    if (objects.empty()) {
+        modelObjects.erase(it);
+    }
+    return true;
+}
+
+void GameWorld::updateModelObject(GameObject* object, uint16_t previous) {
+    // Objects that aren't in the world yet are added by insertObject
+    auto modelinfo = object->getModelInfo<BaseModelInfo>();
+    if (removeModelObject(object, previous) && modelinfo) {
+        modelObjects[modelinfo->id()].push_back(object);
+    }
+}
+
 void GameWorld::destroyObject(GameObject* object) {
+    if (auto modelinfo = object->getModelInfo<BaseModelInfo>()) {
+        removeModelObject(object, modelinfo->id());
+    }
+
+    // Don't leave the model's instance lookup pointing at the object
+    if (object->type() == GameObject::Instance) {
+        const auto& name = object->getModelInfo<BaseModelInfo>()->name;
+        auto instance = modelInstances.find(name);
+        if (instance != modelInstances.end() && instance->second == object) {
+            modelInstances.erase(instance);
+        }
+    }
+
+    // The pool owns the object, it's deleted here
     auto& pool = getTypeObjectPool(object);
     pool.remove(object);
 
@@ -526,6 +577,271 @@ void GameWorld::destroyObject(GameObject* object) {
     }
 }
 
+namespace {
+/// Records are made from the pools' maps, so they're sorted by ID
+template <class Record>
+const Record* findRecord(const std::vector<Record>& records,
+                         GameObjectID id) {
+    auto it = std::lower_bound(
+        records.begin(), records.end(), id,
+        [](const Record& record, GameObjectID id) { return record.id < id; });
+    return (it != records.end() && it->id == id) ? &*it : nullptr;
+}
+
+void fillRecord(WorldCheckpoint::Object& record, const GameObject& object) {
+    record.id = object.getGameObjectID();
+    record.modelId =
+        static_cast<uint16_t>(object.getModelInfo<BaseModelInfo>()->id());
+    record.position = object.getPosition();
+    record.rotation = object.getRotation();
+    record.lifetime = object.getLifetime();
+}
+
+bool matchesRecord(const WorldCheckpoint::Object* record,
+                   const GameObject& object) {
+    return record != nullptr &&
+           record->modelId == object.getModelInfo<BaseModelInfo>()->id();
+}
+
+/// Gives an object the ID it had when the checkpoint was created
+void setPoolID(GameWorld::ObjectPool& pool, GameObject* object,
+               GameObjectID id) {
+    auto it = pool.objects.find(object->getGameObjectID());
+    auto owned = std::move(it->second);
+    pool.objects.erase(it);
+    owned->setGameObjectID(id);
+    pool.objects[id] = std::move(owned);
+}
+}  // namespace
+
+WorldCheckpoint GameWorld::createCheckpoint() const {
+    WorldCheckpoint checkpoint;
+
+    for (const auto& [id, object] : vehiclePool.objects) {
+        auto vehicle = static_cast<VehicleObject*>(object.get());
+        WorldCheckpoint::Vehicle record;
+        fillRecord(record, *vehicle);
+        record.health = vehicle->getHealth();
+        record.colourPrimary = vehicle->colourPrimary;
+        record.colourSecondary = vehicle->colourSecondary;
+        checkpoint.vehicles.push_back(record);
+    }
+
+    for (const auto& [id, object] : pedestrianPool.objects) {
+        auto character = static_cast<CharacterObject*>(object.get());
+        WorldCheckpoint::Character record;
+        fillRecord(record, *character);
+        record.state = character->getCurrentState();
+        auto vehicle = character->getCurrentVehicle();
+        record.vehicle = vehicle ? vehicle->getGameObjectID() : 0;
+        record.seat = character->getCurrentSeat();
+        checkpoint.characters.push_back(record);
+    }
+
+    for (const auto& [id, object] : pickupPool.objects) {
+        auto pickup = static_cast<PickupObject*>(object.get());
+        WorldCheckpoint::Pickup record;
+        fillRecord(record, *pickup);
+        record.type = pickup->getPickupType();
+        record.enabled = pickup->isEnabled();
+        checkpoint.pickups.push_back(record);
+    }
+
+    for (const auto& [id, object] : instancePool.objects) {
+        if (object->getLifetime() != GameObject::MissionLifetime) {
+            continue;
+        }
+        WorldCheckpoint::Object record;
+        fillRecord(record, *object);
+        checkpoint.instances.push_back(record);
+    }
+
+    if (state) {
+        checkpoint.state = *state;
+        for (auto object : state->missionObjects) {
+            checkpoint.missionObjects.emplace_back(object->type(),
+                                                   object->getGameObjectID());
+        }
+        if (state->script) {
+            checkpoint.globals = state->script->getGlobalData();
+            checkpoint.threads = state->script->getThreads();
+        }
+    }
+
+    return checkpoint;
+}
+
+void GameWorld::restoreCheckpoint(const WorldCheckpoint& checkpoint) {
+    destroyQueuedObjects();
+
+    // Everyone leaves their vehicle, they're seated again at the end
+    for (const auto& [id, object] : pedestrianPool.objects) {
+        auto character = static_cast<CharacterObject*>(object.get());
+        if (character->getCurrentVehicle()) {
+            character->enterVehicle(nullptr, character->getCurrentSeat());
+        }
+    }
+
+    // Destroy objects created since the checkpoint, or reused for another
+    // model. The player is kept, as their controller is owned by the world.
+    std::vector<GameObject*> destroyed;
+    for (const auto& [id, object] : vehiclePool.objects) {
+        if (!matchesRecord(findRecord(checkpoint.vehicles, id), *object)) {
+            destroyed.push_back(object.get());
+        }
+    }
+    for (const auto& [id, object] : pedestrianPool.objects) {
+        if (!matchesRecord(findRecord(checkpoint.characters, id), *object) &&
+            object->getLifetime() != GameObject::PlayerLifetime) {
+            destroyed.push_back(object.get());
+        }
+    }
+    for (const auto& [id, object] : pickupPool.objects) {
+        auto record = findRecord(checkpoint.pickups, id);
+        if (!matchesRecord(record, *object) ||
+            record->type !=
+                static_cast<PickupObject*>(object.get())->getPickupType()) {
+            destroyed.push_back(object.get());
+        }
+    }
+    for (const auto& [id, object] : instancePool.objects) {
+        if (object->getLifetime() == GameObject::MissionLifetime &&
+            !matchesRecord(findRecord(checkpoint.instances, id), *object)) {
+            destroyed.push_back(object.get());
+        }
+    }
+    for (auto object : destroyed) {
+        destroyObject(object);
+    }
+
+    for (const auto& record : checkpoint.vehicles) {
+        auto vehicle = static_cast<VehicleObject*>(vehiclePool.find(record.id));
+        if (vehicle) {
+            vehicle->setPosition(record.position);
+            vehicle->setRotation(record.rotation);
+            if (auto body = vehicle->collision->getBulletBody()) {
+                body->setLinearVelocity(btVector3(0.f, 0.f, 0.f));
+                body->setAngularVelocity(btVector3(0.f, 0.f, 0.f));
+            }
+        } else {
+            vehicle = createVehicle(record.modelId, record.position,
+                                    record.rotation, record.id);
+            if (!vehicle) {
+                continue;
+            }
+        }
+        vehicle->setHealth(record.health);
+        vehicle->colourPrimary = record.colourPrimary;
+        vehicle->colourSecondary = record.colourSecondary;
+        vehicle->setLifetime(record.lifetime);
+    }
+
+    for (const auto& record : checkpoint.characters) {
+        auto character =
+            static_cast<CharacterObject*>(pedestrianPool.find(record.id));
+        if (character) {
+            character->setPosition(record.position);
+            character->setRotation(record.rotation);
+        } else if (record.lifetime == GameObject::PlayerLifetime) {
+            character =
+                createPlayer(record.position, record.rotation, record.id);
+        } else {
+            character = createPedestrian(record.modelId, record.position,
+                                         record.rotation, record.id);
+        }
+        if (!character) {
+            continue;
+        }
+        character->getCurrentState() = record.state;
+        character->setLifetime(record.lifetime);
+    }
+
+    for (const auto& record : checkpoint.pickups) {
+        auto pickup = static_cast<PickupObject*>(pickupPool.find(record.id));
+        if (!pickup) {
+            pickup = createPickup(record.position, record.modelId, record.type);
+            if (!pickup) {
+                continue;
+            }
+            setPoolID(pickupPool, pickup, record.id);
+        }
+        pickup->setEnabled(record.enabled);
+        pickup->setLifetime(record.lifetime);
+    }
+
+    for (const auto& record : checkpoint.instances) {
+        auto instance = instancePool.find(record.id);
+        if (instance) {
+            instance->setPosition(record.position);
+            instance->setRotation(record.rotation);
+        } else {
+            instance = createInstance(record.modelId, record.position,
+                                      record.rotation);
+            if (!instance) {
+                continue;
+            }
+            setPoolID(instancePool, instance, record.id);
+        }
+        instance->setLifetime(record.lifetime);
+    }
+
+    for (const auto& record : checkpoint.characters) {
+        if (record.vehicle == 0) {
+            continue;
+        }
+        auto character =
+            static_cast<CharacterObject*>(pedestrianPool.find(record.id));
+        auto vehicle =
+            static_cast<VehicleObject*>(vehiclePool.find(record.vehicle));
+        if (character && vehicle) {
+            character->enterVehicle(vehicle, record.seat);
+        }
+    }
+
+    if (state) {
+        // Input and the links to the world and script aren't part of the
+        // checkpoint
+        GameInputState input[2] = {state->input[0], state->input[1]};
+        auto script = state->script;
+
+        *state = checkpoint.state;
+        state->world = this;
+        state->script = script;
+        state->input[0] = input[0];
+        state->input[1] = input[1];
+
+        state->missionObjects.clear();
+        for (const auto& [type, id] : checkpoint.missionObjects) {
+            GameObject* object = nullptr;
+            switch (type) {
+                case GameObject::Vehicle:
+                    object = vehiclePool.find(id);
+                    break;
+                case GameObject::Character:
+                    object = pedestrianPool.find(id);
+                    break;
+                case GameObject::Pickup:
+                    object = pickupPool.find(id);
+                    break;
+                case GameObject::Instance:
+                    object = instancePool.find(id);
+                    break;
+                default:
+                    break;
+            }
+            if (object) {
+                state->missionObjects.push_back(object);
+            }
+        }
+
+        // Sizes match, so pointers into the globals stay valid
+        if (script) {
+            script->getGlobalData() = checkpoint.globals;
+            script->getThreads() = checkpoint.threads;
+        }
+    }
+}
+
 void GameWorld::destroyObjectQueued(GameObject* object) {
     RW_CHECK(object != nullptr, "destroying a null object?");
     if (object) deletionQueue.insert(object);
@@ -769,32 +1085,130 @@ void GameWorld::PhysicsTickCallback(btDynamicsWorld* physWorld,
     }
 }
 
+struct GameWorld::CutsceneLoad {
+    struct Data {
+        CutsceneTracks tracks;
+        AnimationSet animations;
+    };
+
+    std::string name;
+    /// Name of the audio file, empty if the cutscene has none
+    std::string audioName;
+    std::future<Data> data;
+    std::future<std::shared_ptr<SoundSource>> audio;
+};
+
 void GameWorld::loadCutscene(const std::string& name) {
-    auto datfile = data->index.openFile(name + ".dat");
+    preloadCutscene(name);
+    finishCutsceneLoad();
+}
+
+void GameWorld::preloadCutscene(const std::string& name) {
+    cutsceneLoad.reset();
 
     state->currentCutscene = CutsceneData();
+    state->currentCutscene->meta.name = name;
+
+    auto load = std::make_unique<CutsceneLoad>();
+    load->name = name;
+
+    // The index caches archives as they are opened, so the files are opened
+    // here and only parsed by the worker
+    load->data = std::async(
+        std::launch::async,
+        [datfile = data->index.openFile(name + ".dat"),
+         ifpfile = data->index.openFile(name + ".ifp")]() {
+            CutsceneLoad::Data loaded;
+            if (datfile.data) {
+                LoaderCutsceneDAT loaderdat;
+                loaderdat.load(loaded.tracks, datfile);
+            }
+            if (ifpfile.data) {
+                if (LoaderIFP loader{}; loader.loadFromMemory(ifpfile.data)) {
+                    loaded.animations = std::move(loader.animations);
+                }
+            }
+            return loaded;
+        });
+
+    for (const char* extension : {".mp3", ".wav"}) {
+        rwfs::path path;
+        try {
+            path = data->index.findFilePath("audio/" + name + extension);
+        } catch (const std::out_of_range&) {
+            continue;
+        }
 
-    if (datfile.data) {
-        LoaderCutsceneDAT loaderdat;
-        loaderdat.load(state->currentCutscene->tracks, datfile);
+        load->audioName = name + extension;
+        load->audio = std::async(std::launch::async, [path]() {
+            auto source = std::make_shared<SoundSource>();
+            source->loadFromFile(path);
+            return source;
+        });
+        break;
     }
 
-    data->loadIFP(name + ".ifp", true);
-    cutsceneAudioLoaded = data->loadAudioStream(name + ".mp3");
+    cutsceneLoad = std::move(load);
+}
 
-    if (!cutsceneAudioLoaded) {
-        cutsceneAudioLoaded = data->loadAudioStream(name + ".wav");
+bool GameWorld::isCutsceneReady() const {
+    if (!cutsceneLoad) {
+        return true;
+    }
+
+    const auto ready = [](const auto& future) {
+        return !future.valid() || future.wait_for(std::chrono::seconds(0)) ==
+                                      std::future_status::ready;
+    };
+    return ready(cutsceneLoad->data) && ready(cutsceneLoad->audio);
+}
+
+void GameWorld::finishCutsceneData() {
+    if (!cutsceneLoad || !cutsceneLoad->data.valid()) {
+        return;
+    }
+
+    auto loaded = cutsceneLoad->data.get();
+    auto& cutscene = state->currentCutscene;
+    if (cutscene && cutscene->meta.name == cutsceneLoad->name) {
+        cutscene->tracks = std::move(loaded.tracks);
+    }
+    data->animationsCutscene.insert(loaded.animations.begin(),
+                                    loaded.animations.end());
+}
+
+void GameWorld::finishCutsceneLoad() {
+    if (!cutsceneLoad) {
+        return;
+    }
+
+    finishCutsceneData();
+
+    auto load = std::move(cutsceneLoad);
+    cutsceneAudioLoaded = false;
+    if (load->audio.valid()) {
+        if (cutsceneAudio.length() > 0) {
+            sound.stopMusic(cutsceneAudio);
+        }
+
+        cutsceneAudioLoaded =
+            sound.loadMusic(load->audioName, load->audio.get());
+        if (cutsceneAudioLoaded) {
+            cutsceneAudio = load->audioName;
+        }
     }
 
     if (!cutsceneAudioLoaded) {
-        logger->warning("Data", "Failed to load cutscene audio: " + name);
+        logger->warning("Data",
+                        "Failed to load cutscene audio: " + load->name);
     }
 
-    state->currentCutscene->meta.name = name;
-    logger->info("World", "Loaded cutscene: " + name);
+    logger->info("World", "Loaded cutscene: " + load->name);
 }
 
 void GameWorld::startCutscene() {
+    finishCutsceneLoad();
+
     state->cutsceneStartTime = getGameTime();
     state->skipCutscene = false;
 
@@ -805,6 +1219,7 @@ void GameWorld::startCutscene() {
 }
 
 void GameWorld::clearCutscene() {
+    cutsceneLoad.reset();
     eraseCutsceneObjects();
     eraseCutsceneSound();
     eraseCutsceneAnimations();
@@ -934,15 +1349,7 @@ void GameWorld::updateEffects() {
 }
 
 VehicleObject* GameWorld::tryToSpawnVehicle(VehicleGenerator& gen) {
-    constexpr float kMinClearRadius = 10.f;
-
-    if (gen.remainingSpawns <= 0) {
-        return nullptr;
-    }
-
-    /// @todo take into account maxDelay as well
-    if (gen.lastSpawnTime + gen.minDelay >
-        static_cast<int>(state->basic.timeMS)) {
+    if (!gen.isReady(static_cast<int>(state->basic.timeMS))) {
         return nullptr;
     }
 
@@ -952,6 +1359,20 @@ VehicleObject* GameWorld::tryToSpawnVehicle(VehicleGenerator& gen) {
         position = getGroundAtPosition(position);
     }
 
+    return tryToSpawnVehicle(gen, position);
+}
+
+VehicleObject* GameWorld::tryToSpawnVehicle(VehicleGenerator& gen,
+                                            const glm::vec3& groundPosition) {
+    constexpr float kMinClearRadius = 10.f;
+
+    /// @todo take into account maxDelay as well
+    if (!gen.isReady(static_cast<int>(state->basic.timeMS))) {
+        return nullptr;
+    }
+
+    auto position = groundPosition;
+
     // Ensure there's no existing vehicles near our spawn point
     for (auto& v : vehiclePool.objects) {
         if (glm::distance2(position, v.second->getPosition()) <
@@ -1006,50 +1427,32 @@ bool GameWorld::isRaining() const {
 void GameWorld::clearObjectsWithinArea(const glm::vec3 center,
                                        const float radius,
                                        const bool clearParticles) {
-    bool skipFlag = false;
-
-    // Vehicles
-    for (auto& obj : vehiclePool.objects) {
-        skipFlag = false;
+    const auto isImportant = [](const GameObject* object) {
+        // The player, owned by player or owned by mission
+        return object->getLifetime() == GameObject::PlayerLifetime ||
+               object->getLifetime() == GameObject::MissionLifetime;
+    };
 
-        // Skip if it's the player or owned by player or owned by mission
-        if (obj.second->getLifetime() == GameObject::PlayerLifetime ||
-            obj.second->getLifetime() == GameObject::MissionLifetime) {
+    // Only characters and vehicles
+    for (auto object : findDynamicObjectsInRadius(center, radius)) {
+        if (glm::distance(center, object->getPosition()) >= radius ||
+            isImportant(object)) {
             continue;
         }
 
-        // Check if we have any important objects in a vehicle, if we do - don't
-        // erase it
-        for (auto& seat :
-             static_cast<VehicleObject*>(obj.second.get())->seatOccupants) {
-            auto character = static_cast<CharacterObject*>(seat.second);
-
-            if (character->getLifetime() == GameObject::PlayerLifetime ||
-                character->getLifetime() == GameObject::MissionLifetime) {
-                skipFlag = true;
+        // Check if we have any important objects in a vehicle, if we do -
+        // don't erase it
+        if (object->type() == GameObject::Vehicle) {
+            const auto& seats =
+                static_cast<VehicleObject*>(object)->seatOccupants;
+            if (std::any_of(seats.begin(), seats.end(), [&](const auto& seat) {
+                    return isImportant(seat.second);
+                })) {
+                continue;
             }
         }
 
-        if (skipFlag) {
-            continue;
-        }
-
-        if (glm::distance(center, obj.second->getPosition()) < radius) {
-            destroyObjectQueued(obj.second.get());
-        }
-    }
-
-    // Peds
-    for (auto& obj : pedestrianPool.objects) {
-        // Skip if it's the player or owned by player or owned by mission
-        if (obj.second->getLifetime() == GameObject::PlayerLifetime ||
-            obj.second->getLifetime() == GameObject::MissionLifetime) {
-            continue;
-        }
-
-        if (glm::distance(center, obj.second->getPosition()) < radius) {
-            destroyObjectQueued(obj.second.get());
-        }
+        destroyObjectQueued(object);
     }
 
     /// @todo Do we also have to clear all projectiles + particles *in this
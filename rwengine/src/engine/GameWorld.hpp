@@ -7,6 +7,7 @@
 #include <random>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #ifdef _MSC_VER
@@ -18,10 +19,12 @@
 #endif
 
 #include <ai/AIGraph.hpp>
+#include <ai/TrafficDirector.hpp>
 #include <audio/SoundManager.hpp>
 #include <data/Chase.hpp>
 #include <engine/Garage.hpp>
 #include <objects/ObjectTypes.hpp>
+#include <objects/TransformStore.hpp>
 
 class btCollisionDispatcher;
 class btDefaultCollisionConfiguration;
@@ -55,6 +58,7 @@ class ViewCamera;
 
 struct BlipData;
 struct WeaponScan;
+struct WorldCheckpoint;
 struct VehicleGenerator;
 
 struct LightFX;
@@ -106,6 +110,9 @@ public:
      * @brief cleanupTraffic Cleans up traffic too far away from the given
      * camera
      * @param viewCamera
+     *
+     * Only a few objects are checked per call, so it takes a couple of ticks
+     * for traffic to be removed.
      */
     void cleanupTraffic(const ViewCamera& viewCamera);
 
@@ -164,6 +171,11 @@ public:
      */
     Payphone* createPayphone(const glm::vec2 coord);
 
+    /**
+     * Adds a new object to its pool, allObjects and the model index
+     */
+    void insertObject(std::unique_ptr<GameObject> object);
+
     /**
      * Destroys an existing Object
      */
@@ -179,6 +191,21 @@ public:
      */
     void destroyQueuedObjects();
 
+    /**
+     * Captures the dynamic objects, game state and script state so that they
+     * can be put back with restoreCheckpoint, e.g. to retry a mission
+     */
+    WorldCheckpoint createCheckpoint() const;
+
+    /**
+     * Returns the world to a checkpoint
+     *
+     * Objects that still match the checkpoint are moved back into place,
+     * only objects that are missing or were added since are recreated or
+     * destroyed. Static instances and their collision are left alone.
+     */
+    void restoreCheckpoint(const WorldCheckpoint& checkpoint);
+
     /**
      * Performs a weapon scan against things in the world
      */
@@ -276,6 +303,19 @@ public:
         void clear();
     };
 
+    /**
+     * Positions and rotations of game objects other than characters and
+     * vehicles, declared before the pools so it outlives them
+     */
+    TransformStore transforms;
+
+    /**
+     * Positions and rotations of characters and vehicles. They are kept
+     * apart from the static map objects so traffic and area queries only
+     * scan the objects that move.
+     */
+    TransformStore dynamicTransforms;
+
     /**
      * Stores all game objects
      */
@@ -290,6 +330,19 @@ public:
 
     ObjectPool& getTypeObjectPool(GameObject* object);
 
+    /**
+     * @return the objects at most radius from center, in no particular order
+     */
+    std::vector<GameObject*> findObjectsInRadius(const glm::vec3& center,
+                                                 float radius) const;
+
+    /**
+     * @return the characters and vehicles at most radius from center, in no
+     * particular order
+     */
+    std::vector<GameObject*> findDynamicObjectsInRadius(
+        const glm::vec3& center, float radius) const;
+
     std::vector<ai::PlayerController*> players;
 
     std::vector<std::unique_ptr<Garage>> garages;
@@ -308,11 +361,27 @@ public:
      */
     std::map<std::string, InstanceObject*> modelInstances;
 
+    /**
+     * @return the objects in the world that use a model, in no particular
+     * order
+     */
+    const std::vector<GameObject*>& getModelObjects(uint16_t model) const;
+
+    /**
+     * Moves an object that changed model to its new model's objects
+     */
+    void updateModelObject(GameObject* object, uint16_t previous);
+
     /**
      * AI Graph
      */
     ai::AIGraph aigraph;
 
+    /**
+     * Spawns and cleans up traffic around the camera
+     */
+    ai::TrafficDirector trafficDirector{&aigraph, this};
+
     /**
      * Visual Effects
      * @todo Consider using lighter handing mechanism
@@ -348,6 +417,34 @@ public:
      * @param name
      */
     void loadCutscene(const std::string& name);
+
+    /**
+     * @brief Starts loading the named cutscene in the background.
+     *
+     * The files are read here, parsing the tracks and animations and
+     * decoding the audio happen on worker threads. The cutscene becomes
+     * current immediately, its data is filled in by finishCutsceneLoad.
+     */
+    void preloadCutscene(const std::string& name);
+
+    /**
+     * @return true if nothing is preloading, or the preloaded cutscene can
+     * be finished without waiting
+     */
+    bool isCutsceneReady() const;
+
+    /**
+     * @brief Waits for the tracks and animations of a preloaded cutscene
+     * and installs them, the audio is left decoding.
+     */
+    void finishCutsceneData();
+
+    /**
+     * @brief Waits for a preloaded cutscene and installs its data and audio,
+     * does nothing if there isn't one pending.
+     */
+    void finishCutsceneLoad();
+
     void startCutscene();
     void clearCutscene();
     bool isCutsceneDone();
@@ -394,11 +491,25 @@ public:
      */
     VehicleObject* tryToSpawnVehicle(VehicleGenerator& gen);
 
+    /**
+     * Attempt to spawn a vehicle at a vehicle generator, with the generator's
+     * position already moved to the ground
+     */
+    VehicleObject* tryToSpawnVehicle(VehicleGenerator& gen,
+                                     const glm::vec3& groundPosition);
+
     void clearObjectsWithinArea(const glm::vec3 center, const float radius,
                                 const bool clearParticles);
 
     ai::PlayerController* getPlayer();
 
+    /**
+     * Restarts the random numbers from a known seed, for reproducible runs
+     */
+    void seedRandom(uint32_t seed) {
+        randomNumberGen.seed(seed);
+    }
+
     template <
         typename T1, typename T2 = T1,
         typename std::enable_if<std::is_integral<T1>::value>::type* = nullptr,
@@ -425,6 +536,15 @@ private:
      */
     std::set<GameObject*> deletionQueue;
 
+    /// Objects by model ID, for finding the objects of a model
+    std::unordered_map<uint16_t, std::vector<GameObject*>> modelObjects;
+
+    bool removeModelObject(GameObject* object, uint16_t model);
+
+    /// Cutscene being loaded by preloadCutscene
+    struct CutsceneLoad;
+    std::unique_ptr<CutsceneLoad> cutsceneLoad;
+
     std::vector<AreaIndicatorInfo> areaIndicators;
 
     /**
@@ -36,6 +36,10 @@ public:
         return id;
     }
 
+    const glm::vec3& getPosition() const {
+        return position;
+    }
+
     Payphone(GameWorld* engine_, size_t id_, const glm::vec2& coord);
     ~Payphone() = default;
 
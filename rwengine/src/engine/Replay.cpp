@@ -0,0 +1,164 @@
+#include "engine/Replay.hpp"
+
+#include <istream>
+#include <ostream>
+#include <type_traits>
+
+#include <rw/debug.hpp>
+
+#include "engine/GameWorld.hpp"
+#include "objects/GameObject.hpp"
+
+namespace {
+enum RecordTag : uint8_t {
+    kTagFrame = 'F',
+    kTagTick = 'T',
+    kTagChecksum = 'C',
+};
+
+using ControlMask = uint32_t;
+static_assert(GameInputState::_MaxControls <= sizeof(ControlMask) * 8,
+              "Every control needs a bit in the mask");
+
+template <class T>
+void write(std::ostream& out, const T& value) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "Only plain values can be written");
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <class T>
+bool read(std::istream& in, T& value) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "Only plain values can be read");
+    return !!in.read(reinterpret_cast<char*>(&value), sizeof(T));
+}
+
+constexpr uint32_t kFNVOffset = 2166136261u;
+constexpr uint32_t kFNVPrime = 16777619u;
+
+template <class T>
+uint32_t hashBytes(uint32_t hash, const T& value) {
+    const auto* bytes = reinterpret_cast<const unsigned char*>(&value);
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        hash = (hash ^ bytes[i]) * kFNVPrime;
+    }
+    return hash;
+}
+}  // namespace
+
+ReplayWriter::ReplayWriter(std::ostream& out, const ReplayHeader& header)
+    : out_(out) {
+    write(out_, ReplayHeader::kMagic);
+    write(out_, ReplayHeader::kVersion);
+    write(out_, header.seed);
+    write(out_, header.checksumInterval);
+    write(out_, header.start);
+}
+
+void ReplayWriter::writeFrame(const ReplayFrame& frame) {
+    write(out_, kTagFrame);
+    write(out_, frame.frameTime);
+    write(out_, frame.cameraPosition);
+    write(out_, frame.cameraRotation);
+}
+
+void ReplayWriter::writeTick(const ReplayTick& tick) {
+    ControlMask changed = 0;
+    for (int c = 0; c < GameInputState::_MaxControls; ++c) {
+        if (tick.input.levels[c] != lastInput_.levels[c]) {
+            changed |= ControlMask{1} << c;
+        }
+    }
+
+    write(out_, kTagTick);
+    write(out_, changed);
+    for (int c = 0; c < GameInputState::_MaxControls; ++c) {
+        if (changed & (ControlMask{1} << c)) {
+            write(out_, tick.input.levels[c]);
+        }
+    }
+    write(out_, tick.look);
+
+    lastInput_ = tick.input;
+}
+
+void ReplayWriter::writeChecksum(uint32_t checksum) {
+    write(out_, kTagChecksum);
+    write(out_, checksum);
+}
+
+bool ReplayWriter::good() const {
+    return out_.good();
+}
+
+ReplayReader::ReplayReader(std::istream& in) : in_(in) {
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    if (!read(in_, magic) || magic != ReplayHeader::kMagic) {
+        RW_ERROR("Not a replay file");
+        return;
+    }
+    if (!read(in_, version) || version != ReplayHeader::kVersion) {
+        RW_ERROR("Unsupported replay version " << version);
+        return;
+    }
+    valid_ = read(in_, header_.seed) &&
+             read(in_, header_.checksumInterval) &&
+             read(in_, header_.start);
+}
+
+ReplayReader::Record ReplayReader::next() {
+    uint8_t tag = 0;
+    if (!valid_ || !read(in_, tag)) {
+        return Record::End;
+    }
+
+    switch (tag) {
+        case kTagFrame:
+            if (read(in_, frame_.frameTime) &&
+                read(in_, frame_.cameraPosition) &&
+                read(in_, frame_.cameraRotation)) {
+                return Record::Frame;
+            }
+            break;
+        case kTagTick: {
+            ControlMask changed = 0;
+            if (!read(in_, changed)) {
+                break;
+            }
+            bool ok = true;
+            for (int c = 0; c < GameInputState::_MaxControls && ok; ++c) {
+                if (changed & (ControlMask{1} << c)) {
+                    ok = read(in_, tick_.input.levels[c]);
+                }
+            }
+            if (ok && read(in_, tick_.look)) {
+                return Record::Tick;
+            }
+            break;
+        }
+        case kTagChecksum:
+            if (read(in_, checksum_)) {
+                return Record::Checksum;
+            }
+            break;
+        default:
+            RW_ERROR("Unknown replay record " << static_cast<int>(tag));
+            valid_ = false;
+            return Record::End;
+    }
+
+    RW_ERROR("Replay is truncated");
+    valid_ = false;
+    return Record::End;
+}
+
+uint32_t checksumTransforms(const GameWorld& world) {
+    uint32_t hash = kFNVOffset;
+    for (const auto* object : world.allObjects) {
+        hash = hashBytes(hash, object->getPosition());
+        hash = hashBytes(hash, object->getRotation());
+    }
+    return hash;
+}
@@ -0,0 +1,127 @@
+#ifndef _RWENGINE_REPLAY_HPP_
+#define _RWENGINE_REPLAY_HPP_
+
+#include <cstdint>
+#include <iosfwd>
+
+#include <glm/gtc/quaternion.hpp>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+
+#include <engine/GameInputState.hpp>
+
+class GameWorld;
+
+/**
+ * @file Replay.hpp
+ * Binary log of everything that feeds the simulation, so that a session can
+ * be played back tick for tick.
+ *
+ * A log starts with a ReplayHeader, followed by one frame record for each
+ * frame and one tick record for each tick within it. Every checksumInterval
+ * ticks a checksum of the object transforms is stored, which lets playback
+ * notice when it stops matching the recording.
+ *
+ * Tick records only store the controls that changed since the previous
+ * tick, most ticks are a few bytes.
+ */
+
+struct ReplayHeader {
+    static constexpr uint32_t kMagic = 0x50525752;  // "RWRP"
+    static constexpr uint32_t kVersion = 1;
+
+    enum Start : uint8_t {
+        NewGame = 0,
+        TestGame = 1,
+    };
+
+    uint32_t seed = 0;
+    uint32_t checksumInterval = 60;
+    Start start = NewGame;
+};
+
+/**
+ * State that is fixed for the duration of a frame
+ */
+struct ReplayFrame {
+    /// Frame time fed into the fixed step accumulator
+    float frameTime = 0.f;
+    /// Camera used for spawning traffic during the frame's ticks
+    glm::vec3 cameraPosition{};
+    glm::quat cameraRotation{1.f, 0.f, 0.f, 0.f};
+};
+
+struct ReplayTick {
+    GameInputState input{};
+    /// Player look angles after the state has handled input
+    glm::vec2 look{};
+};
+
+class ReplayWriter {
+public:
+    ReplayWriter(std::ostream& out, const ReplayHeader& header);
+
+    void writeFrame(const ReplayFrame& frame);
+
+    void writeTick(const ReplayTick& tick);
+
+    void writeChecksum(uint32_t checksum);
+
+    bool good() const;
+
+private:
+    std::ostream& out_;
+    GameInputState lastInput_{};
+};
+
+class ReplayReader {
+public:
+    enum class Record { Frame, Tick, Checksum, End };
+
+    /**
+     * Reads the header, isValid() is false if it isn't a replay log
+     */
+    explicit ReplayReader(std::istream& in);
+
+    bool isValid() const {
+        return valid_;
+    }
+
+    const ReplayHeader& getHeader() const {
+        return header_;
+    }
+
+    /**
+     * Reads the next record into the matching member
+     *
+     * @return Record::End at the end of the log or on corrupt data
+     */
+    Record next();
+
+    const ReplayFrame& getFrame() const {
+        return frame_;
+    }
+
+    const ReplayTick& getTick() const {
+        return tick_;
+    }
+
+    uint32_t getChecksum() const {
+        return checksum_;
+    }
+
+private:
+    std::istream& in_;
+    bool valid_ = false;
+    ReplayHeader header_;
+    ReplayFrame frame_;
+    ReplayTick tick_;
+    uint32_t checksum_ = 0;
+};
+
+/**
+ * @return FNV-1a hash of the position and rotation of every object
+ */
+uint32_t checksumTransforms(const GameWorld& world);
+
+#endif
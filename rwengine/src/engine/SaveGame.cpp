@@ -5,7 +5,12 @@
 #include <cstring>
 #include <cstdio>
 
+#include <algorithm>
+#include <future>
 #include <iostream>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
 
 #include <rw/filesystem.hpp>
 
@@ -18,6 +23,7 @@
 #include "engine/GameData.hpp"
 #include "engine/GameState.hpp"
 #include "engine/GameWorld.hpp"
+#include "engine/Payphone.hpp"
 #include "objects/CharacterObject.hpp"
 #include "objects/GameObject.hpp"
 #include "objects/InstanceObject.hpp"
@@ -497,10 +503,726 @@ struct Block19Data {
     std::array<Block19PedType, kNrOfPedTypes> types;
 };
 
-void SaveGame::writeGame(GameState& state, const std::string& file) {
-    RW_UNUSED(state);
-    RW_UNUSED(file);
-    RW_UNIMPLEMENTED("Saving the game is not implemented yet.");
+namespace {
+static_assert(sizeof(Block0ScriptData) == 0x03C8,
+              "Block0ScriptData is not the right size");
+
+/**
+ * Everything written to a save file, copied out of the game state so that it
+ * can be encoded and written away from the game thread.
+ */
+struct SaveGameSnapshot {
+    BasicState basic{};
+
+    std::vector<SCMByte> globals;
+    Block0ScriptData scriptData{};
+    std::vector<Block0RunningScript> scripts;
+
+    std::vector<Block1PlayerPed> players;
+
+    Block2GarageData garageData{};
+    std::vector<StructGarage> garages;
+
+    std::vector<Block3Vehicle> vehicles;
+    std::vector<Block3Boat> boats;
+
+    std::vector<Block4Object> objects;
+
+    Block8Data payphoneData{};
+    std::vector<Block8Payphone> payphones;
+
+    Block9Data restartData{};
+
+    Block11Data zoneData{};
+
+    Block13Data carGeneratorData{};
+    std::vector<Block13CarGenerator> carGenerators;
+
+    PlayerInfo playerInfo;
+    GameStats gameStats;
+};
+
+void copyName(char* out, size_t size, const std::string& name) {
+    std::memset(out, 0, size);
+    std::strncpy(out, name.c_str(), size - 1);
+}
+
+void snapshotScript(const GameState& state, SaveGameSnapshot& snapshot) {
+    auto script = state.script;
+    const auto globals = script->getGlobals();
+    snapshot.globals.assign(globals,
+                            globals + script->getFile().getGlobalsSize());
+
+    auto& data = snapshot.scriptData;
+    if (state.scriptOnMissionFlag) {
+        data.onMissionOffset = static_cast<BlockDword>(
+            reinterpret_cast<const SCMByte*>(state.scriptOnMissionFlag) -
+            globals);
+    }
+    for (size_t c = 0; c < state.scriptContacts.size(); ++c) {
+        data.contactInfo[c].missionFlag =
+            state.scriptContacts[c].onMissionOffset;
+        data.contactInfo[c].baseBrief = state.scriptContacts[c].baseBrief;
+    }
+    data.mainSize = script->getFile().getMainSize();
+    data.largestMissionSize = script->getFile().getLargestMissionSize();
+    data.missionCount = static_cast<BlockWord>(
+        script->getFile().getMissionOffsets().size());
+
+    for (const auto& thread : script->getThreads()) {
+        if (thread.finished) {
+            continue;
+        }
+        snapshot.scripts.emplace_back();
+        auto& s = snapshot.scripts.back();
+        std::strncpy(s.name, thread.name, sizeof(s.name) - 1);
+        s.programCounter = thread.programCounter;
+        for (int i = 0; i < SCM_STACK_DEPTH; ++i) {
+            s.stack[i] = thread.calls[i];
+        }
+        s.stackCounter = static_cast<BlockWord>(thread.stackDepth);
+        std::memcpy(s.variables, thread.locals.data(), sizeof(s.variables));
+        s.ifFlag = thread.conditionResult;
+        s.ifNumber = static_cast<BlockWord>(thread.conditionCount);
+        // Inverse of the wake time adjustment made when loading
+        s.wakeTimer = static_cast<BlockDword>(thread.wakeCounter) +
+                      state.basic.lastTick - 33;
+    }
+}
+
+void snapshotPlayer(const GameState& state, SaveGameSnapshot& snapshot) {
+    auto object = state.world->pedestrianPool.find(state.playerObject);
+    if (object == nullptr) {
+        return;
+    }
+    auto player = static_cast<CharacterObject*>(object);
+    const auto& cs = player->getCurrentState();
+
+    snapshot.players.emplace_back();
+    auto& ped = snapshot.players.back();
+    ped.info.position = player->getPosition();
+    ped.info.health = cs.health;
+    ped.info.armour = cs.armour;
+    for (int w = 0; w < kNrOfWeapons; ++w) {
+        ped.info.weapons[w].weaponId = cs.weapons[w].weaponId;
+        ped.info.weapons[w].inClip = cs.weapons[w].bulletsClip;
+        ped.info.weapons[w].totalBullets = cs.weapons[w].bulletsTotal;
+    }
+    ped.maxWantedLevel = state.maxWantedLevel;
+}
+
+void snapshotGarages(const GameState& state, SaveGameSnapshot& snapshot) {
+    auto& data = snapshot.garageData;
+    data.garageCount = static_cast<BlockDword>(state.world->garages.size());
+    data.bfImportExportPortland = state.importExportPortland.to_ulong();
+    data.bfImportExportShoreside = state.importExportShoreside.to_ulong();
+    data.bfImportExportUnused = state.importExportUnused.to_ulong();
+
+    for (const auto& garage : state.world->garages) {
+        snapshot.garages.emplace_back();
+        auto& g = snapshot.garages.back();
+        g.type = static_cast<uint8_t>(garage->type);
+        g.x1 = garage->min.x;
+        g.y1 = garage->min.y;
+        g.z1 = garage->min.z;
+        g.x2 = garage->max.x;
+        g.y2 = garage->max.y;
+        g.z2 = garage->max.z;
+    }
+}
+
+void snapshotObjects(const GameState& state, SaveGameSnapshot& snapshot) {
+    for (const auto& p : state.world->vehiclePool.objects) {
+        auto vehicle = static_cast<VehicleObject*>(p.second.get());
+        if (vehicle->getLifetime() == GameObject::TrafficLifetime) {
+            continue;
+        }
+        const auto info = vehicle->getVehicle();
+        const auto modelId = static_cast<BlockWord>(info->id());
+        if (info->vehicletype_ == VehicleModelInfo::BOAT) {
+            snapshot.boats.emplace_back();
+            snapshot.boats.back().modelId = modelId;
+            snapshot.boats.back().state.position = vehicle->getPosition();
+        } else {
+            snapshot.vehicles.emplace_back();
+            snapshot.vehicles.back().modelId = modelId;
+            snapshot.vehicles.back().state.position = vehicle->getPosition();
+        }
+    }
+
+    // The loader creates every object it reads, so only the objects the
+    // scripts created are saved
+    for (const auto& p : state.world->instancePool.objects) {
+        auto object = p.second.get();
+        if (object->getLifetime() != GameObject::MissionLifetime) {
+            continue;
+        }
+        snapshot.objects.emplace_back();
+        auto& obj = snapshot.objects.back();
+        obj.modelId = static_cast<BlockWord>(
+            object->getModelInfo<BaseModelInfo>()->id());
+        obj.position = object->getPosition();
+
+        const auto m = glm::mat3_cast(object->getRotation());
+        const glm::vec3 axes[] = {m[0], m[1], -m[2]};
+        for (int a = 0; a < 3; ++a) {
+            for (int c = 0; c < 3; ++c) {
+                obj.rotation[a * 3 + c] =
+                    static_cast<int8_t>(glm::round(axes[a][c] * 100.f));
+            }
+        }
+    }
+}
+
+void snapshotPayphones(const GameState& state, SaveGameSnapshot& snapshot) {
+    const auto& payphones = state.world->payphones;
+    snapshot.payphoneData.numPayphones =
+        static_cast<BlockDword>(payphones.size());
+    for (const auto& payphone : payphones) {
+        snapshot.payphones.emplace_back();
+        snapshot.payphones.back().position = payphone->getPosition();
+        if (payphone->state != Payphone::State::Idle) {
+            snapshot.payphoneData.numActivePayphones++;
+        }
+    }
+}
+
+void snapshotRestarts(const GameState& state, SaveGameSnapshot& snapshot) {
+    auto& data = snapshot.restartData;
+    const auto hospitals = std::min(state.hospitalRestarts.size(), size_t(8));
+    for (size_t r = 0; r < hospitals; ++r) {
+        data.hospitalRestarts[r].position =
+            glm::vec3(state.hospitalRestarts[r]);
+        data.hospitalRestarts[r].angle = state.hospitalRestarts[r].w;
+    }
+    const auto police = std::min(state.policeRestarts.size(), size_t(8));
+    for (size_t r = 0; r < police; ++r) {
+        data.policeRestarts[r].position = glm::vec3(state.policeRestarts[r]);
+        data.policeRestarts[r].angle = state.policeRestarts[r].w;
+    }
+    data.numHospitals = static_cast<BlockWord>(hospitals);
+    data.numPolice = static_cast<BlockWord>(police);
+    data.overrideFlag = state.overrideNextRestart;
+    data.overrideRestart.position = glm::vec3(state.nextRestartLocation);
+    data.overrideRestart.angle = state.nextRestartLocation.w;
+    data.hospitalLevelOverride =
+        static_cast<uint8_t>(state.hospitalIslandOverride);
+    data.policeLevelOverride = static_cast<uint8_t>(state.policeIslandOverride);
+}
+
+void snapshotZones(const GameState& state, SaveGameSnapshot& snapshot) {
+    auto& data = snapshot.zoneData;
+    const auto& zones = state.world->data->gamezones;
+    if (zones.size() > kNrOfNavZones) {
+        RW_ERROR("Only the first " << kNrOfNavZones << " of " << zones.size()
+                                   << " zones are saved");
+    }
+
+    // Each zone gets its own day and night info
+    const auto count = std::min(zones.size(), size_t(kNrOfNavZones));
+    for (size_t z = 0; z < count; ++z) {
+        const auto& zone = zones[z];
+        auto& navZone = data.navZones[z];
+        copyName(navZone.name, sizeof(navZone.name), zone.name);
+        navZone.coordA = zone.min;
+        navZone.coordB = zone.max;
+        navZone.type = static_cast<BlockDword>(zone.type);
+        navZone.level = static_cast<BlockDword>(zone.island);
+        navZone.dayZoneInfo = static_cast<BlockWord>(z * 2);
+        navZone.nightZoneInfo = static_cast<BlockWord>(z * 2 + 1);
+        data.dayNightInfo[z * 2].pedgroup =
+            static_cast<BlockWord>(zone.pedGroupDay);
+        data.dayNightInfo[z * 2 + 1].pedgroup =
+            static_cast<BlockWord>(zone.pedGroupNight);
+    }
+    data.numNavZones = static_cast<BlockWord>(count);
+    data.numZoneInfos = static_cast<BlockWord>(count * 2);
+}
+
+void snapshotCarGenerators(const GameState& state,
+                           SaveGameSnapshot& snapshot) {
+    for (const auto& gen : state.vehicleGenerators) {
+        snapshot.carGenerators.emplace_back();
+        auto& g = snapshot.carGenerators.back();
+        g.modelId = static_cast<BlockDword>(gen.vehicleID);
+        g.position = gen.position;
+        g.angle = gen.heading;
+        g.colourFG = static_cast<BlockWord>(gen.colourFG);
+        g.colourBG = static_cast<BlockWord>(gen.colourBG);
+        g.force = gen.alwaysSpawn;
+        g.alarmChance = static_cast<uint8_t>(gen.alarmThreshold);
+        g.lockedChance = static_cast<uint8_t>(gen.lockedThreshold);
+        g.minDelay = static_cast<BlockWord>(gen.minDelay);
+        g.maxDelay = static_cast<BlockWord>(gen.maxDelay);
+        g.timestamp = static_cast<BlockDword>(gen.lastSpawnTime);
+    }
+
+    auto& data = snapshot.carGeneratorData;
+    const auto count = static_cast<BlockDword>(snapshot.carGenerators.size());
+    // Size of the generator counters that follow
+    data.blockSize = 0x0C;
+    data.generatorCount = count;
+    data.activeGenerators = count;
+    data.generatorSize =
+        static_cast<BlockDword>(count * sizeof(Block13CarGenerator));
+}
+
+SaveGameSnapshot takeSnapshot(const GameState& state) {
+    SaveGameSnapshot snapshot;
+    snapshot.basic = state.basic;
+    snapshotScript(state, snapshot);
+    snapshotPlayer(state, snapshot);
+    snapshotGarages(state, snapshot);
+    snapshotObjects(state, snapshot);
+    snapshotPayphones(state, snapshot);
+    snapshotRestarts(state, snapshot);
+    snapshotZones(state, snapshot);
+    snapshotCarGenerators(state, snapshot);
+    snapshot.playerInfo = state.playerInfo;
+    snapshot.gameStats = state.gameStats;
+    return snapshot;
+}
+
+/**
+ * Builds a save file in memory. Sizes are written as placeholders and filled
+ * in once the data they cover has been written.
+ */
+class SaveFileWriter {
+public:
+    template <class T>
+    void write(const T& value) {
+        writeBytes(&value, sizeof(value));
+    }
+
+    void writeBytes(const void* bytes, size_t size) {
+        const auto begin = static_cast<const uint8_t*>(bytes);
+        data_.insert(data_.end(), begin, begin + size);
+    }
+
+    void writeSignature(const char* signature) {
+        char sig[4]{};
+        std::strncpy(sig, signature, 3);
+        write(sig);
+    }
+
+    /**
+     * Writes a placeholder size
+     * @return offset to pass to endSize
+     */
+    size_t beginSize() {
+        const auto offset = data_.size();
+        write(BlockSize{0});
+        return offset;
+    }
+
+    /**
+     * Sets the size at offset to cover everything written after it
+     */
+    void endSize(size_t offset) {
+        const auto size =
+            static_cast<BlockSize>(data_.size() - offset - sizeof(BlockSize));
+        std::memcpy(data_.data() + offset, &size, sizeof(size));
+    }
+
+    const std::vector<uint8_t>& data() const {
+        return data_;
+    }
+
+private:
+    std::vector<uint8_t> data_;
+};
+
+/**
+ * Writes data in the same order as loadGame reads it, fields the loader
+ * reads individually are written individually.
+ */
+std::vector<uint8_t> encodeSnapshot(const SaveGameSnapshot& snapshot) {
+    SaveFileWriter w;
+
+    // Block 0
+    auto block = w.beginSize();
+    w.write(snapshot.basic);
+    auto outer = w.beginSize();
+    w.writeSignature("SCR");
+    auto inner = w.beginSize();
+    w.write(static_cast<BlockDword>(snapshot.globals.size()));
+    w.writeBytes(snapshot.globals.data(), snapshot.globals.size());
+    w.write(static_cast<BlockSize>(sizeof(Block0ScriptData)));
+    w.write(snapshot.scriptData);
+    w.write(static_cast<BlockDword>(snapshot.scripts.size()));
+    for (const auto& script : snapshot.scripts) {
+        w.write(script);
+    }
+    w.endSize(inner);
+    w.endSize(outer);
+    w.endSize(block);
+
+    // Block 1
+    block = w.beginSize();
+    inner = w.beginSize();
+    w.write(static_cast<BlockDword>(snapshot.players.size()));
+    for (const auto& ped : snapshot.players) {
+        w.write(ped.unknown0);
+        w.write(ped.unknown1);
+        w.write(ped.reference);
+        w.write(ped.info);
+        w.write(ped.maxWantedLevel);
+        w.write(ped.maxChaosLevel);
+        w.write(ped.modelName);
+        w.write(ped.align);
+    }
+    w.endSize(inner);
+    w.endSize(block);
+
+    // Block 2
+    block = w.beginSize();
+    inner = w.beginSize();
+    const auto& garageData = snapshot.garageData;
+    w.write(garageData.garageCount);
+    w.write(garageData.freeBombs);
+    w.write(garageData.freeResprays);
+    w.write(garageData.unknown0);
+    w.write(garageData.unknown1);
+    w.write(garageData.unknown2);
+    w.write(garageData.bfImportExportPortland);
+    w.write(garageData.bfImportExportShoreside);
+    w.write(garageData.bfImportExportUnused);
+    w.write(garageData.GA_21lastTime);
+    w.write(garageData.cars);
+    for (const auto& garage : snapshot.garages) {
+        w.write(garage);
+    }
+    w.endSize(inner);
+    w.endSize(block);
+
+    // Block 3
+    block = w.beginSize();
+    inner = w.beginSize();
+    w.write(static_cast<BlockDword>(snapshot.vehicles.size()));
+    w.write(static_cast<BlockDword>(snapshot.boats.size()));
+    for (const auto& veh : snapshot.vehicles) {
+        w.write(veh.unknown1);
+        w.write(veh.modelId);
+        w.write(veh.unknown2);
+        w.write(veh.state);
+    }
+    for (const auto& veh : snapshot.boats) {
+        w.write(veh.unknown1);
+        w.write(veh.modelId);
+        w.write(veh.unknown2);
+        w.write(veh.state);
+    }
+    w.endSize(inner);
+    w.endSize(block);
+
+    // Block 4
+    block = w.beginSize();
+    inner = w.beginSize();
+    w.write(static_cast<BlockDword>(snapshot.objects.size()));
+    for (const auto& obj : snapshot.objects) {
+        w.write(obj.modelId);
+        w.write(obj.reference);
+        w.write(obj.position);
+        w.write(obj.rotation);
+        w.write(obj.unknown1);
+        w.write(obj.unknown2);
+        w.write(obj.unknown3);
+        w.write(obj.unknown4);
+        w.write(obj.unknown5);
+        w.write(obj.unknown6);
+        w.write(obj.unknown7);
+        w.write(obj.unknown8);
+        w.write(obj.unknown9);
+        w.write(obj.unknown10);
+    }
+    w.endSize(inner);
+    w.endSize(block);
+
+    // Block 5, path data isn't kept
+    block = w.beginSize();
+    inner = w.beginSize();
+    w.write(BlockDword{0});
+    w.endSize(inner);
+    w.endSize(block);
+
+    // Block 6, cranes aren't implemented
+    block = w.beginSize();
+    inner = w.beginSize();
+    w.write(BlockDword{0});
+    w.write(BlockDword{0});
+    w.endSize(inner);
+    w.endSize(block);
+
+    // Block 7, pickups aren't saved yet
+    block = w.beginSize();
+    inner = w.beginSize();
+    w.write(Block7Data{});
+    w.endSize(inner);
+    w.endSize(block);
+
+    // Block 8
+    block = w.beginSize();
+    inner = w.beginSize();
+    w.write(snapshot.payphoneData);
+    for (const auto& payphone : snapshot.payphones) {
+        w.write(payphone);
+    }
+    w.endSize(inner);
+    w.endSize(block);
+
+    // Block 9
+    block = w.beginSize();
+    outer = w.beginSize();
+    w.writeSignature("RST");
+    inner = w.beginSize();
+    w.write(snapshot.restartData);
+    w.endSize(inner);
+    w.endSize(outer);
+    w.endSize(block);
+
+    // Block 10, blips aren't saved yet
+    block = w.beginSize();
+    outer = w.beginSize();
+    w.writeSignature("RDR");
+    inner = w.beginSize();
+    w.write(Block10Data{});
+    w.endSize(inner);
+    w.endSize(outer);
+    w.endSize(block);
+
+    // Block 11
+    block = w.beginSize();
+    outer = w.beginSize();
+    w.writeSignature("ZNS");
+    inner = w.beginSize();
+    const auto& zoneData = snapshot.zoneData;
+    w.write(zoneData.currentZone);
+    w.write(zoneData.currentLevel);
+    w.write(zoneData.findIndex);
+    w.write(zoneData.align);
+    const auto writeZone = [&w](const Block11Zone& zone) {
+        w.write(zone.name);
+        w.write(zone.coordA);
+        w.write(zone.coordB);
+        w.write(zone.type);
+        w.write(zone.level);
+        w.write(zone.dayZoneInfo);
+        w.write(zone.nightZoneInfo);
+        w.write(zone.childZone);
+        w.write(zone.parentZone);
+        w.write(zone.siblingZone);
+    };
+    for (const auto& zone : zoneData.navZones) {
+        writeZone(zone);
+    }
+    for (const auto& info : zoneData.dayNightInfo) {
+        w.write(info.density);
+        w.write(info.unknown1);
+        w.write(info.peddensity);
+        w.write(info.copdensity);
+        w.write(info.gangpeddensity);
+        w.write(info.pedgroup);
+    }
+    w.write(zoneData.numNavZones);
+    w.write(zoneData.numZoneInfos);
+    for (const auto& zone : zoneData.mapZones) {
+        writeZone(zone);
+    }
+    for (const auto& audioZone : zoneData.audioZones) {
+        w.write(audioZone);
+    }
+    w.write(zoneData.numMapZones);
+    w.write(zoneData.numAudioZones);
+    w.endSize(inner);
+    w.endSize(outer);
+    w.endSize(block);
+
+    // Block 12, gangs aren't saved yet
+    block = w.beginSize();
+    outer = w.beginSize();
+    w.writeSignature("GNG");
+    inner = w.beginSize();
+    w.write(Block12Data{});
+    w.endSize(inner);
+    w.endSize(outer);
+    w.endSize(block);
+
+    // Block 13
+    block = w.beginSize();
+    outer = w.beginSize();
+    w.writeSignature("CGN");
+    inner = w.beginSize();
+    w.write(snapshot.carGeneratorData);
+    for (const auto& gen : snapshot.carGenerators) {
+        w.write(gen);
+    }
+    w.endSize(inner);
+    w.endSize(outer);
+    w.endSize(block);
+
+    // Block 14, particles aren't saved
+    block = w.beginSize();
+    inner = w.beginSize();
+    w.write(BlockDword{0});
+    w.endSize(inner);
+    w.endSize(block);
+
+    // Block 15, audio objects aren't saved
+    block = w.beginSize();
+    outer = w.beginSize();
+    w.writeSignature("AUD");
+    inner = w.beginSize();
+    w.write(BlockDword{0});
+    w.endSize(inner);
+    w.endSize(outer);
+    w.endSize(block);
+
+    // Block 16
+    block = w.beginSize();
+    inner = w.beginSize();
+    const auto& playerInfo = snapshot.playerInfo;
+    w.write(playerInfo.money);
+    w.write(playerInfo.unknown1);
+    w.write(playerInfo.unknown2);
+    w.write(playerInfo.unknown3);
+    w.write(playerInfo.unknown4);
+    w.write(playerInfo.displayedMoney);
+    w.write(playerInfo.hiddenPackagesCollected);
+    w.write(playerInfo.hiddenPackageCount);
+    w.write(playerInfo.neverTired);
+    w.write(playerInfo.fastReload);
+    w.write(playerInfo.thaneOfLibertyCity);
+    w.write(playerInfo.singlePayerHealthcare);
+    w.write(playerInfo.unknown5);
+    w.endSize(inner);
+    w.endSize(block);
+
+    // Block 17
+    block = w.beginSize();
+    inner = w.beginSize();
+    const auto& stats = snapshot.gameStats;
+    w.write(stats.playerKills);
+    w.write(stats.otherKills);
+    w.write(stats.carsExploded);
+    w.write(stats.shotsHit);
+    w.write(stats.pedTypesKilled);
+    w.write(stats.helicoptersDestroyed);
+    w.write(stats.playerProgress);
+    w.write(stats.explosiveKgsUsed);
+    w.write(stats.bulletsFired);
+    w.write(stats.bulletsHit);
+    w.write(stats.carsCrushed);
+    w.write(stats.headshots);
+    w.write(stats.timesBusted);
+    w.write(stats.timesHospital);
+    w.write(stats.daysPassed);
+    w.write(stats.mmRainfall);
+    w.write(stats.insaneJumpMaxDistance);
+    w.write(stats.insaneJumpMaxHeight);
+    w.write(stats.insaneJumpMaxFlips);
+    w.write(stats.insaneJumpMaxRotation);
+    w.write(stats.bestStunt);
+    w.write(stats.uniqueStuntsFound);
+    w.write(stats.uniqueStuntsTotal);
+    w.write(stats.missionAttempts);
+    w.write(stats.missionsPassed);
+    w.write(stats.passengersDroppedOff);
+    w.write(stats.taxiRevenue);
+    w.write(stats.portlandPassed);
+    w.write(stats.stauntonPassed);
+    w.write(stats.shoresidePassed);
+    w.write(stats.bestTurismoTime);
+    w.write(stats.distanceWalked);
+    w.write(stats.distanceDriven);
+    w.write(stats.patriotPlaygroundTime);
+    w.write(stats.aRideInTheParkTime);
+    w.write(stats.grippedTime);
+    w.write(stats.multistoryMayhemTime);
+    w.write(stats.peopleSaved);
+    w.write(stats.criminalsKilled);
+    w.write(stats.highestParamedicLevel);
+    w.write(stats.firesExtinguished);
+    w.write(stats.longestDodoFlight);
+    w.write(stats.bombDefusalTime);
+    w.write(stats.rampagesPassed);
+    w.write(stats.totalRampages);
+    w.write(stats.totalMissions);
+    w.write(stats.fastestTime);
+    w.write(stats.highestScore);
+    w.write(stats.peopleKilledSinceCheckpoint);
+    w.write(stats.peopleKilledSinceLastBustedOrWasted);
+    w.write(stats.lastMissionGXT);
+    w.endSize(inner);
+    w.endSize(block);
+
+    // Block 18, streaming isn't saved
+    block = w.beginSize();
+    inner = w.beginSize();
+    w.write(Block18Data{});
+    w.endSize(inner);
+    w.endSize(block);
+
+    // Block 19, ped types aren't saved yet
+    block = w.beginSize();
+    outer = w.beginSize();
+    w.writeSignature("PTP");
+    inner = w.beginSize();
+    w.write(Block19Data{});
+    w.endSize(inner);
+    w.endSize(outer);
+    w.endSize(block);
+
+    return w.data();
+}
+
+/**
+ * Writes the save next to the destination, then moves it over the top so
+ * that an interrupted save never leaves a truncated file behind
+ */
+/// Returns why the write failed, or an empty string if it succeeded. Doesn't
+/// log, as it also runs on the writeGameAsync worker.
+std::string writeSnapshot(const SaveGameSnapshot& snapshot,
+                          const std::string& file) {
+    const auto data = encodeSnapshot(snapshot);
+    const auto tempFile = file + ".tmp";
+
+    std::FILE* saveFile = std::fopen(tempFile.c_str(), "wb");
+    if (saveFile == nullptr) {
+        return "Failed to open save file " + tempFile;
+    }
+    const bool written =
+        std::fwrite(data.data(), sizeof(uint8_t), data.size(), saveFile) ==
+        data.size();
+    if (std::fclose(saveFile) != 0 || !written) {
+        std::remove(tempFile.c_str());
+        return "Failed to write save file " + tempFile;
+    }
+
+    rwfs::error_code ec;
+    rwfs::rename(tempFile, file, ec);
+    if (ec) {
+        std::remove(tempFile.c_str());
+        return "Failed to replace save file " + file + ": " + ec.message();
+    }
+    return {};
+}
+}  // namespace
+
+bool SaveGame::writeGame(GameState& state, const std::string& file) {
+    const auto error = writeSnapshot(takeSnapshot(state), file);
+    if (!error.empty()) {
+        RW_ERROR(error);
+        return false;
+    }
+    return true;
+}
+
+std::future<std::string> SaveGame::writeGameAsync(GameState& state,
+                                                  const std::string& file) {
+    return std::async(std::launch::async,
+                      [snapshot = takeSnapshot(state), file]() {
+                          return writeSnapshot(snapshot, file);
+                      });
 }
 
 template <class T>
@@ -985,13 +1707,7 @@ bool SaveGame::loadGame(GameState& state, const std::string& file) {
                             zone.level, day.pedgroup, night.pedgroup);
     }
     // Re-build zone hierarchy
-    for (ZoneData& zone : gamezones) {
-        if (&zone == &gamezones[0]) {
-            continue;
-        }
-
-        gamezones[0].insertZone(zone);
-    }
+    state.world->data->buildZoneHierarchy();
 
     // Block 12
     BlockSize gangBlockSize;
@@ -1302,25 +2018,30 @@ bool SaveGame::loadGame(GameState& state, const std::string& file) {
     return true;
 }
 
+namespace {
+/// The part of a save file read to list it
+struct SaveHeader {
+    BlockDword blockSize;
+    BasicState basic;
+};
+static_assert(sizeof(SaveHeader) == sizeof(BlockDword) + sizeof(BasicState),
+              "SaveHeader has padding");
+}  // namespace
+
 bool SaveGame::getSaveInfo(const std::string& file, BasicState* basicState) {
     std::FILE* loadFile = std::fopen(file.c_str(), "rb");
-
-    SaveGameInfo info;
-    info.savePath = file;
-
-    // BLOCK 0
-    BlockDword blockSize;
-    if (fread(&blockSize, sizeof(BlockDword), 1, loadFile) == 0) {
+    if (loadFile == nullptr) {
         return false;
     }
 
-    // Read block 0 into state
-    if (fread(basicState, sizeof(BasicState), 1, loadFile) == 0) {
+    SaveHeader header;
+    const bool read = std::fread(&header, sizeof(header), 1, loadFile) == 1;
+    std::fclose(loadFile);
+    if (!read) {
         return false;
     }
 
-    std::fclose(loadFile);
-
+    *basicState = header.basic;
     return true;
 }
 
@@ -1347,6 +2068,18 @@ char* readUserPath() {
 }
 #endif
 
+namespace {
+/// Parsed save header, reused while the file's size and time are unchanged
+struct SaveSlot {
+    std::uintmax_t size;
+    decltype(rwfs::last_write_time(rwfs::path())) modified;
+    SaveGameInfo info;
+};
+
+std::mutex saveSlotMutex;
+std::unordered_map<std::string, SaveSlot> saveSlots;
+}  // namespace
+
 std::vector<SaveGameInfo> SaveGame::getAllSaveGameInfo() {
 #ifdef RW_WINDOWS
     auto homedir = readUserPath(); // already includes MyDocuments/Documents
@@ -1362,17 +2095,51 @@ std::vector<SaveGameInfo> SaveGame::getAllSaveGameInfo() {
     rwfs::path gamePath(homedir);
     gamePath /= gameDir;
 
+    return getAllSaveGameInfo(gamePath.string());
+}
+
+std::vector<SaveGameInfo> SaveGame::getAllSaveGameInfo(
+    const std::string& directory) {
+    const rwfs::path gamePath(directory);
     if (!rwfs::exists(gamePath) || !rwfs::is_directory(gamePath)) return {};
 
+    std::lock_guard<std::mutex> lock(saveSlotMutex);
+    std::unordered_map<std::string, SaveSlot> slots;
+
     std::vector<SaveGameInfo> infos;
     for (const rwfs::path& save_path : rwfs::directory_iterator(gamePath)) {
-        if (save_path.extension() == ".b") {
-            infos.emplace_back(
-                SaveGameInfo{save_path.string(), false, BasicState()});
-            infos.back().valid =
-                getSaveInfo(infos.back().savePath, &infos.back().basicState);
+        if (save_path.extension() != ".b") {
+            continue;
+        }
+        rwfs::error_code sizeError;
+        rwfs::error_code timeError;
+        const auto size = rwfs::file_size(save_path, sizeError);
+        const auto modified = rwfs::last_write_time(save_path, timeError);
+        if (sizeError || timeError) {
+            continue;
+        }
+
+        const auto savePath = save_path.string();
+        auto it = saveSlots.find(savePath);
+        if (it == saveSlots.end() || it->second.size != size ||
+            it->second.modified != modified) {
+            SaveSlot slot{size, modified,
+                          SaveGameInfo{savePath, false, BasicState()}};
+            slot.info.valid = getSaveInfo(savePath, &slot.info.basicState);
+            it = saveSlots.insert_or_assign(savePath, std::move(slot)).first;
         }
+
+        infos.push_back(it->second.info);
+        slots.insert(*it);
     }
 
+    // Forget saves that have been deleted
+    saveSlots.swap(slots);
+
     return infos;
 }
+
+std::future<std::vector<SaveGameInfo>> SaveGame::getAllSaveGameInfoAsync() {
+    return std::async(std::launch::async,
+                      [] { return getAllSaveGameInfo(); });
+}
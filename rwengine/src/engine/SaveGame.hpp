@@ -1,6 +1,7 @@
 #ifndef _RWENGINE_SAVEGAME_HPP_
 #define _RWENGINE_SAVEGAME_HPP_
 
+#include <future>
 #include <string>
 #include <vector>
 
@@ -20,8 +21,23 @@ public:
     /**
      * Writes the entire game state to a file format that closely approximates
      * the format used in GTA III
+     *
+     * The save is written to a temporary file first, which then replaces file.
+     * @return status, false if failure occured.
      */
-    static void writeGame(GameState& state, const std::string& file);
+    static bool writeGame(GameState& state, const std::string& file);
+
+    /**
+     * Copies the game state, then encodes and writes it on another thread
+     *
+     * Only the copy is made on the calling thread, so this can be used from
+     * the game loop. The future must be kept until the save has finished, as
+     * destroying it waits for the write. Nothing is logged from the worker,
+     * the caller should report the result on its own thread.
+     * @return why the write failed, empty if it succeeded.
+     */
+    static std::future<std::string> writeGameAsync(GameState& state,
+                                                   const std::string& file);
 
     /**
      * Loads an entire Game State from a file, using a format similar to the
@@ -37,8 +53,22 @@ public:
 
     /**
      * Returns save game information for all found saves
+     *
+     * Saves are only read again when their size or modification time have
+     * changed since the last call.
      */
     static std::vector<SaveGameInfo> getAllSaveGameInfo();
+
+    /**
+     * Returns save game information for all saves in directory
+     */
+    static std::vector<SaveGameInfo> getAllSaveGameInfo(
+        const std::string& directory);
+
+    /**
+     * Finds the saves on another thread, see getAllSaveGameInfo()
+     */
+    static std::future<std::vector<SaveGameInfo>> getAllSaveGameInfoAsync();
 };
 
 #endif
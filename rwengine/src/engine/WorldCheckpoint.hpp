@@ -0,0 +1,68 @@
+#ifndef _RWENGINE_WORLDCHECKPOINT_HPP_
+#define _RWENGINE_WORLDCHECKPOINT_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <utility>
+#include <vector>
+
+#include <glm/gtc/quaternion.hpp>
+#include <glm/vec3.hpp>
+
+#include <engine/GameState.hpp>
+#include <objects/CharacterObject.hpp>
+#include <objects/GameObject.hpp>
+#include <script/ScriptMachine.hpp>
+
+/**
+ * @brief Dynamic world state captured by GameWorld::createCheckpoint
+ *
+ * Holds what a mission can change: the dynamic object pools, the game state
+ * and the script threads and globals. Buildings placed from IPLs aren't
+ * included, they are left alone by GameWorld::restoreCheckpoint.
+ *
+ * A checkpoint can only be restored into the world and script it was
+ * created from.
+ */
+struct WorldCheckpoint {
+    struct Object {
+        GameObjectID id;
+        uint16_t modelId;
+        glm::vec3 position{};
+        glm::quat rotation{1.f, 0.f, 0.f, 0.f};
+        GameObject::ObjectLifetime lifetime;
+    };
+
+    struct Vehicle : Object {
+        float health;
+        glm::u8vec3 colourPrimary{};
+        glm::u8vec3 colourSecondary{};
+    };
+
+    struct Character : Object {
+        CharacterState state;
+        /// The vehicle the character is in, 0 if on foot
+        GameObjectID vehicle;
+        size_t seat;
+    };
+
+    struct Pickup : Object {
+        int type;
+        bool enabled;
+    };
+
+    std::vector<Vehicle> vehicles;
+    std::vector<Character> characters;
+    std::vector<Pickup> pickups;
+    /// Instances created by the scripts
+    std::vector<Object> instances;
+
+    GameState state;
+    std::vector<std::pair<GameObject::Type, GameObjectID>> missionObjects;
+
+    std::vector<SCMByte> globals;
+    std::list<SCMThread> threads;
+};
+
+#endif
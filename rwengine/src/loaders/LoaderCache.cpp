@@ -0,0 +1,819 @@
+#include "loaders/LoaderCache.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <glm/gtc/quaternion.hpp>
+#include <glm/vec3.hpp>
+
+#include <rw/debug.hpp>
+
+#include "data/CollisionModel.hpp"
+#include "data/InstanceData.hpp"
+#include "data/ModelData.hpp"
+#include "data/PathData.hpp"
+#include "data/ZoneData.hpp"
+#include "loaders/LoaderCOL.hpp"
+#include "loaders/LoaderIDE.hpp"
+#include "loaders/LoaderIPL.hpp"
+
+namespace {
+constexpr uint32_t kCacheMagic = 0x43445752;  // "RWDC"
+
+struct CacheHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t kind;
+    uint32_t reserved;
+    uint64_t sourceSize;
+    uint64_t sourceHash;
+};
+
+struct SourceInfo {
+    uint64_t size = 0;
+    uint64_t hash = 0;
+};
+
+/// Reference into the string table at the end of the cache file
+struct CacheString {
+    uint32_t offset;
+    uint32_t length;
+};
+
+struct CachedInstance {
+    int32_t id;
+    CacheString model;
+    float pos[3];
+    float scale[3];
+    /// w, x, y, z
+    float rot[4];
+};
+
+struct CachedZone {
+    CacheString name;
+    int32_t type;
+    float min[3];
+    float max[3];
+    int32_t island;
+};
+
+/// One record for every model info type, unused fields are zero
+struct CachedModel {
+    uint32_t type;
+    uint32_t id;
+    CacheString name;
+    CacheString textureslot;
+
+    // SimpleModelInfo
+    uint32_t numAtomics;
+    float lodDistances[3];
+    int32_t flags;
+    int32_t timeOn;
+    int32_t timeOff;
+    uint32_t firstPath;
+    uint32_t numPaths;
+
+    // VehicleModelInfo
+    uint32_t vehicleType;
+    uint32_t wheelModel;
+    float wheelScale;
+    CacheString handling;
+    CacheString vehicleName;
+    uint32_t vehicleClass;
+    int32_t frequency;
+    int32_t level;
+    uint32_t componentRules;
+
+    // PedModelInfo
+    uint32_t pedType;
+    /// Stat indices depend on pedstats.dat, so the name is stored instead
+    CacheString behaviour;
+    CacheString animGroup;
+    int32_t carsMask;
+};
+
+struct CachedPath {
+    uint32_t type;
+    uint32_t id;
+    CacheString modelName;
+    uint32_t firstNode;
+    uint32_t numNodes;
+};
+
+struct CachedPathNode {
+    uint32_t type;
+    int32_t next;
+    float position[3];
+    float size;
+    int32_t leftLanes;
+    int32_t rightLanes;
+};
+
+struct CachedCollision {
+    CacheString name;
+    uint32_t modelid;
+    float sphereCenter[3];
+    float sphereRadius;
+    CollisionModel::Surface sphereSurface;
+    float boxMin[3];
+    float boxMax[3];
+    CollisionModel::Surface boxSurface;
+    uint32_t firstSphere;
+    uint32_t numSpheres;
+    uint32_t firstBox;
+    uint32_t numBoxes;
+    uint32_t firstVertex;
+    uint32_t numVertices;
+    uint32_t firstFace;
+    uint32_t numFaces;
+};
+
+struct CachedSphere {
+    float center[3];
+    float radius;
+    CollisionModel::Surface surface;
+};
+
+struct CachedBox {
+    float min[3];
+    float max[3];
+    CollisionModel::Surface surface;
+};
+
+struct CachedVertex {
+    float v[3];
+};
+
+struct CachedFace {
+    uint32_t tri[3];
+    CollisionModel::Surface surface;
+};
+
+bool isLittleEndian() {
+    const uint32_t probe = 1;
+    uint8_t first;
+    std::memcpy(&first, &probe, 1);
+    return first == 1;
+}
+
+bool readSourceInfo(const std::string& path, SourceInfo& info) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    // 64-bit FNV-1a
+    uint64_t hash = 0xcbf29ce484222325ull;
+    uint64_t size = 0;
+    char buffer[64 * 1024];
+    while (file) {
+        file.read(buffer, sizeof(buffer));
+        auto read = static_cast<size_t>(file.gcount());
+        for (size_t i = 0; i < read; ++i) {
+            hash ^= static_cast<uint8_t>(buffer[i]);
+            hash *= 0x100000001b3ull;
+        }
+        size += read;
+    }
+
+    info.size = size;
+    info.hash = hash;
+    return true;
+}
+
+void copyVec3(float* out, const glm::vec3& v) {
+    out[0] = v.x;
+    out[1] = v.y;
+    out[2] = v.z;
+}
+
+glm::vec3 toVec3(const float* v) {
+    return {v[0], v[1], v[2]};
+}
+
+class CacheWriter {
+public:
+    CacheString string(const std::string& s) {
+        CacheString ref{static_cast<uint32_t>(strings_.size()),
+                        static_cast<uint32_t>(s.size())};
+        strings_ += s;
+        return ref;
+    }
+
+    template <class T>
+    void table(const std::vector<T>& records) {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "Cache records must be trivially copyable");
+        auto count = static_cast<uint32_t>(records.size());
+        append(&count, sizeof(count));
+        append(records.data(), records.size() * sizeof(T));
+    }
+
+    bool write(const rwfs::path& path, LoaderCache::Kind kind,
+               const SourceInfo& source) {
+        CacheHeader header{kCacheMagic, LoaderCache::kVersion,
+                           static_cast<uint32_t>(kind), 0, source.size,
+                           source.hash};
+        auto stringsSize = static_cast<uint32_t>(strings_.size());
+
+        // Write to a temporary file first so that an interrupted write never
+        // leaves a truncated cache file behind.
+        auto tempPath = path;
+        tempPath += ".tmp";
+        {
+            std::ofstream file(tempPath.string(),
+                               std::ios::binary | std::ios::trunc);
+            if (!file.is_open()) {
+                return false;
+            }
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(body_.data(), body_.size());
+            file.write(reinterpret_cast<const char*>(&stringsSize),
+                       sizeof(stringsSize));
+            file.write(strings_.data(), strings_.size());
+            if (!file) {
+                return false;
+            }
+        }
+
+        rwfs::error_code ec;
+        rwfs::rename(tempPath, path, ec);
+        return !ec;
+    }
+
+private:
+    void append(const void* data, size_t size) {
+        auto bytes = static_cast<const char*>(data);
+        body_.insert(body_.end(), bytes, bytes + size);
+    }
+
+    std::vector<char> body_;
+    std::string strings_;
+};
+
+class CacheReader {
+public:
+    bool open(const rwfs::path& path, LoaderCache::Kind kind,
+              const SourceInfo& source) {
+        namespace bip = boost::interprocess;
+        try {
+            bip::file_mapping mapping(path.string().c_str(), bip::read_only);
+            region_ = bip::mapped_region(mapping, bip::read_only);
+        } catch (const bip::interprocess_exception&) {
+            return false;
+        }
+
+        cursor_ = static_cast<const char*>(region_.get_address());
+        end_ = cursor_ + region_.get_size();
+
+        CacheHeader header;
+        if (!read(&header, sizeof(header))) {
+            return false;
+        }
+        return header.magic == kCacheMagic &&
+               header.version == LoaderCache::kVersion &&
+               header.kind == static_cast<uint32_t>(kind) &&
+               header.sourceSize == source.size &&
+               header.sourceHash == source.hash;
+    }
+
+    template <class T>
+    bool table(std::vector<T>& records) {
+        uint32_t count;
+        if (!read(&count, sizeof(count))) {
+            return false;
+        }
+        if (static_cast<size_t>(end_ - cursor_) / sizeof(T) < count) {
+            return false;
+        }
+        records.resize(count);
+        return read(records.data(), count * sizeof(T));
+    }
+
+    bool strings() {
+        uint32_t size;
+        if (!read(&size, sizeof(size))) {
+            return false;
+        }
+        if (static_cast<size_t>(end_ - cursor_) < size) {
+            return false;
+        }
+        strings_ = cursor_;
+        stringsSize_ = size;
+        cursor_ += size;
+        return true;
+    }
+
+    /// Resolves a string, out of range references give an empty string
+    std::string string(const CacheString& ref) const {
+        if (ref.offset > stringsSize_ ||
+            ref.length > stringsSize_ - ref.offset) {
+            RW_ERROR("Cache string out of range");
+            return {};
+        }
+        return std::string(strings_ + ref.offset, ref.length);
+    }
+
+private:
+    bool read(void* out, size_t size) {
+        if (static_cast<size_t>(end_ - cursor_) < size) {
+            return false;
+        }
+        std::memcpy(out, cursor_, size);
+        cursor_ += size;
+        return true;
+    }
+
+    boost::interprocess::mapped_region region_;
+    const char* cursor_ = nullptr;
+    const char* end_ = nullptr;
+    const char* strings_ = nullptr;
+    uint32_t stringsSize_ = 0;
+};
+
+/// Checks that a [first, first + count) range lies inside a table
+template <class T>
+bool inRange(const std::vector<T>& table, uint32_t first, uint32_t count) {
+    return first <= table.size() && count <= table.size() - first;
+}
+
+}  // namespace
+
+LoaderCache::LoaderCache(rwfs::path cacheDir) : cacheDir_(std::move(cacheDir)) {
+    if (!isLittleEndian()) {
+        cacheDir_.clear();
+    }
+}
+
+rwfs::path LoaderCache::getCachePath(const std::string& source,
+                                     Kind kind) const {
+    // Files from different directories may share a name, so the name is
+    // suffixed with a hash of the full path.
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (char c : source) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 0x100000001b3ull;
+    }
+
+    std::ostringstream name;
+    name << rwfs::path(source).stem().string() << '-' << std::hex
+         << std::setw(16) << std::setfill('0') << hash;
+    switch (kind) {
+        case Kind::IDE:
+            name << ".ide.bin";
+            break;
+        case Kind::IPL:
+            name << ".ipl.bin";
+            break;
+        case Kind::COL:
+            name << ".col.bin";
+            break;
+    }
+    return cacheDir_ / name.str();
+}
+
+bool LoaderCache::loadIDE(const std::string& source, const PedStatsList& stats,
+                          LoaderIDE& ide) const {
+    SourceInfo info;
+    if (!isEnabled() || !readSourceInfo(source, info)) {
+        return false;
+    }
+
+    CacheReader reader;
+    std::vector<CachedModel> models;
+    std::vector<CachedPath> paths;
+    std::vector<CachedPathNode> nodes;
+    if (!reader.open(getCachePath(source, Kind::IDE), Kind::IDE, info) ||
+        !reader.table(models) || !reader.table(paths) ||
+        !reader.table(nodes) || !reader.strings()) {
+        return false;
+    }
+
+    auto findStatId = [&](const std::string& name) {
+        auto it =
+            std::find_if(stats.begin(), stats.end(),
+                         [&](const PedStats& a) { return a.name_ == name; });
+        return it == stats.end() ? -1 : it->id_;
+    };
+
+    decltype(ide.objects) objects;
+    for (const auto& m : models) {
+        std::unique_ptr<BaseModelInfo> info;
+        switch (static_cast<ModelDataType>(m.type)) {
+            case ModelDataType::SimpleInfo: {
+                if (!inRange(paths, m.firstPath, m.numPaths) ||
+                    m.numAtomics > 3) {
+                    return false;
+                }
+                auto simple = std::make_unique<SimpleModelInfo>();
+                simple->setNumAtomics(static_cast<int>(m.numAtomics));
+                for (int i = 0; i < 3; ++i) {
+                    simple->setLodDistance(i, m.lodDistances[i]);
+                }
+                simple->determineFurthest();
+                simple->flags = m.flags;
+                simple->timeOn = m.timeOn;
+                simple->timeOff = m.timeOff;
+
+                for (auto p = m.firstPath; p < m.firstPath + m.numPaths; ++p) {
+                    const auto& cp = paths[p];
+                    if (!inRange(nodes, cp.firstNode, cp.numNodes)) {
+                        return false;
+                    }
+                    PathData path;
+                    path.type = static_cast<PathData::PathType>(cp.type);
+                    path.ID = static_cast<uint16_t>(cp.id);
+                    path.modelName = reader.string(cp.modelName);
+                    for (auto n = cp.firstNode;
+                         n < cp.firstNode + cp.numNodes; ++n) {
+                        const auto& cn = nodes[n];
+                        PathNode node{};
+                        node.type = static_cast<PathNode::NodeType>(cn.type);
+                        node.next = cn.next;
+                        node.position = toVec3(cn.position);
+                        node.size = cn.size;
+                        node.leftLanes = cn.leftLanes;
+                        node.rightLanes = cn.rightLanes;
+                        path.nodes.push_back(node);
+                    }
+                    simple->paths.push_back(std::move(path));
+                }
+                info = std::move(simple);
+                break;
+            }
+            case ModelDataType::VehicleInfo: {
+                auto car = std::make_unique<VehicleModelInfo>();
+                car->vehicletype_ =
+                    static_cast<VehicleModelInfo::VehicleType>(m.vehicleType);
+                car->wheelmodel_ = static_cast<ModelID>(m.wheelModel);
+                car->wheelscale_ = m.wheelScale;
+                car->handling_ = reader.string(m.handling);
+                car->vehiclename_ = reader.string(m.vehicleName);
+                car->vehicleclass_ =
+                    static_cast<VehicleModelInfo::VehicleClass>(
+                        m.vehicleClass);
+                car->frequency_ = m.frequency;
+                car->level_ = m.level;
+                car->componentrules_ = m.componentRules;
+                info = std::move(car);
+                break;
+            }
+            case ModelDataType::PedInfo: {
+                auto ped = std::make_unique<PedModelInfo>();
+                ped->pedtype_ = static_cast<PedModelInfo::PedType>(m.pedType);
+                ped->statindex_ = findStatId(reader.string(m.behaviour));
+                ped->animgroup_ = reader.string(m.animGroup);
+                ped->carsmask_ = m.carsMask;
+                info = std::move(ped);
+                break;
+            }
+            case ModelDataType::ClumpInfo:
+                info = std::make_unique<ClumpModelInfo>();
+                break;
+            default:
+                return false;
+        }
+
+        info->setModelID(static_cast<ModelID>(m.id));
+        info->name = reader.string(m.name);
+        info->textureslot = reader.string(m.textureslot);
+        objects.emplace(info->id(), std::move(info));
+    }
+
+    ide.objects = std::move(objects);
+    return true;
+}
+
+bool LoaderCache::storeIDE(const std::string& source,
+                           const PedStatsList& stats,
+                           const LoaderIDE& ide) const {
+    SourceInfo info;
+    if (!isEnabled() || !readSourceInfo(source, info)) {
+        return false;
+    }
+
+    auto findStatName = [&](int id) -> std::string {
+        auto it = std::find_if(stats.begin(), stats.end(),
+                               [&](const PedStats& a) { return a.id_ == id; });
+        return it == stats.end() ? std::string() : it->name_;
+    };
+
+    CacheWriter writer;
+    std::vector<CachedModel> models;
+    std::vector<CachedPath> paths;
+    std::vector<CachedPathNode> nodes;
+    models.reserve(ide.objects.size());
+
+    for (const auto& [id, object] : ide.objects) {
+        CachedModel m{};
+        m.type = static_cast<uint32_t>(object->type());
+        m.id = id;
+        m.name = writer.string(object->name);
+        m.textureslot = writer.string(object->textureslot);
+
+        switch (object->type()) {
+            case ModelDataType::SimpleInfo: {
+                auto simple = static_cast<SimpleModelInfo*>(object.get());
+                m.numAtomics = static_cast<uint32_t>(simple->getNumAtomics());
+                for (int i = 0; i < 3; ++i) {
+                    m.lodDistances[i] = simple->getLodDistance(i);
+                }
+                m.flags = simple->flags;
+                m.timeOn = simple->timeOn;
+                m.timeOff = simple->timeOff;
+                m.firstPath = static_cast<uint32_t>(paths.size());
+                m.numPaths = static_cast<uint32_t>(simple->paths.size());
+                for (const auto& path : simple->paths) {
+                    CachedPath p{};
+                    p.type = static_cast<uint32_t>(path.type);
+                    p.id = path.ID;
+                    p.modelName = writer.string(path.modelName);
+                    p.firstNode = static_cast<uint32_t>(nodes.size());
+                    p.numNodes = static_cast<uint32_t>(path.nodes.size());
+                    for (const auto& node : path.nodes) {
+                        CachedPathNode n{};
+                        n.type = static_cast<uint32_t>(node.type);
+                        n.next = node.next;
+                        copyVec3(n.position, node.position);
+                        n.size = node.size;
+                        n.leftLanes = node.leftLanes;
+                        n.rightLanes = node.rightLanes;
+                        nodes.push_back(n);
+                    }
+                    paths.push_back(p);
+                }
+                break;
+            }
+            case ModelDataType::VehicleInfo: {
+                auto car = static_cast<VehicleModelInfo*>(object.get());
+                m.vehicleType = static_cast<uint32_t>(car->vehicletype_);
+                if (car->vehicletype_ == VehicleModelInfo::CAR) {
+                    m.wheelModel = car->wheelmodel_;
+                    m.wheelScale = car->wheelscale_;
+                }
+                m.handling = writer.string(car->handling_);
+                m.vehicleName = writer.string(car->vehiclename_);
+                m.vehicleClass = static_cast<uint32_t>(car->vehicleclass_);
+                m.frequency = car->frequency_;
+                m.level = car->level_;
+                m.componentRules =
+                    static_cast<uint32_t>(car->componentrules_);
+                break;
+            }
+            case ModelDataType::PedInfo: {
+                auto ped = static_cast<PedModelInfo*>(object.get());
+                m.pedType = static_cast<uint32_t>(ped->pedtype_);
+                m.behaviour = writer.string(findStatName(ped->statindex_));
+                m.animGroup = writer.string(ped->animgroup_);
+                m.carsMask = ped->carsmask_;
+                break;
+            }
+            case ModelDataType::ClumpInfo:
+                break;
+            default:
+                // Unknown types can't be restored, don't cache the file
+                return false;
+        }
+        models.push_back(m);
+    }
+
+    writer.table(models);
+    writer.table(paths);
+    writer.table(nodes);
+    return writer.write(getCachePath(source, Kind::IDE), Kind::IDE, info);
+}
+
+bool LoaderCache::loadIPL(const std::string& source, LoaderIPL& ipl) const {
+    SourceInfo info;
+    if (!isEnabled() || !readSourceInfo(source, info)) {
+        return false;
+    }
+
+    CacheReader reader;
+    std::vector<CachedInstance> instances;
+    std::vector<CachedZone> zones;
+    if (!reader.open(getCachePath(source, Kind::IPL), Kind::IPL, info) ||
+        !reader.table(instances) || !reader.table(zones) ||
+        !reader.strings()) {
+        return false;
+    }
+
+    ipl.m_instances.reserve(ipl.m_instances.size() + instances.size());
+    for (const auto& i : instances) {
+        ipl.m_instances.push_back(std::make_shared<InstanceData>(
+            i.id, reader.string(i.model), toVec3(i.pos), toVec3(i.scale),
+            glm::quat(i.rot[0], i.rot[1], i.rot[2], i.rot[3])));
+    }
+
+    for (const auto& z : zones) {
+        ZoneData zone;
+        zone.name = reader.string(z.name);
+        zone.type = z.type;
+        zone.min = toVec3(z.min);
+        zone.max = toVec3(z.max);
+        zone.island = z.island;
+        ipl.zones.push_back(std::move(zone));
+    }
+
+    return true;
+}
+
+bool LoaderCache::storeIPL(const std::string& source,
+                           const LoaderIPL& ipl) const {
+    SourceInfo info;
+    if (!isEnabled() || !readSourceInfo(source, info)) {
+        return false;
+    }
+
+    CacheWriter writer;
+    std::vector<CachedInstance> instances;
+    instances.reserve(ipl.m_instances.size());
+    for (const auto& inst : ipl.m_instances) {
+        CachedInstance i{};
+        i.id = inst->id;
+        i.model = writer.string(inst->model);
+        copyVec3(i.pos, inst->pos);
+        copyVec3(i.scale, inst->scale);
+        i.rot[0] = inst->rot.w;
+        i.rot[1] = inst->rot.x;
+        i.rot[2] = inst->rot.y;
+        i.rot[3] = inst->rot.z;
+        instances.push_back(i);
+    }
+
+    std::vector<CachedZone> zones;
+    zones.reserve(ipl.zones.size());
+    for (const auto& zone : ipl.zones) {
+        CachedZone z{};
+        z.name = writer.string(zone.name);
+        z.type = zone.type;
+        copyVec3(z.min, zone.min);
+        copyVec3(z.max, zone.max);
+        z.island = zone.island;
+        zones.push_back(z);
+    }
+
+    writer.table(instances);
+    writer.table(zones);
+    return writer.write(getCachePath(source, Kind::IPL), Kind::IPL, info);
+}
+
+bool LoaderCache::loadCOL(const std::string& source, LoaderCOL& col) const {
+    SourceInfo info;
+    if (!isEnabled() || !readSourceInfo(source, info)) {
+        return false;
+    }
+
+    CacheReader reader;
+    std::vector<CachedCollision> models;
+    std::vector<CachedSphere> spheres;
+    std::vector<CachedBox> boxes;
+    std::vector<CachedVertex> vertices;
+    std::vector<CachedFace> faces;
+    if (!reader.open(getCachePath(source, Kind::COL), Kind::COL, info) ||
+        !reader.table(models) || !reader.table(spheres) ||
+        !reader.table(boxes) || !reader.table(vertices) ||
+        !reader.table(faces) || !reader.strings()) {
+        return false;
+    }
+
+    std::vector<std::unique_ptr<CollisionModel>> collisions;
+    collisions.reserve(models.size());
+    for (const auto& c : models) {
+        if (!inRange(spheres, c.firstSphere, c.numSpheres) ||
+            !inRange(boxes, c.firstBox, c.numBoxes) ||
+            !inRange(vertices, c.firstVertex, c.numVertices) ||
+            !inRange(faces, c.firstFace, c.numFaces)) {
+            return false;
+        }
+
+        auto model = std::make_unique<CollisionModel>();
+        model->name = reader.string(c.name);
+        model->modelid = static_cast<uint16_t>(c.modelid);
+        model->boundingSphere.center = toVec3(c.sphereCenter);
+        model->boundingSphere.radius = c.sphereRadius;
+        model->boundingSphere.surface = c.sphereSurface;
+        model->boundingBox.min = toVec3(c.boxMin);
+        model->boundingBox.max = toVec3(c.boxMax);
+        model->boundingBox.surface = c.boxSurface;
+
+        model->spheres.resize(c.numSpheres);
+        for (uint32_t i = 0; i < c.numSpheres; ++i) {
+            const auto& s = spheres[c.firstSphere + i];
+            model->spheres[i].center = toVec3(s.center);
+            model->spheres[i].radius = s.radius;
+            model->spheres[i].surface = s.surface;
+        }
+
+        model->boxes.resize(c.numBoxes);
+        for (uint32_t i = 0; i < c.numBoxes; ++i) {
+            const auto& b = boxes[c.firstBox + i];
+            model->boxes[i].min = toVec3(b.min);
+            model->boxes[i].max = toVec3(b.max);
+            model->boxes[i].surface = b.surface;
+        }
+
+        model->vertices.resize(c.numVertices);
+        for (uint32_t i = 0; i < c.numVertices; ++i) {
+            model->vertices[i] = toVec3(vertices[c.firstVertex + i].v);
+        }
+
+        model->faces.resize(c.numFaces);
+        for (uint32_t i = 0; i < c.numFaces; ++i) {
+            const auto& f = faces[c.firstFace + i];
+            std::copy(f.tri, f.tri + 3, model->faces[i].tri);
+            model->faces[i].surface = f.surface;
+        }
+
+        collisions.emplace_back(std::move(model));
+    }
+
+    std::move(collisions.begin(), collisions.end(),
+              std::back_inserter(col.collisions));
+    return true;
+}
+
+bool LoaderCache::storeCOL(const std::string& source,
+                           const LoaderCOL& col) const {
+    SourceInfo info;
+    if (!isEnabled() || !readSourceInfo(source, info)) {
+        return false;
+    }
+
+    CacheWriter writer;
+    std::vector<CachedCollision> models;
+    std::vector<CachedSphere> spheres;
+    std::vector<CachedBox> boxes;
+    std::vector<CachedVertex> vertices;
+    std::vector<CachedFace> faces;
+    models.reserve(col.collisions.size());
+
+    for (const auto& model : col.collisions) {
+        CachedCollision c{};
+        c.name = writer.string(model->name);
+        c.modelid = model->modelid;
+        copyVec3(c.sphereCenter, model->boundingSphere.center);
+        c.sphereRadius = model->boundingSphere.radius;
+        c.sphereSurface = model->boundingSphere.surface;
+        copyVec3(c.boxMin, model->boundingBox.min);
+        copyVec3(c.boxMax, model->boundingBox.max);
+        c.boxSurface = model->boundingBox.surface;
+
+        c.firstSphere = static_cast<uint32_t>(spheres.size());
+        c.numSpheres = static_cast<uint32_t>(model->spheres.size());
+        for (const auto& sphere : model->spheres) {
+            CachedSphere s{};
+            copyVec3(s.center, sphere.center);
+            s.radius = sphere.radius;
+            s.surface = sphere.surface;
+            spheres.push_back(s);
+        }
+
+        c.firstBox = static_cast<uint32_t>(boxes.size());
+        c.numBoxes = static_cast<uint32_t>(model->boxes.size());
+        for (const auto& box : model->boxes) {
+            CachedBox b{};
+            copyVec3(b.min, box.min);
+            copyVec3(b.max, box.max);
+            b.surface = box.surface;
+            boxes.push_back(b);
+        }
+
+        c.firstVertex = static_cast<uint32_t>(vertices.size());
+        c.numVertices = static_cast<uint32_t>(model->vertices.size());
+        for (const auto& vertex : model->vertices) {
+            CachedVertex v{};
+            copyVec3(v.v, vertex);
+            vertices.push_back(v);
+        }
+
+        c.firstFace = static_cast<uint32_t>(faces.size());
+        c.numFaces = static_cast<uint32_t>(model->faces.size());
+        for (const auto& face : model->faces) {
+            CachedFace f{};
+            std::copy(face.tri, face.tri + 3, f.tri);
+            f.surface = face.surface;
+            faces.push_back(f);
+        }
+
+        models.push_back(c);
+    }
+
+    writer.table(models);
+    writer.table(spheres);
+    writer.table(boxes);
+    writer.table(vertices);
+    writer.table(faces);
+    return writer.write(getCachePath(source, Kind::COL), Kind::COL, info);
+}
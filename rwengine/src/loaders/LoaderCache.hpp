@@ -0,0 +1,81 @@
+#ifndef _RWENGINE_LOADERCACHE_HPP_
+#define _RWENGINE_LOADERCACHE_HPP_
+
+#include <cstdint>
+#include <string>
+
+#include <rw/filesystem.hpp>
+
+#include <data/PedData.hpp>
+
+class LoaderCOL;
+class LoaderIDE;
+class LoaderIPL;
+
+/**
+ * @class LoaderCache
+ * Stores parsed IDE, IPL and COL files in a binary form.
+ *
+ * Each source file gets its own cache file in the cache directory. Cache
+ * files are a small header followed by flat little-endian tables of fixed
+ * size records and a string table, so reading one back is a handful of
+ * memcpys out of the mapped file instead of text parsing.
+ *
+ * A cache file is only used if its version matches and the size and hash of
+ * the source file are unchanged, otherwise the caller parses the source and
+ * stores a fresh cache file.
+ */
+class LoaderCache {
+public:
+    /// Increment when the layout of any cache file changes
+    static constexpr uint32_t kVersion = 1;
+
+    enum class Kind : uint32_t {
+        IDE = 1,
+        IPL = 2,
+        COL = 3,
+    };
+
+    /**
+     * @param cacheDir directory to store cache files in, an empty path
+     * disables caching.
+     */
+    explicit LoaderCache(rwfs::path cacheDir = {});
+
+    bool isEnabled() const {
+        return !cacheDir_.empty();
+    }
+
+    const rwfs::path& getCacheDirectory() const {
+        return cacheDir_;
+    }
+
+    /**
+     * Loads the cached contents of an IDE file
+     * @return true if a valid cache file was found
+     */
+    bool loadIDE(const std::string& source, const PedStatsList& stats,
+                 LoaderIDE& ide) const;
+
+    /**
+     * Writes the parsed contents of an IDE file to the cache
+     */
+    bool storeIDE(const std::string& source, const PedStatsList& stats,
+                  const LoaderIDE& ide) const;
+
+    bool loadIPL(const std::string& source, LoaderIPL& ipl) const;
+    bool storeIPL(const std::string& source, const LoaderIPL& ipl) const;
+
+    bool loadCOL(const std::string& source, LoaderCOL& col) const;
+    bool storeCOL(const std::string& source, const LoaderCOL& col) const;
+
+    /**
+     * @return the path of the cache file for the given source file
+     */
+    rwfs::path getCachePath(const std::string& source, Kind kind) const;
+
+private:
+    rwfs::path cacheDir_;
+};
+
+#endif
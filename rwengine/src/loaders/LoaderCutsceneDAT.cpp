@@ -13,12 +13,13 @@
 #include "platform/FileHandle.hpp"
 
 void LoaderCutsceneDAT::load(CutsceneTracks &tracks, const FileContentsInfo& file) {
-    std::string dataStr(file.data.get(), file.length);
+    std::string dataStr(file.data, file.length);
     std::stringstream ss(dataStr);
 
     int numZooms = 0;
     ss >> numZooms;
     ss.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    tracks.zoom.reserve(static_cast<size_t>(std::max(numZooms, 0)));
 
     for (int i = 0; i < numZooms; ++i) {
         std::string st, sz;
@@ -27,7 +28,7 @@ void LoaderCutsceneDAT::load(CutsceneTracks &tracks, const FileContentsInfo& fil
 
         float t = std::stof(st);
 
-        tracks.zoom[t] = std::stof(sz);
+        tracks.zoom.add(t, std::stof(sz));
         tracks.duration = std::max(t, tracks.duration);
 
         ss.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
@@ -38,6 +39,7 @@ void LoaderCutsceneDAT::load(CutsceneTracks &tracks, const FileContentsInfo& fil
     int numRotations = 0;
     ss >> numRotations;
     ss.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    tracks.rotation.reserve(static_cast<size_t>(std::max(numRotations, 0)));
 
     for (int i = 0; i < numRotations; ++i) {
         std::string st, sr;
@@ -46,7 +48,7 @@ void LoaderCutsceneDAT::load(CutsceneTracks &tracks, const FileContentsInfo& fil
 
         float t = std::stof(st);
 
-        tracks.rotation[t] = std::stof(sr);
+        tracks.rotation.add(t, std::stof(sr));
         tracks.duration = std::max(t, tracks.duration);
 
         ss.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
@@ -57,6 +59,7 @@ void LoaderCutsceneDAT::load(CutsceneTracks &tracks, const FileContentsInfo& fil
     int numPositions = 0;
     ss >> numPositions;
     ss.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    tracks.position.reserve(static_cast<size_t>(std::max(numPositions, 0)));
 
     for (int i = 0; i < numPositions; ++i) {
         std::string st, sx, sy, sz;
@@ -68,7 +71,7 @@ void LoaderCutsceneDAT::load(CutsceneTracks &tracks, const FileContentsInfo& fil
         float t = std::stof(st);
         glm::vec3 p{std::stof(sx), std::stof(sy), std::stof(sz)};
 
-        tracks.position[t] = p;
+        tracks.position.add(t, p);
         tracks.duration = std::max(t, tracks.duration);
 
         ss.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
@@ -79,6 +82,7 @@ void LoaderCutsceneDAT::load(CutsceneTracks &tracks, const FileContentsInfo& fil
     int numTargets = 0;
     ss >> numTargets;
     ss.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    tracks.target.reserve(static_cast<size_t>(std::max(numTargets, 0)));
 
     for (int i = 0; i < numTargets; ++i) {
         std::string st, sx, sy, sz;
@@ -90,7 +94,7 @@ void LoaderCutsceneDAT::load(CutsceneTracks &tracks, const FileContentsInfo& fil
         float t = std::stof(st);
         glm::vec3 p{std::stof(sx), std::stof(sy), std::stof(sz)};
 
-        tracks.target[t] = p;
+        tracks.target.add(t, p);
         tracks.duration = std::max(t, tracks.duration);
 
         ss.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
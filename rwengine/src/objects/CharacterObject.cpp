@@ -41,7 +41,7 @@ const float CharacterObject::DefaultJumpSpeed = 2.f;
 CharacterObject::CharacterObject(GameWorld* engine, const glm::vec3& pos,
                                  const glm::quat& rot, BaseModelInfo* modelinfo,
                                  ai::CharacterController* controller)
-    : GameObject(engine, pos, rot, modelinfo), controller(controller) {
+    : GameObject(engine, pos, rot, modelinfo, true), controller(controller) {
     auto info = getModelInfo<PedModelInfo>();
     setClump(info->getModel()->clone());
     if (info->getModel()) {
@@ -73,6 +73,7 @@ void CharacterObject::createActor(const glm::vec2& size) {
     if (getModel()) {
         btTransform tf;
         tf.setIdentity();
+        const auto position = getPosition();
         tf.setOrigin(btVector3(position.x, position.y, position.z));
 
         physObject = std::make_unique<btPairCachingGhostObject>();
@@ -313,8 +314,8 @@ void CharacterObject::tickPhysics(float dt) {
 
 void CharacterObject::setRotation(const glm::quat& orientation) {
     m_look.x = glm::roll(orientation);
-    rotation = orientation;
-    getClump()->getFrame()->setRotation(glm::mat3_cast(rotation));
+    storeRotation(orientation);
+    getClump()->getFrame()->setRotation(glm::mat3_cast(orientation));
 }
 
 void CharacterObject::changeCharacterModel(const std::string& name) {
@@ -359,10 +360,12 @@ void CharacterObject::updateCharacter(float dt) {
             if (!isStrafing()) {
                 yaw += std::atan2(movement.z, movement.x);
             }
-            rotation = glm::quat(glm::vec3(0.f, 0.f, yaw));
-            getClump()->getFrame()->setRotation(glm::mat3_cast(rotation));
+            storeRotation(glm::quat(glm::vec3(0.f, 0.f, yaw)));
+            getClump()->getFrame()->setRotation(
+                glm::mat3_cast(getRotation()));
         }
 
+        const auto rotation = getRotation();
         walkDir = rotation * walkDir;
 
         if (jumped) {
@@ -382,8 +385,8 @@ void CharacterObject::updateCharacter(float dt) {
 
         auto Pos =
             physCharacter->getGhostObject()->getWorldTransform().getOrigin();
-        position = glm::vec3(Pos.x(), Pos.y(), Pos.z());
-        getClump()->getFrame()->setTranslation(position);
+        storePosition(glm::vec3(Pos.x(), Pos.y(), Pos.z()));
+        getClump()->getFrame()->setTranslation(getPosition());
 
         // Handle above waist height water.
         auto wi = engine->data->getWaterIndexAt(getPosition());
@@ -437,7 +440,7 @@ void CharacterObject::setPosition(const glm::vec3& pos) {
         btVector3 bpos(realPos.x, realPos.y, realPos.z);
         physCharacter->warp(bpos);
     }
-    position = realPos;
+    storePosition(realPos);
     getClump()->getFrame()->setTranslation(pos);
 }
 
@@ -602,23 +605,10 @@ void CharacterObject::setJumpSpeed(float speed) {
 }
 
 void CharacterObject::resetToAINode() {
-    auto& nodes = engine->aigraph.nodes;
     bool vehicleNode = !!getCurrentVehicle();
-    ai::AIGraphNode* nearest = nullptr;
-    float d = std::numeric_limits<float>::max();
-    for (const auto& node : nodes) {
-        if (vehicleNode) {
-            if (node->type == ai::NodeType::Pedestrian) continue;
-        } else {
-            if (node->type == ai::NodeType::Vehicle) continue;
-        }
-
-        float dist = glm::length(node->position - getPosition());
-        if (dist < d) {
-            nearest = node.get();
-            d = dist;
-        }
-    }
+    ai::AIGraphNode* nearest = engine->aigraph.findNearestNode(
+        getPosition(),
+        vehicleNode ? ai::NodeType::Vehicle : ai::NodeType::Pedestrian);
 
     if (nearest) {
         if (vehicleNode) {
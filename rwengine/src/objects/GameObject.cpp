@@ -5,19 +5,48 @@
 #include <glm/gtc/matrix_transform.hpp>
 
 #include "engine/Animator.hpp"
+#include "engine/GameWorld.hpp"
+
+namespace {
+TransformStore& selectStore(GameWorld* engine, bool dynamic) {
+    if (!engine) {
+        return TransformStore::detached();
+    }
+    return dynamic ? engine->dynamicTransforms : engine->transforms;
+}
+}  // namespace
+
+GameObject::GameObject(GameWorld* engine, const glm::vec3& pos,
+                       const glm::quat& rot, BaseModelInfo* modelinfo)
+    : GameObject(engine, pos, rot, modelinfo, false) {
+}
+
+GameObject::GameObject(GameWorld* engine, const glm::vec3& pos,
+                       const glm::quat& rot, BaseModelInfo* modelinfo,
+                       bool dynamic)
+    : transforms_(&selectStore(engine, dynamic))
+    , transform_(transforms_->create(this, pos, rot))
+    , modelinfo_(modelinfo)
+    , engine(engine) {
+    if (modelinfo_) {
+        modelinfo_->addReference();
+    }
+}
 
 GameObject::~GameObject() {
     if (modelinfo_) {
         modelinfo_->removeReference();
     }
+    transforms_->destroy(transform_);
 }
 
 void GameObject::setPosition(const glm::vec3& pos) {
-    _lastPosition = position = pos;
+    storePosition(pos);
+    transforms_->setLastPosition(transform_, pos);
 }
 
 void GameObject::setRotation(const glm::quat& orientation) {
-    rotation = orientation;
+    storeRotation(orientation);
 }
 
 float GameObject::getHeading() const {
@@ -33,7 +62,7 @@ void GameObject::setHeading(float heading) {
 
 glm::mat4 GameObject::getTimeAdjustedTransform(float alpha) const {
     glm::mat4 t{1.0f};
-    t = glm::translate(t, glm::mix(_lastPosition, getPosition(), alpha));
-    t = t * glm::mat4_cast(glm::slerp(_lastRotation, getRotation(), alpha));
+    t = glm::translate(t, glm::mix(getLastPosition(), getPosition(), alpha));
+    t = t * glm::mat4_cast(glm::slerp(getLastRotation(), getRotation(), alpha));
     return t;
 }
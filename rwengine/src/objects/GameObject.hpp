@@ -12,6 +12,7 @@
 #include <data/ModelData.hpp>
 #include <engine/Animator.hpp>
 #include <objects/ObjectTypes.hpp>
+#include <objects/TransformStore.hpp>
 
 class GameWorld;
 
@@ -22,8 +23,9 @@ class GameWorld;
  * tracking used to make tunnels work.
  */
 class GameObject {
-    glm::vec3 _lastPosition;
-    glm::quat _lastRotation;
+    /// Holds the position and rotation, owned by the world
+    TransformStore* transforms_;
+    TransformStore::Handle transform_;
     GameObjectID objectID = 0;
 
     BaseModelInfo* modelinfo_;
@@ -38,10 +40,28 @@ protected:
         modelinfo_ = next;
     }
 
-public:
-    glm::vec3 position;
-    glm::quat rotation;
+    /**
+     * Writes the position without the side effects of setPosition
+     */
+    void storePosition(const glm::vec3& pos) {
+        transforms_->setPosition(transform_, pos);
+    }
 
+    /**
+     * Writes the rotation without the side effects of setRotation
+     */
+    void storeRotation(const glm::quat& rot) {
+        transforms_->setRotation(transform_, rot);
+    }
+
+    /**
+     * @param dynamic keep the transform in GameWorld::dynamicTransforms, for
+     * characters and vehicles
+     */
+    GameObject(GameWorld* engine, const glm::vec3& pos, const glm::quat& rot,
+               BaseModelInfo* modelinfo, bool dynamic);
+
+public:
     GameWorld* engine = nullptr;
 
     std::unique_ptr<Animator> animator;  /// Object's animator.
@@ -59,17 +79,10 @@ public:
     bool visible = true;
 
     GameObject(GameWorld* engine, const glm::vec3& pos, const glm::quat& rot,
-               BaseModelInfo* modelinfo)
-        : _lastPosition(pos)
-        , _lastRotation(rot)
-        , modelinfo_(modelinfo)
-        , position(pos)
-        , rotation(rot)
-        , engine(engine) {
-        if (modelinfo_) {
-            modelinfo_->addReference();
-        }
-    }
+               BaseModelInfo* modelinfo);
+
+    GameObject(const GameObject&) = delete;
+    GameObject& operator=(const GameObject&) = delete;
 
     virtual ~GameObject();
 
@@ -129,18 +142,34 @@ public:
 
     virtual void setPosition(const glm::vec3& pos);
 
-    const glm::vec3& getPosition() const {
-        return position;
+    /*
+     * The transform getters return copies, references into the store would
+     * be invalidated by creating an object
+     */
+    glm::vec3 getPosition() const {
+        return transforms_->getPosition(transform_);
     }
-    const glm::vec3& getLastPosition() const {
-        return _lastPosition;
+    glm::vec3 getLastPosition() const {
+        return transforms_->getLastPosition(transform_);
     }
 
-    const glm::quat& getRotation() const {
-        return rotation;
+    glm::quat getRotation() const {
+        return transforms_->getRotation(transform_);
+    }
+    glm::quat getLastRotation() const {
+        return transforms_->getLastRotation(transform_);
     }
     virtual void setRotation(const glm::quat& orientation);
 
+    /**
+     * @return the slot holding this object's transform in
+     * GameWorld::transforms, or GameWorld::dynamicTransforms for characters
+     * and vehicles
+     */
+    TransformStore::Handle getTransformHandle() const {
+        return transform_;
+    }
+
     float getHeading() const;
     /**
      * @brief setHeading Rotates the object to face heading, in degrees.
@@ -218,8 +247,8 @@ public:
      * @param newPos
      */
     void _updateLastTransform() {
-        _lastPosition = getPosition();
-        _lastRotation = getRotation();
+        transforms_->setLastPosition(transform_, getPosition());
+        transforms_->setLastRotation(transform_, getRotation());
     }
 
     glm::mat4 getTimeAdjustedTransform(float alpha) const;
@@ -243,10 +272,9 @@ public:
     }
 
     virtual void updateTransform(const glm::vec3& pos, const glm::quat& rot) {
-        _lastPosition = position;
-        _lastRotation = rotation;
-        position = pos;
-        rotation = rot;
+        _updateLastTransform();
+        storePosition(pos);
+        storeRotation(rot);
     }
 
 private:
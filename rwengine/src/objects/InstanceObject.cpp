@@ -53,7 +53,7 @@ InstanceObject::InstanceObject(GameWorld* engine, const glm::vec3& pos,
     if (modelinfo->type() == ModelDataType::SimpleInfo) {
         auto simpledata = static_cast<SimpleModelInfo*>(modelinfo);
         for (auto& path : simpledata->paths) {
-            engine->aigraph.createPathNodes(position, rot, path);
+            engine->aigraph.createPathNodes(getPosition(), rot, path);
         }
     }
 
@@ -156,7 +156,11 @@ void InstanceObject::changeModel(BaseModelInfo* incoming, int atomicNumber) {
             engine->data->loadModel(incoming->id());
         }
 
+        auto previous = getModelInfo<BaseModelInfo>();
         changeModelInfo(incoming);
+        if (previous && previous != incoming) {
+            engine->updateModelObject(this, previous->id());
+        }
         /// @todo this should only be temporary
         setModel(getModelInfo<SimpleModelInfo>()->getModel());
         auto collision = getModelInfo<SimpleModelInfo>()->getCollision();
@@ -273,8 +277,8 @@ void InstanceObject::setSolid(bool solid) {
 
 void InstanceObject::updateTransform(const glm::vec3& pos,
                                      const glm::quat& rot) {
-    position = pos;
-    rotation = rot;
+    storePosition(pos);
+    storeRotation(rot);
     getAtomic()->getFrame()->setRotation(glm::mat3_cast(rot));
     getAtomic()->getFrame()->setTranslation(pos);
 }
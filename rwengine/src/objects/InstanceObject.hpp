@@ -5,6 +5,7 @@
 
 #include <rw/forward.hpp>
 
+#include <cstdint>
 #include <memory>
 
 class BaseModelInfo;
@@ -33,6 +34,20 @@ public:
     std::unique_ptr<CollisionInstance> body;
     DynamicObjectData* dynamics;
 
+    /**
+     * Level of detail choices from when the instance was last drawn, -1
+     * before the first. ObjectRenderer only changes them once the camera is
+     * clearly past a LOD distance.
+     */
+    struct LodState {
+        /// Index of the atomic drawn
+        int8_t atomic = -1;
+        /// Closer than the largest LOD distance
+        int8_t inRange = -1;
+        /// A big building hidden in favour of its detailed model
+        int8_t replaced = -1;
+    } lod;
+
     InstanceObject(GameWorld* engine, const glm::vec3& pos,
                    const glm::quat& rot, const glm::vec3& scale,
                    BaseModelInfo* modelinfo,
@@ -64,7 +64,7 @@ void ProjectileObject::explode() {
         const float damageSize = 5.f;
         const float damage = static_cast<float>(_info.weapon->damage);
 
-        for (auto& o : engine->allObjects) {
+        for (auto o : engine->findObjectsInRadius(getPosition(), damageSize)) {
             if (o == this) continue;
             switch (o->type()) {
                 case GameObject::Instance:
@@ -168,10 +168,10 @@ void ProjectileObject::tick(float dt) {
     if (_body == nullptr) return;
 
     auto& bttr = _body->getWorldTransform();
-    position = {bttr.getOrigin().x(), bttr.getOrigin().y(),
-                bttr.getOrigin().z()};
+    storePosition({bttr.getOrigin().x(), bttr.getOrigin().y(),
+                   bttr.getOrigin().z()});
     auto r = bttr.getRotation();
-    rotation = {r.x(), r.y(), r.z(), r.w()};
+    storeRotation({r.x(), r.y(), r.z(), r.w()});
 
     _info.time -= dt;
 
@@ -0,0 +1,63 @@
+#include "objects/TransformStore.hpp"
+
+#include <glm/gtx/norm.hpp>
+
+#include <rw/debug.hpp>
+
+TransformStore::Handle TransformStore::create(GameObject* owner,
+                                              const glm::vec3& position,
+                                              const glm::quat& rotation) {
+    if (!freeSlots.empty()) {
+        const auto handle = freeSlots.back();
+        freeSlots.pop_back();
+        positions[handle] = lastPositions[handle] = position;
+        rotations[handle] = lastRotations[handle] = rotation;
+        owners[handle] = owner;
+        return handle;
+    }
+
+    // Copied first, position and rotation may be in the arrays
+    const auto p = position;
+    const auto r = rotation;
+    positions.push_back(p);
+    rotations.push_back(r);
+    lastPositions.push_back(p);
+    lastRotations.push_back(r);
+    owners.push_back(owner);
+    moved.push_back(0);
+    return static_cast<Handle>(owners.size() - 1);
+}
+
+void TransformStore::destroy(Handle handle) {
+    RW_CHECK(owners[handle] != nullptr, "Destroying a free transform");
+    owners[handle] = nullptr;
+    freeSlots.push_back(handle);
+}
+
+void TransformStore::saveLastTransforms() {
+    for (const auto handle : movedSlots) {
+        lastPositions[handle] = positions[handle];
+        lastRotations[handle] = rotations[handle];
+        moved[handle] = 0;
+    }
+    movedSlots.clear();
+}
+
+void TransformStore::findInRadius(const glm::vec3& center, float radius,
+                                  std::vector<GameObject*>& found) const {
+    // Only the slots that are close enough are touched
+    const float radius2 = radius * radius;
+    for (size_t i = 0; i < positions.size(); ++i) {
+        if (glm::distance2(center, positions[i]) > radius2) {
+            continue;
+        }
+        if (auto owner = owners[i]) {
+            found.push_back(owner);
+        }
+    }
+}
+
+TransformStore& TransformStore::detached() {
+    static TransformStore store;
+    return store;
+}
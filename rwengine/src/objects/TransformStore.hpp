@@ -0,0 +1,133 @@
+#ifndef _RWENGINE_TRANSFORMSTORE_HPP_
+#define _RWENGINE_TRANSFORMSTORE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <glm/gtc/quaternion.hpp>
+#include <glm/vec3.hpp>
+
+class GameObject;
+
+/**
+ * @brief Positions and rotations of objects, in one array per field
+ *
+ * Each object owns a slot, its handle stays valid until the object is
+ * destroyed. Freed slots are reused, so the arrays only grow to the most
+ * objects alive at once and loops over them skip the few free slots, which
+ * have no owner.
+ *
+ * References into the arrays are invalidated when a slot is created.
+ *
+ * Slots whose position or rotation is written are remembered, so the last
+ * transforms can be saved for just the objects that moved.
+ */
+class TransformStore {
+public:
+    using Handle = uint32_t;
+
+    Handle create(GameObject* owner, const glm::vec3& position,
+                  const glm::quat& rotation);
+
+    void destroy(Handle handle);
+
+    const glm::vec3& getPosition(Handle handle) const {
+        return positions[handle];
+    }
+
+    const glm::quat& getRotation(Handle handle) const {
+        return rotations[handle];
+    }
+
+    const glm::vec3& getLastPosition(Handle handle) const {
+        return lastPositions[handle];
+    }
+
+    const glm::quat& getLastRotation(Handle handle) const {
+        return lastRotations[handle];
+    }
+
+    void setPosition(Handle handle, const glm::vec3& position) {
+        positions[handle] = position;
+        markMoved(handle);
+    }
+
+    void setRotation(Handle handle, const glm::quat& rotation) {
+        rotations[handle] = rotation;
+        markMoved(handle);
+    }
+
+    void setLastPosition(Handle handle, const glm::vec3& position) {
+        lastPositions[handle] = position;
+    }
+
+    void setLastRotation(Handle handle, const glm::quat& rotation) {
+        lastRotations[handle] = rotation;
+    }
+
+    /**
+     * @return the number of slots, including free ones
+     */
+    size_t size() const {
+        return owners.size();
+    }
+
+    /**
+     * @return the positions of all slots, indexed by handle
+     */
+    const std::vector<glm::vec3>& getPositions() const {
+        return positions;
+    }
+
+    /**
+     * @return the object owning a slot, nullptr if the slot is free
+     */
+    GameObject* getOwner(Handle handle) const {
+        return owners[handle];
+    }
+
+    /**
+     * Copies the position and rotation of each slot written since the last
+     * call into its last position and rotation
+     */
+    void saveLastTransforms();
+
+    /**
+     * @return the number of slots written since saveLastTransforms()
+     */
+    size_t getMovedCount() const {
+        return movedSlots.size();
+    }
+
+    /**
+     * Appends the owners of the slots at most radius from center to found
+     */
+    void findInRadius(const glm::vec3& center, float radius,
+                      std::vector<GameObject*>& found) const;
+
+    /**
+     * Used by objects created without a world
+     */
+    static TransformStore& detached();
+
+private:
+    std::vector<glm::vec3> positions;
+    std::vector<glm::quat> rotations;
+    std::vector<glm::vec3> lastPositions;
+    std::vector<glm::quat> lastRotations;
+    std::vector<GameObject*> owners;
+    std::vector<Handle> freeSlots;
+    /// Slots written since saveLastTransforms, each listed once
+    std::vector<Handle> movedSlots;
+    std::vector<uint8_t> moved;
+
+    void markMoved(Handle handle) {
+        if (!moved[handle]) {
+            moved[handle] = 1;
+            movedSlots.push_back(handle);
+        }
+    }
+};
+
+#endif
@@ -98,7 +98,7 @@ VehicleObject::VehicleObject(GameWorld* engine, const glm::vec3& pos,
                              const glm::quat& rot, BaseModelInfo* modelinfo,
                              VehicleInfo* info, const glm::u8vec3& prim,
                              const glm::u8vec3& sec)
-    : GameObject(engine, pos, rot, modelinfo)
+    : GameObject(engine, pos, rot, modelinfo, true)
     , info(info)
     , colourPrimary(prim)
     , colourSecondary(sec)
@@ -273,6 +273,7 @@ void VehicleObject::setPosition(const glm::vec3& pos) {
     GameObject::setPosition(pos);
     getClump()->getFrame()->setTranslation(pos);
     if (collision->getBulletBody()) {
+        const auto position = getPosition();
         auto bodyOrigin = btVector3(position.x, position.y, position.z);
         for (auto& part : dynamicParts) {
             if (part.second.body == nullptr) continue;
@@ -312,8 +313,8 @@ void VehicleObject::setRotation(const glm::quat& orientation) {
 
 void VehicleObject::updateTransform(const glm::vec3& pos,
                                     const glm::quat& rot) {
-    position = pos;
-    rotation = rot;
+    storePosition(pos);
+    storeRotation(rot);
     getClump()->getFrame()->setRotation(glm::mat3_cast(rot));
     getClump()->getFrame()->setTranslation(pos);
 }
@@ -15,6 +15,7 @@
 #include <data/Clump.hpp>
 #include <gl/DrawBuffer.hpp>
 #include <gl/GeometryBuffer.hpp>
+#include <gl/Headless.hpp>
 #include <gl/gl_core_3_3.h>
 #include <rw/debug.hpp>
 
@@ -22,6 +23,11 @@
 
 DebugDraw::DebugDraw() {
     dbuff->setFaceType(GL_LINES);
+    maxlines = 0;
+
+    if (gl::isHeadless()) {
+        return;
+    }
 
     glGenTextures(1, &texture);
 
@@ -32,8 +38,6 @@ DebugDraw::DebugDraw() {
                  &img);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-    maxlines = 0;
 }
 
 void DebugDraw::drawLine(const btVector3 &from, const btVector3 &to,
@@ -59,7 +59,7 @@ protected:
     //Ownership is handled by worldProg in renderer
     Renderer::ShaderProgram *shaderProgram = nullptr;
 
-    GLuint texture;
+    GLuint texture = 0;
 };
 
 #endif
@@ -11,9 +11,11 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/quaternion.hpp>
 
+#include <gl/Headless.hpp>
 #include <gl/TextureData.hpp>
 #include <rw/types.hpp>
 
+#include "core/FrameStats.hpp"
 #include "core/Logger.hpp"
 #include "core/Profiler.hpp"
 #include "engine/GameData.hpp"
@@ -21,12 +23,17 @@
 #include "engine/GameWorld.hpp"
 #include "loaders/WeatherLoader.hpp"
 #include "objects/GameObject.hpp"
+#include "objects/InstanceObject.hpp"
 #include "render/ObjectRenderer.hpp"
 #include "render/GameShaders.hpp"
+#include "render/NullRenderer.hpp"
 #include "render/VisualFX.hpp"
 
 constexpr size_t skydomeSegments = 8, skydomeRows = 10;
 
+/// Occluders drawn into the occlusion buffer each frame
+constexpr size_t kMaxOccluders = 32;
+
 /// @todo collapse all of these into "VertPNC" etc.
 struct ParticleVert {
     static const AttributeList vertex_attributes() {
@@ -73,6 +80,16 @@ GameRenderer::GameRenderer(Logger* log, GameData* _data)
         renderer->createShader(GameShaders::DefaultPostProcess::VertexShader,
                                GameShaders::DefaultPostProcess::FragmentShader);
 
+    ssRectProg =
+        renderer->createShader(GameShaders::ScreenSpaceRect::VertexShader,
+                               GameShaders::ScreenSpaceRect::FragmentShader);
+    renderer->setUniform(ssRectProg.get(), "texture", 0);
+
+    // Everything below sets up GL objects that are only used for drawing
+    if (gl::isHeadless()) {
+        return;
+    }
+
     glGenVertexArrays(1, &vao);
 
     glGenFramebuffers(1, &framebufferName);
@@ -158,15 +175,19 @@ GameRenderer::GameRenderer(Logger* log, GameData* _data)
     ssRectGeom.uploadVertices<VertexP2>({{-1.f, -1.f}, {1.f, -1.f}, {-1.f, 1.f}, {1.f, 1.f}});
     ssRectDraw.addGeometry(&ssRectGeom);
     ssRectDraw.setFaceType(GL_TRIANGLE_STRIP);
-
-    ssRectProg =
-        renderer->createShader(GameShaders::ScreenSpaceRect::VertexShader,
-                               GameShaders::ScreenSpaceRect::FragmentShader);
-    renderer->setUniform(ssRectProg.get(), "texture", 0);
 }
 
 GameRenderer::~GameRenderer() {
-    glDeleteFramebuffers(1, &framebufferName);
+    if (framebufferName != 0) {
+        glDeleteFramebuffers(1, &framebufferName);
+    }
+}
+
+std::unique_ptr<Renderer> GameRenderer::createRenderer() {
+    if (gl::isHeadless()) {
+        return std::make_unique<NullRenderer>();
+    }
+    return std::make_unique<OpenGLRenderer>();
 }
 
 void GameRenderer::setupRender() {
@@ -234,6 +255,7 @@ void GameRenderer::renderWorld(GameWorld* world, const ViewCamera& camera,
     }
 
     culled = 0;
+    occluded = 0;
 
     renderObjects(world);
 
@@ -301,23 +323,70 @@ void GameRenderer::renderObjects(const GameWorld *world) {
 
     renderer->pushDebugGroup("Objects");
     renderer->pushDebugGroup("RenderList");
-    renderer->drawBatched(renderList);
+    {
+        RW_FRAME_SECTION(DrawBatched);
+        renderer->drawBatched(renderList);
+    }
 
     renderer->popDebugGroup();
     profObjects = renderer->popDebugGroup();
 }
 
+void GameRenderer::prepareOcclusion(const GameWorld *world,
+                                    ViewCamera &camera) {
+    RW_PROFILE_SCOPE(__func__);
+    occlusion.clear(camera.frustum.projection() * camera.getView(),
+                    camera.frustum.near);
+
+    // Buildings that were big on screen last frame are most likely still
+    // in front of the camera
+    const auto count = std::min(occluderCandidates.size(), kMaxOccluders);
+    std::partial_sort(occluderCandidates.begin(),
+                      occluderCandidates.begin() + count,
+                      occluderCandidates.end(),
+                      [](const ObjectRenderer::OccluderCandidate &a,
+                         const ObjectRenderer::OccluderCandidate &b) {
+                          return a.score > b.score;
+                      });
+
+    occluders.clear();
+    for (size_t i = 0; i < count; ++i) {
+        const auto id = occluderCandidates[i].id;
+        auto instance =
+            static_cast<InstanceObject *>(world->instancePool.find(id));
+        if (!instance) {
+            continue;
+        }
+        const auto collision = ObjectRenderer::getOccluderModel(*instance);
+        if (!collision) {
+            continue;
+        }
+        occlusion.addOccluder(*collision,
+                              instance->getTimeAdjustedTransform(1.f));
+        occluders.push_back(id);
+    }
+    std::sort(occluders.begin(), occluders.end());
+    occluderCandidates.clear();
+}
+
 RenderList GameRenderer::createObjectRenderList(const GameWorld *world) {
     RW_PROFILE_SCOPE(__func__);
+    RW_FRAME_SECTION(CreateRenderList);
     // This is sequential at the moment, it should be easy to make it
     // run in parallel with a good threading system.
     RenderList renderList;
     // Naive optimisation, assume 50% hitrate
     renderList.reserve(static_cast<size_t>(world->allObjects.size() * 0.5f));
 
-    ObjectRenderer objectRenderer(_renderWorld,
-                                  (cullOverride ? cullingCamera : _camera),
-                                  _renderAlpha);
+    auto &camera = cullOverride ? cullingCamera : _camera;
+    ObjectRenderer objectRenderer(_renderWorld, camera, _renderAlpha);
+    objectRenderer.setLodBias(lodBias);
+
+    if (occlusionCulling) {
+        prepareOcclusion(world, camera);
+        objectRenderer.setOcclusion(&occlusion, &occluders,
+                                    &occluderCandidates);
+    }
 
     // World Objects
     for (auto object : world->allObjects) {
@@ -363,6 +432,7 @@ RenderList GameRenderer::createObjectRenderList(const GameWorld *world) {
         objectRenderer.renderClump(arrowModel.get(), model, nullptr, renderList);
     }
     culled += objectRenderer.culled;
+    occluded += objectRenderer.occluded;
 
     RW_PROFILE_SCOPE("sortRenderList");
     // Also parallelizable
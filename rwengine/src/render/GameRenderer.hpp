@@ -1,8 +1,10 @@
 #ifndef _RWENGINE_GAMERENDERER_HPP_
 #define _RWENGINE_GAMERENDERER_HPP_
 
+#include <algorithm>
 #include <cstddef>
 #include <memory>
+#include <vector>
 
 #include <gl/DrawBuffer.hpp>
 #include <gl/GeometryBuffer.hpp>
@@ -11,6 +13,8 @@
 
 #include <render/OpenGLRenderer.hpp>
 #include <render/MapRenderer.hpp>
+#include <render/ObjectRenderer.hpp>
+#include <render/OcclusionBuffer.hpp>
 #include <render/TextRenderer.hpp>
 #include <render/ViewCamera.hpp>
 #include <render/WaterRenderer.hpp>
@@ -34,7 +38,7 @@ class GameRenderer {
     Logger* logger;
 
     /** The low-level drawing interface to use */
-    std::unique_ptr<Renderer> renderer = std::make_unique<OpenGLRenderer>();
+    std::unique_ptr<Renderer> renderer = createRenderer();
 
     // Temporary variables used during rendering
     float _renderAlpha{0.f};
@@ -51,9 +55,24 @@ class GameRenderer {
     /** Number of culling events */
     size_t culled;
 
-    GLuint framebufferName;
-    GLuint fbTextures[2];
-    GLuint fbRenderBuffers[1];
+    /**
+     * Occlusion culling, the best occluders seen in a frame are drawn into
+     * the occlusion buffer at the start of the next.
+     */
+    bool occlusionCulling = true;
+    OcclusionBuffer occlusion;
+    std::vector<GameObjectID> occluders;
+    std::vector<ObjectRenderer::OccluderCandidate> occluderCandidates;
+
+    /** Number of objects hidden by occluders */
+    size_t occluded = 0;
+
+    /** Scales LOD and draw distances */
+    float lodBias = 1.f;
+
+    GLuint framebufferName = 0;
+    GLuint fbTextures[2]{};
+    GLuint fbRenderBuffers[1]{};
     std::unique_ptr<Renderer::ShaderProgram> postProg;
 
     GeometryBuffer particleGeom;
@@ -62,7 +81,13 @@ class GameRenderer {
     GeometryBuffer ssRectGeom;
     DrawBuffer ssRectDraw;
 
+    /** @return a NullRenderer in headless mode, else an OpenGLRenderer */
+    static std::unique_ptr<Renderer> createRenderer();
+
 public:
+    /** Smallest LOD bias, below it very little would be drawn */
+    static constexpr float kMinLodBias = 0.1f;
+
     GameRenderer(Logger* log, GameData* data);
     ~GameRenderer();
 
@@ -85,6 +110,38 @@ public:
         return culled;
     }
 
+    size_t getOccludedCount() const {
+        return occluded;
+    }
+
+    /** @return number of occluders drawn into the last frame's buffer */
+    size_t getOccluderCount() const {
+        return occluders.size();
+    }
+
+    /**
+     * @brief setLodBias trades detail for speed
+     * @param bias multiplies the distances where objects change their
+     * level of detail and stop being drawn
+     */
+    void setLodBias(float bias) {
+        lodBias = std::max(bias, kMinLodBias);
+    }
+
+    float getLodBias() const {
+        return lodBias;
+    }
+
+    void setOcclusionCulling(bool enabled) {
+        occlusionCulling = enabled;
+        occluders.clear();
+        occluderCandidates.clear();
+    }
+
+    bool getOcclusionCulling() const {
+        return occlusionCulling;
+    }
+
     /**
      * Renders the world using the parameters of the passed Camera.
      * Note: The camera's near and far planes are overriden by weather effects.
@@ -165,6 +222,9 @@ private:
     void renderObjects(const GameWorld *world);
 
     RenderList createObjectRenderList(const GameWorld *world);
+
+    /** Draws the last frame's best occluder candidates into occlusion */
+    void prepareOcclusion(const GameWorld *world, ViewCamera &camera);
 };
 
 #endif
@@ -0,0 +1,38 @@
+#include "render/NullRenderer.hpp"
+
+#include <rw/debug.hpp>
+
+std::string NullRenderer::getIDString() const {
+    return "Null (headless)";
+}
+
+std::unique_ptr<Renderer::ShaderProgram> NullRenderer::createShader(
+    const std::string& vert, const std::string& frag) {
+    RW_UNUSED(vert);
+    RW_UNUSED(frag);
+    return std::make_unique<NullShaderProgram>();
+}
+
+void NullRenderer::setSceneParameters(const SceneUniformData& data) {
+    lastSceneData = data;
+}
+
+void NullRenderer::draw(const glm::mat4& model, DrawBuffer* draw,
+                        const DrawParameters& p) {
+    RW_UNUSED(model);
+    RW_UNUSED(draw);
+    RW_UNUSED(p);
+    drawCounter++;
+}
+
+void NullRenderer::drawArrays(const glm::mat4& model, DrawBuffer* draw,
+                              const DrawParameters& p) {
+    RW_UNUSED(model);
+    RW_UNUSED(draw);
+    RW_UNUSED(p);
+    drawCounter++;
+}
+
+void NullRenderer::drawBatched(const RenderList& list) {
+    drawCounter += static_cast<int>(list.size());
+}
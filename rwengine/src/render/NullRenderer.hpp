@@ -0,0 +1,78 @@
+#ifndef _RWENGINE_NULLRENDERER_HPP_
+#define _RWENGINE_NULLRENDERER_HPP_
+
+#include <memory>
+#include <string>
+
+#include <render/OpenGLRenderer.hpp>
+
+/**
+ * @class NullRenderer
+ * Renderer that accepts everything and draws nothing.
+ *
+ * Used in headless mode, where there is no GL context. Draws are still
+ * counted so the per-frame statistics stay meaningful.
+ */
+class NullRenderer final : public Renderer {
+public:
+    class NullShaderProgram final : public ShaderProgram {
+    public:
+        ~NullShaderProgram() override = default;
+    };
+
+    ~NullRenderer() override = default;
+
+    std::string getIDString() const override;
+
+    std::unique_ptr<ShaderProgram> createShader(
+        const std::string& vert, const std::string& frag) override;
+    void setProgramBlockBinding(ShaderProgram*, const std::string&,
+                                GLint) override {
+    }
+    void setUniformTexture(ShaderProgram*, const std::string&,
+                           GLint) override {
+    }
+    void setUniform(ShaderProgram*, const std::string&,
+                    const glm::mat4&) override {
+    }
+    void setUniform(ShaderProgram*, const std::string&,
+                    const glm::vec4&) override {
+    }
+    void setUniform(ShaderProgram*, const std::string&,
+                    const glm::vec3&) override {
+    }
+    void setUniform(ShaderProgram*, const std::string&,
+                    const glm::vec2&) override {
+    }
+    void setUniform(ShaderProgram*, const std::string&, float) override {
+    }
+    void useProgram(ShaderProgram*) override {
+    }
+
+    void clear(const glm::vec4&, bool = true, bool = true) override {
+    }
+
+    void setSceneParameters(const SceneUniformData& data) override;
+
+    void draw(const glm::mat4& model, DrawBuffer* draw,
+              const DrawParameters& p) override;
+    void drawArrays(const glm::mat4& model, DrawBuffer* draw,
+                    const DrawParameters& p) override;
+
+    void drawBatched(const RenderList& list) override;
+
+    void invalidate() override {
+    }
+
+    void pushDebugGroup(const std::string&) override {
+    }
+
+    const ProfileInfo& popDebugGroup() override {
+        return profileInfo;
+    }
+
+private:
+    ProfileInfo profileInfo{};
+};
+
+#endif
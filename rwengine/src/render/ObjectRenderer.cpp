@@ -1,5 +1,6 @@
 #include "render/ObjectRenderer.hpp"
 
+#include <algorithm>
 #include <cstdint>
 
 #include <BulletDynamics/Vehicle/btRaycastVehicle.h>
@@ -7,11 +8,13 @@
 
 #include <data/Clump.hpp>
 
+#include "data/CollisionModel.hpp"
 #include "data/CutsceneData.hpp"
 #include "data/WeaponData.hpp"
 #include "engine/GameData.hpp"
 #include "engine/GameState.hpp"
 #include "engine/GameWorld.hpp"
+#include "render/OcclusionBuffer.hpp"
 #include "render/ViewCamera.hpp"
 
 // Objects that we know how to turn into renderlist entries
@@ -34,6 +37,36 @@ constexpr float kPedestrianDrawDistanceFactor = kDrawDistanceFactor;
 constexpr float kMagicLODDistance = 330.f;
 constexpr float kVehicleLODDistance = 70.f;
 constexpr float kVehicleDrawDistance = 280.f;
+/// Smallest collision bounding radius of an occluder
+constexpr float kMinOccluderRadius = 10.f;
+/// How far past a LOD distance, as a fraction of it, the camera has to be
+/// before the LOD changes
+constexpr float kLodHysteresis = 0.1f;
+
+namespace {
+/**
+ * @return distance < lodDistance, until the answer in state changes again
+ * the camera has to be clearly on the other side
+ */
+bool isWithinLodDistance(float distance, float lodDistance, int8_t& state) {
+    if (state >= 0) {
+        lodDistance *= state ? 1.f + kLodHysteresis : 1.f - kLodHysteresis;
+    }
+    state = distance < lodDistance ? 1 : 0;
+    return state != 0;
+}
+}  // namespace
+
+glm::mat4 ObjectRenderer::getInterpolationOffset(
+    const GameObject* object) const {
+    if (m_renderAlpha >= 1.f ||
+        (object->getLastPosition() == object->getPosition() &&
+         object->getLastRotation() == object->getRotation())) {
+        return glm::mat4(1.0f);
+    }
+    return object->getTimeAdjustedTransform(m_renderAlpha) *
+           glm::inverse(object->getTimeAdjustedTransform(1.f));
+}
 
 RenderKey createKey(float normalizedDepth, Renderer::Textures& textures) {
     return (uint32_t(0x7FFFFF * normalizedDepth) << 8 |
@@ -110,7 +143,39 @@ void ObjectRenderer::renderGeometry(Geometry* geom,
     }
 }
 
-void ObjectRenderer::renderAtomic(Atomic* atomic,
+const CollisionModel* ObjectRenderer::getOccluderModel(
+    const InstanceObject& instance) {
+    // Only solid buildings, anything that moves or can be seen through
+    // would hide things that aren't hidden
+    if (instance.dynamics || !instance.isVisible()) {
+        return nullptr;
+    }
+    auto modelinfo = instance.getModelInfo<SimpleModelInfo>();
+    constexpr int kSeeThrough = SimpleModelInfo::DRAW_LAST |
+                                SimpleModelInfo::ADDITIVE |
+                                SimpleModelInfo::NO_ZBUFFER_WRITE;
+    if (!modelinfo || (modelinfo->flags & kSeeThrough)) {
+        return nullptr;
+    }
+
+    // LOD models have no collision, use the detailed model's
+    const CollisionModel* collision = modelinfo->getCollision();
+    if (!collision && modelinfo->isBigBuilding() && modelinfo->related()) {
+        collision = modelinfo->related()->getCollision();
+    }
+    if (!collision || collision->boundingSphere.radius < kMinOccluderRadius) {
+        return nullptr;
+    }
+    return collision;
+}
+
+bool ObjectRenderer::isOccluder(const GameObject* object) const {
+    return object && m_occluders && object->type() == GameObject::Instance &&
+           std::binary_search(m_occluders->begin(), m_occluders->end(),
+                              object->getGameObjectID());
+}
+
+bool ObjectRenderer::renderAtomic(Atomic* atomic,
                                   const glm::mat4& worldtransform,
                                   GameObject* object, RenderList& render) {
     RW_CHECK(atomic->getGeometry(), "Can't render an atomic without geometry");
@@ -126,10 +191,17 @@ void ObjectRenderer::renderAtomic(Atomic* atomic,
     glm::vec3 boundpos = bounds.center + glm::vec3(transform[3]);
     if (!m_camera.frustum.intersects(boundpos, bounds.radius)) {
         culled++;
-        return;
+        return false;
+    }
+
+    if (m_occlusion && !isOccluder(object) &&
+        m_occlusion->isOccluded(boundpos, bounds.radius)) {
+        occluded++;
+        return false;
     }
 
     renderGeometry(geometry.get(), transform, object, render);
+    return true;
 }
 
 void ObjectRenderer::renderClump(Clump* model, const glm::mat4& worldtransform,
@@ -170,17 +242,23 @@ void ObjectRenderer::renderInstance(InstanceObject* instance,
             return;
     }
 
-    float mindist = glm::length(instance->getPosition() - m_camera.position) /
-                    kDrawDistanceFactor;
+    const float distance =
+        glm::length(instance->getPosition() - m_camera.position);
+    const float mindist = distance / (kDrawDistanceFactor * m_lodBias);
+    auto& lod = instance->lod;
 
-    if (mindist > modelinfo->getLargestLodDistance()) {
+    if (!isWithinLodDistance(mindist, modelinfo->getLargestLodDistance(),
+                             lod.inRange)) {
         culled++;
         return;
     }
 
+    // Big buildings are replaced by their detailed model up close
     if (modelinfo->isBigBuilding() &&
-        mindist < modelinfo->getNearLodDistance() &&
-        mindist < kMagicLODDistance) {
+        isWithinLodDistance(mindist,
+                            std::min(modelinfo->getNearLodDistance(),
+                                     kMagicLODDistance),
+                            lod.replaced)) {
         auto related = modelinfo->related();
         if (!related || related->isLoaded()) {
             culled++;
@@ -188,8 +266,13 @@ void ObjectRenderer::renderInstance(InstanceObject* instance,
         }
     }
 
-    Atomic* distanceatomic =
-        modelinfo->getDistanceAtomic(mindist / kDrawDistanceFactor);
+    const auto index = modelinfo->getDistanceAtomicIndex(
+        mindist / kDrawDistanceFactor, lod.atomic, kLodHysteresis);
+    lod.atomic = static_cast<int8_t>(index);
+    if (index >= modelinfo->getNumAtomics()) {
+        return;
+    }
+    Atomic* distanceatomic = modelinfo->getAtomic(index);
     if (!distanceatomic) {
         return;
     }
@@ -199,13 +282,28 @@ void ObjectRenderer::renderInstance(InstanceObject* instance,
     }
 
     // Render the atomic the instance thinks it should be
-    renderAtomic(atomic.get(), glm::mat4(1.0f), instance, outList);
+    if (!renderAtomic(atomic.get(), getInterpolationOffset(instance), instance,
+                      outList)) {
+        return;
+    }
+
+    // Large buildings near the camera hide the most in the next frame
+    if (m_occluderCandidates) {
+        const auto collision = getOccluderModel(*instance);
+        if (collision) {
+            m_occluderCandidates->push_back(
+                {collision->boundingSphere.radius / std::max(distance, 1.f),
+                 instance->getGameObjectID()});
+        }
+    }
 }
 
 void ObjectRenderer::renderCharacter(CharacterObject* pedestrian,
                                      RenderList& outList) {
     const auto& clump = pedestrian->getClump();
 
+    auto offset = getInterpolationOffset(pedestrian);
+
     if (pedestrian->getCurrentVehicle()) {
         auto vehicle = pedestrian->getCurrentVehicle();
         const auto& vehicleclump = vehicle->getClump();
@@ -222,10 +320,11 @@ void ObjectRenderer::renderCharacter(CharacterObject* pedestrian,
                 clump->getFrame()->setTransform(matrixModel);
             }
         }
+        // Passengers move with their vehicle
+        offset = getInterpolationOffset(vehicle);
     }
 
-    renderClump(pedestrian->getClump().get(), glm::mat4(1.0f), nullptr,
-                outList);
+    renderClump(pedestrian->getClump().get(), offset, nullptr, outList);
 
     auto item = pedestrian->getActiveItem();
     const auto& weapon = pedestrian->engine->data->weaponData[item];
@@ -240,8 +339,8 @@ void ObjectRenderer::renderCharacter(CharacterObject* pedestrian,
             m_world->data->findModelInfo<SimpleModelInfo>(weapon.modelID);
         RW_CHECK(simple, "Failed to read modelinfo using " << weapon.modelID);
         auto itematomic = simple->getAtomic(0);
-        renderAtomic(itematomic, handFrame->getWorldTransform(), nullptr,
-                     outList);
+        renderAtomic(itematomic, offset * handFrame->getWorldTransform(),
+                     nullptr, outList);
     }
 }
 
@@ -254,19 +353,25 @@ void ObjectRenderer::renderVehicle(VehicleObject* vehicle,
     }
 
     float mindist = glm::length(vehicle->getPosition() - m_camera.position) /
-                    kVehicleDrawDistanceFactor;
+                    (kVehicleDrawDistanceFactor * m_lodBias);
     if (mindist > kVehicleDrawDistance) {
         culled++;
         return;
     }
 
     if (vehicle->getLowLOD() && vehicle->getHighLOD()) {
-        const bool highLOD = mindist < kVehicleLODDistance;
-        vehicle->getHighLOD()->setFlag(Atomic::ATOMIC_RENDER, highLOD);
+        auto highAtomic = vehicle->getHighLOD();
+        int8_t wasHigh =
+            (highAtomic->getFlags() & Atomic::ATOMIC_RENDER) ? 1 : 0;
+        const bool highLOD =
+            isWithinLodDistance(mindist, kVehicleLODDistance, wasHigh);
+        highAtomic->setFlag(Atomic::ATOMIC_RENDER, highLOD);
         vehicle->getLowLOD()->setFlag(Atomic::ATOMIC_RENDER, !highLOD);
     }
 
-    renderClump(clump.get(), glm::mat4(1.0f), vehicle, outList);
+    auto offset = getInterpolationOffset(vehicle);
+
+    renderClump(clump.get(), offset, vehicle, outList);
 
     auto modelinfo = vehicle->getVehicle();
     auto woi =
@@ -295,7 +400,7 @@ void ObjectRenderer::renderVehicle(VehicleObject* vehicle,
                 wi.m_wheelDirectionCS * wi.m_raycastInfo.m_suspensionLength);
         glm::mat4 wheelM{1.0f};
         t.getOpenGLMatrix(glm::value_ptr(wheelM));
-        wheelM = clump->getFrame()->getWorldTransform() * wheelM;
+        wheelM = offset * clump->getFrame()->getWorldTransform() * wheelM;
         wheelM = glm::scale(wheelM, glm::vec3(modelinfo->wheelscale_));
         if (wi.m_chassisConnectionPointCS.x() < 0.f) {
             wheelM = glm::scale(wheelM, glm::vec3(-1.f, 1.f, 1.f));
@@ -2,7 +2,9 @@
 #define _RWENGINE_OBJECTRENDERER_HPP_
 
 #include <cstddef>
+#include <vector>
 
+#include "objects/ObjectTypes.hpp"
 #include "render/OpenGLRenderer.hpp"
 
 class Atomic;
@@ -12,10 +14,12 @@ class CutsceneObject;
 class GameObject;
 class GameWorld;
 class InstanceObject;
+class OcclusionBuffer;
 class PickupObject;
 class ProjectileObject;
 class VehicleObject;
 class ViewCamera;
+struct CollisionModel;
 struct Geometry;
 
 /**
@@ -33,12 +37,54 @@ public:
         , m_renderAlpha(renderAlpha) {
     }
 
+    /**
+     * A visible instance that could hide others in the next frame
+     */
+    struct OccluderCandidate {
+        /// Size on screen, larger is better
+        float score;
+        GameObjectID id;
+    };
+
+    /**
+     * @brief setOcclusion enables occlusion culling
+     * @param occlusion buffer with the occluders already drawn in
+     * @param occluders sorted ids of the instances drawn into occlusion,
+     * these are never tested against it
+     * @param candidates receives instances that should be occluders next
+     */
+    void setOcclusion(const OcclusionBuffer* occlusion,
+                      const std::vector<GameObjectID>* occluders,
+                      std::vector<OccluderCandidate>* candidates) {
+        m_occlusion = occlusion;
+        m_occluders = occluders;
+        m_occluderCandidates = candidates;
+    }
+
+    /**
+     * @brief setLodBias scales the distances where objects change their
+     * level of detail and stop being drawn
+     * @param bias larger than 1 for more detail, smaller for less
+     */
+    void setLodBias(float bias) {
+        m_lodBias = bias;
+    }
+
+    /**
+     * @return the collision model to draw into an OcclusionBuffer for the
+     * instance, or nullptr if it shouldn't be an occluder
+     */
+    static const CollisionModel* getOccluderModel(
+        const InstanceObject& instance);
+
     /**
      * @brief buildRenderList
      *
      * Exports rendering instructions for an object
      */
     size_t culled = 0;
+    /// Objects that were in the frustum but hidden by occluders
+    size_t occluded = 0;
     void buildRenderList(GameObject* object, RenderList& outList);
 
     void renderGeometry(Geometry* geom, const glm::mat4& modelMatrix,
@@ -50,8 +96,9 @@ public:
      * @param atomic
      * @param worldtransform
      * @param object
+     * @return false if the atomic was culled
      */
-    void renderAtomic(Atomic* atomic, const glm::mat4& worldtransform, GameObject* object, RenderList& render);
+    bool renderAtomic(Atomic* atomic, const glm::mat4& worldtransform, GameObject* object, RenderList& render);
 
     /**
      * @brief renderClump Renders all visible atomics in the clump
@@ -64,6 +111,13 @@ private:
     GameWorld* m_world;
     const ViewCamera& m_camera;
     float m_renderAlpha;
+    float m_lodBias = 1.f;
+
+    const OcclusionBuffer* m_occlusion = nullptr;
+    const std::vector<GameObjectID>* m_occluders = nullptr;
+    std::vector<OccluderCandidate>* m_occluderCandidates = nullptr;
+
+    bool isOccluder(const GameObject* object) const;
 
     void renderInstance(InstanceObject* instance, RenderList& outList);
     void renderCharacter(CharacterObject* pedestrian, RenderList& outList);
@@ -71,6 +125,13 @@ private:
     void renderPickup(PickupObject* pickup, RenderList& outList);
     void renderCutsceneObject(CutsceneObject* cutscene, RenderList& outList);
     void renderProjectile(ProjectileObject* projectile, RenderList& outList);
+
+    /**
+     * @brief Returns the transform that moves an object from its current
+     * simulated transform to where it should be drawn for the render alpha,
+     * between its last two simulated transforms.
+     */
+    glm::mat4 getInterpolationOffset(const GameObject* object) const;
 };
 
 #endif
@@ -0,0 +1,316 @@
+#include "render/OcclusionBuffer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+#include "data/CollisionModel.hpp"
+
+namespace {
+constexpr float kEmptyDepth = std::numeric_limits<float>::infinity();
+
+// Faces of a box with corners numbered by the bits xyz of max, wound
+// counter clockwise seen from outside
+constexpr int kBoxFaces[6][4] = {
+    {0, 1, 3, 2}, {4, 6, 7, 5}, {0, 4, 5, 1},
+    {2, 3, 7, 6}, {0, 2, 6, 4}, {1, 5, 7, 3},
+};
+
+glm::vec3 boxCorner(const glm::vec3& min, const glm::vec3& max, int corner) {
+    return glm::vec3((corner & 4) ? max.x : min.x, (corner & 2) ? max.y : min.y,
+                     (corner & 1) ? max.z : min.z);
+}
+
+struct ScreenPoint {
+    float x;
+    float y;
+};
+
+ScreenPoint toScreen(const glm::vec4& clip) {
+    const auto invW = 1.f / clip.w;
+    return {(clip.x * invW * 0.5f + 0.5f) * OcclusionBuffer::kWidth,
+            (clip.y * invW * 0.5f + 0.5f) * OcclusionBuffer::kHeight};
+}
+/**
+ * Finds the quad made of two triangles sharing an edge
+ * @return false if they don't share exactly one edge
+ */
+bool joinTriangles(const uint32_t (&first)[3], const uint32_t (&second)[3],
+                   uint32_t (&quad)[4]) {
+    // The vertex of second that isn't in first
+    int extra = -1;
+    for (int i = 0; i < 3; ++i) {
+        if (std::find(first, first + 3, second[i]) == first + 3) {
+            if (extra != -1) {
+                return false;
+            }
+            extra = i;
+        }
+    }
+    if (extra == -1) {
+        return false;
+    }
+
+    // Inserted between the shared vertices, after the one first doesn't
+    // share
+    for (int i = 0; i < 3; ++i) {
+        if (std::find(second, second + 3, first[i]) == second + 3) {
+            quad[0] = first[i];
+            quad[1] = first[(i + 1) % 3];
+            quad[2] = second[extra];
+            quad[3] = first[(i + 2) % 3];
+            return true;
+        }
+    }
+    return false;
+}
+
+// Clamped before the conversion, vertices just past the near plane can
+// project far outside of the int range
+int toPixel(float v, int size) {
+    return static_cast<int>(
+        std::min(std::max(v, -1.f), static_cast<float>(size + 1)));
+}
+}  // namespace
+
+OcclusionBuffer::OcclusionBuffer()
+    : depth_(static_cast<size_t>(kWidth * kHeight), kEmptyDepth) {
+}
+
+void OcclusionBuffer::clear(const glm::mat4& viewProjection, float near) {
+    viewProjection_ = viewProjection;
+    near_ = near;
+    triangles_ = 0;
+    std::fill(depth_.begin(), depth_.end(), kEmptyDepth);
+}
+
+void OcclusionBuffer::addOccluder(const CollisionModel& model,
+                                  const glm::mat4& transform) {
+    const auto mvp = viewProjection_ * transform;
+
+    for (const auto& box : model.boxes) {
+        glm::vec4 corners[8];
+        for (int c = 0; c < 8; ++c) {
+            corners[c] = mvp * glm::vec4(boxCorner(box.min, box.max, c), 1.f);
+        }
+        for (const auto& face : kBoxFaces) {
+            const glm::vec4 quad[4] = {corners[face[0]], corners[face[1]],
+                                       corners[face[2]], corners[face[3]]};
+            rasterize(quad, 4, true);
+        }
+    }
+
+    clipVertices_.clear();
+    for (const auto& vertex : model.vertices) {
+        clipVertices_.push_back(mvp * glm::vec4(vertex, 1.f));
+    }
+    const auto isValid = [&](const CollisionModel::Triangle& face) {
+        return face.tri[0] < clipVertices_.size() &&
+               face.tri[1] < clipVertices_.size() &&
+               face.tri[2] < clipVertices_.size();
+    };
+    const auto& faces = model.faces;
+    for (size_t f = 0; f < faces.size(); ++f) {
+        if (!isValid(faces[f])) {
+            continue;
+        }
+
+        // Meshes are mostly quads split in two, drawn whole there's no crack
+        // along the shared edge
+        uint32_t quad[4];
+        if (f + 1 < faces.size() && isValid(faces[f + 1]) &&
+            joinTriangles(faces[f].tri, faces[f + 1].tri, quad)) {
+            const glm::vec4 vertices[4] = {
+                clipVertices_[quad[0]], clipVertices_[quad[1]],
+                clipVertices_[quad[2]], clipVertices_[quad[3]]};
+            if (rasterize(vertices, 4, false)) {
+                f++;
+                continue;
+            }
+        }
+
+        const glm::vec4 vertices[3] = {clipVertices_[faces[f].tri[0]],
+                                       clipVertices_[faces[f].tri[1]],
+                                       clipVertices_[faces[f].tri[2]]};
+        rasterize(vertices, 3, false);
+    }
+}
+
+void OcclusionBuffer::addTriangle(const glm::vec3& a, const glm::vec3& b,
+                                  const glm::vec3& c) {
+    const glm::vec4 vertices[3] = {viewProjection_ * glm::vec4(a, 1.f),
+                                   viewProjection_ * glm::vec4(b, 1.f),
+                                   viewProjection_ * glm::vec4(c, 1.f)};
+    rasterize(vertices, 3, false);
+}
+
+void OcclusionBuffer::addQuad(const glm::vec3& a, const glm::vec3& b,
+                              const glm::vec3& c, const glm::vec3& d) {
+    const glm::vec4 vertices[4] = {viewProjection_ * glm::vec4(a, 1.f),
+                                   viewProjection_ * glm::vec4(b, 1.f),
+                                   viewProjection_ * glm::vec4(c, 1.f),
+                                   viewProjection_ * glm::vec4(d, 1.f)};
+    if (!rasterize(vertices, 4, false)) {
+        rasterize(vertices, 3, false);
+        const glm::vec4 second[3] = {vertices[0], vertices[2],
+                                     vertices[3]};
+        rasterize(second, 3, false);
+    }
+}
+
+bool OcclusionBuffer::rasterize(const glm::vec4* vertices, int count,
+                                bool cullBackFaces) {
+    ScreenPoint p[4];
+    auto depth = 0.f;
+    for (int i = 0; i < count; ++i) {
+        if (vertices[i].w <= near_) {
+            return true;
+        }
+        p[i] = toScreen(vertices[i]);
+        depth = std::max(depth, vertices[i].w);
+    }
+
+    // Collision meshes aren't wound consistently, unless the back faces
+    // are culled draw both and wind them all the same way
+    auto area = 0.f;
+    for (int i = 0; i < count; ++i) {
+        const auto& from = p[i];
+        const auto& to = p[(i + 1) % count];
+        area += from.x * to.y - to.x * from.y;
+    }
+    if (!(std::abs(area) > 0.f) || (cullBackFaces && area < 0.f)) {
+        return true;
+    }
+    if (area < 0.f) {
+        std::reverse(p, p + count);
+    }
+
+    // Rows are cut by every edge, which only works for convex polygons
+    for (int i = 0; i < count; ++i) {
+        const auto& a = p[i];
+        const auto& b = p[(i + 1) % count];
+        const auto& c = p[(i + 2) % count];
+        if ((b.x - a.x) * (c.y - b.y) - (b.y - a.y) * (c.x - b.x) < 0.f) {
+            return false;
+        }
+    }
+
+    auto minX = p[0].x;
+    auto maxX = p[0].x;
+    auto minY = p[0].y;
+    auto maxY = p[0].y;
+    for (int i = 1; i < count; ++i) {
+        minX = std::min(minX, p[i].x);
+        maxX = std::max(maxX, p[i].x);
+        minY = std::min(minY, p[i].y);
+        maxY = std::max(maxY, p[i].y);
+    }
+
+    // Only pixels that are covered entirely, an occluder must not hide
+    // anything just past its silhouette
+    const auto y0 = std::max(toPixel(std::ceil(minY), kHeight), 0);
+    const auto y1 =
+        std::min(toPixel(std::floor(maxY), kHeight) - 1, kHeight - 1);
+    const auto xMin = std::max(toPixel(std::ceil(minX), kWidth), 0);
+    const auto xMax =
+        std::min(toPixel(std::floor(maxX), kWidth) - 1, kWidth - 1);
+    if (y0 > y1 || xMin > xMax) {
+        return true;
+    }
+
+    triangles_ += static_cast<size_t>(count - 2);
+
+    for (int y = y0; y <= y1; ++y) {
+        // Intersect the row with the inside of each edge, at the top and
+        // bottom of the row so the pixel corners on both are inside
+        auto left = minX;
+        auto right = maxX;
+        bool outside = false;
+        for (int e = 0; e < count; ++e) {
+            const auto& from = p[e];
+            const auto& to = p[(e + 1) % count];
+            const auto slope = -(to.y - from.y);
+            for (int row = y; row <= y + 1; ++row) {
+                const auto offset =
+                    (to.x - from.x) * (static_cast<float>(row) - from.y) +
+                    (to.y - from.y) * from.x;
+                if (slope > 0.f) {
+                    left = std::max(left, -offset / slope);
+                } else if (slope < 0.f) {
+                    right = std::min(right, -offset / slope);
+                } else if (offset < 0.f) {
+                    outside = true;
+                }
+            }
+        }
+        if (outside) {
+            continue;
+        }
+
+        const auto x0 = std::max(toPixel(std::ceil(left), kWidth), xMin);
+        const auto x1 = std::min(toPixel(std::floor(right), kWidth) - 1, xMax);
+
+        // Kept simple enough for the compiler to vectorize
+        float* row = depth_.data() + y * kWidth;
+        for (int x = x0; x <= x1; ++x) {
+            row[x] = std::min(row[x], depth);
+        }
+    }
+    return true;
+}
+
+bool OcclusionBuffer::isOccluded(const glm::vec3& center,
+                                 float radius) const {
+    if (triangles_ == 0) {
+        return false;
+    }
+
+    const auto centerClip = viewProjection_ * glm::vec4(center, 1.f);
+    const auto nearest = centerClip.w - radius;
+    if (nearest <= near_) {
+        return false;
+    }
+
+    // Screen rectangle around the box containing the sphere
+    auto minX = std::numeric_limits<float>::max();
+    auto minY = minX;
+    auto maxX = std::numeric_limits<float>::lowest();
+    auto maxY = maxX;
+    const glm::vec3 extent(radius);
+    for (int c = 0; c < 8; ++c) {
+        const auto point = boxCorner(center - extent, center + extent, c);
+        const auto corner = viewProjection_ * glm::vec4(point, 1.f);
+        if (corner.w <= near_) {
+            return false;
+        }
+        const auto p = toScreen(corner);
+        minX = std::min(minX, p.x);
+        minY = std::min(minY, p.y);
+        maxX = std::max(maxX, p.x);
+        maxY = std::max(maxY, p.y);
+    }
+
+    // Every pixel the rectangle touches
+    const auto x0 = std::max(toPixel(std::floor(minX), kWidth), 0);
+    const auto y0 = std::max(toPixel(std::floor(minY), kHeight), 0);
+    const auto x1 = std::min(toPixel(std::ceil(maxX), kWidth) - 1, kWidth - 1);
+    const auto y1 =
+        std::min(toPixel(std::ceil(maxY), kHeight) - 1, kHeight - 1);
+    if (x0 > x1 || y0 > y1) {
+        // Off screen, that's for the frustum test to decide
+        return false;
+    }
+
+    for (int y = y0; y <= y1; ++y) {
+        const float* row = depth_.data() + y * kWidth;
+        bool visible = false;
+        for (int x = x0; x <= x1; ++x) {
+            visible |= row[x] >= nearest;
+        }
+        if (visible) {
+            return false;
+        }
+    }
+    return true;
+}
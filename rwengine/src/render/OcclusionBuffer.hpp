@@ -0,0 +1,104 @@
+#ifndef _RWENGINE_OCCLUSIONBUFFER_HPP_
+#define _RWENGINE_OCCLUSIONBUFFER_HPP_
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+#include <cstddef>
+#include <vector>
+
+struct CollisionModel;
+
+/**
+ * @brief Low resolution depth buffer for occlusion culling on the CPU
+ *
+ * Large occluders are rasterized into the buffer before the render list is
+ * built, then object bounds are tested against it. The buffer stores view
+ * depth, each triangle is written at the depth of its furthest vertex so
+ * that the buffer is never nearer than the occluder really is. Only the
+ * pixels a triangle covers entirely are written, so an occluder never hides
+ * anything peeking past its edges. Quads are drawn whole, split in two
+ * they'd leave a crack along the diagonal.
+ *
+ * Triangles crossing the near plane are skipped rather than clipped. That
+ * only loses occlusion, never adds it.
+ */
+class OcclusionBuffer {
+public:
+    static constexpr int kWidth = 256;
+    static constexpr int kHeight = 128;
+
+    OcclusionBuffer();
+
+    /**
+     * Empties the buffer and sets the camera used by the next occluders and
+     * tests
+     * @param viewProjection camera projection * view matrix
+     * @param near camera near plane distance
+     */
+    void clear(const glm::mat4& viewProjection, float near);
+
+    /**
+     * Rasterizes the boxes and triangles of model placed with transform
+     */
+    void addOccluder(const CollisionModel& model, const glm::mat4& transform);
+
+    /**
+     * Rasterizes a world space triangle
+     */
+    void addTriangle(const glm::vec3& a, const glm::vec3& b,
+                     const glm::vec3& c);
+
+    /**
+     * Rasterizes a world space quad, split in two if it isn't convex on
+     * screen
+     */
+    void addQuad(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c,
+                 const glm::vec3& d);
+
+    /**
+     * @return true if a sphere is entirely hidden behind the occluders
+     */
+    bool isOccluded(const glm::vec3& center, float radius) const;
+
+    /**
+     * @return true if nothing has been rasterized since clear()
+     */
+    bool empty() const {
+        return triangles_ == 0;
+    }
+
+    /**
+     * @return number of triangles rasterized since clear(), a quad counts
+     * as two
+     */
+    size_t getTriangleCount() const {
+        return triangles_;
+    }
+
+    /**
+     * @return view depth at a pixel, infinity where there's no occluder
+     */
+    float getDepth(int x, int y) const {
+        return depth_[static_cast<size_t>(y * kWidth + x)];
+    }
+
+private:
+    /**
+     * Rasterizes a triangle or quad given in clip space
+     * @return false if the polygon isn't convex on screen, nothing is drawn
+     */
+    bool rasterize(const glm::vec4* vertices, int count, bool cullBackFaces);
+
+    glm::mat4 viewProjection_{1.f};
+    float near_ = 0.f;
+    size_t triangles_ = 0;
+
+    std::vector<float> depth_;
+
+    /// Clip space vertices of the occluder being added
+    std::vector<glm::vec4> clipVertices_;
+};
+
+#endif
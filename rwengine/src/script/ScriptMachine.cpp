@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <cstdlib>
 #include <cstring>
+#include <iterator>
 
 #include "ai/PlayerController.hpp"
 #include "core/Logger.hpp"
@@ -35,7 +36,10 @@ void ScriptMachine::executeThread(SCMThread& t, int msPassed) {
     }
     if (t.wakeCounter > 0) return;
 
+    const bool profiling = profiler.isEnabled();
+
     while (t.wakeCounter == 0) {
+        const auto start = profiling ? ScriptProfiler::now() : 0;
         auto pc = t.programCounter;
         auto opcode = file.read<SCMOpcode>(pc);
 
@@ -149,6 +153,11 @@ void ScriptMachine::executeThread(SCMThread& t, int msPassed) {
             code.function(sca);
         }
 
+        if (profiling) {
+            profiler.record(opcode, code, t.name,
+                            ScriptProfiler::now() - start);
+        }
+
         if (isNegatedConditional) {
             t.conditionResult = !t.conditionResult;
         }
@@ -200,7 +209,7 @@ ScriptMachine::ScriptMachine(GameState* _state, SCMFile& file,
               globalData.begin());
 }
 
-void ScriptMachine::startThread(SCMThread::pc_t start, bool mission) {
+SCMThread& ScriptMachine::startThread(SCMThread::pc_t start, bool mission) {
     SCMThread t;
     for (int i = 0; i < SCM_THREAD_LOCAL_SIZE * SCM_VARIABLE_SIZE; ++i) {
         t.locals[i] = 0;
@@ -219,21 +228,138 @@ void ScriptMachine::startThread(SCMThread::pc_t start, bool mission) {
     t.wastedOrBusted = false;
     t.allowWaitSkip = false;
     _activeThreads.push_back(t);
+
+    // Runs this tick if started by a thread that is running
+    if (scheduled) {
+        awakeThreads.push_back(
+            {std::prev(_activeThreads.end()), nextOrder++, 0});
+    }
+    return _activeThreads.back();
+}
+
+std::list<SCMThread>& ScriptMachine::getThreads() {
+    unscheduleThreads();
+    return _activeThreads;
 }
 
 SCMByte* ScriptMachine::getGlobals() {
     return globalData.data();
 }
 
+namespace {
+struct WakesLater {
+    template <class Entry>
+    bool operator()(const Entry& a, const Entry& b) const {
+        return a.wakeTime > b.wakeTime;
+    }
+};
+
+struct RunsBefore {
+    template <class Entry>
+    bool operator()(const Entry& a, const Entry& b) const {
+        return a.order < b.order;
+    }
+};
+
+/// Threads that can be skipped until they're due
+bool canWait(const SCMThread& t) {
+    // Threads that allow skipping their wait are checked every tick
+    return t.wakeCounter > 0 && !t.allowWaitSkip && !t.finished;
+}
+}  // namespace
+
+void ScriptMachine::scheduleThreads(bool allowWaiting) {
+    awakeThreads.clear();
+    waitingThreads.clear();
+    nextOrder = 0;
+    for (auto it = _activeThreads.begin(); it != _activeThreads.end(); ++it) {
+        ScheduledThread entry{it, nextOrder++, 0};
+        if (allowWaiting && canWait(*it)) {
+            entry.wakeTime = time + static_cast<uint64_t>(it->wakeCounter);
+            waitingThreads.push_back(entry);
+        } else {
+            awakeThreads.push_back(entry);
+        }
+    }
+    std::make_heap(waitingThreads.begin(), waitingThreads.end(),
+                   WakesLater{});
+    scheduled = true;
+}
+
+void ScriptMachine::unscheduleThreads() {
+    if (!scheduled) {
+        return;
+    }
+    for (const auto& entry : waitingThreads) {
+        entry.thread->wakeCounter = static_cast<int>(entry.wakeTime - time);
+    }
+    awakeThreads.clear();
+    waitingThreads.clear();
+    scheduled = false;
+}
+
 void ScriptMachine::execute(float dt) {
     RW_PROFILE_SCOPEC(__func__, MP_ORANGERED);
     int ms = static_cast<int>(dt * 1000.f);
-    for (auto t = _activeThreads.begin(); t != _activeThreads.end(); ++t) {
-        auto& thread = *t;
-        executeThread(thread, ms);
 
-        if (thread.finished) {
-            t = _activeThreads.erase(t);
+    // Mission threads are reset when the player is wasted or busted, even
+    // while they wait, so every thread is visited
+    auto player = state->world->getPlayer();
+    if (player && (player->isWasted() || player->isBusted())) {
+        unscheduleThreads();
+        scheduleThreads(false);
+    } else if (!scheduled) {
+        scheduleThreads(true);
+    }
+
+    time += static_cast<uint64_t>(ms);
+
+    // Wake the threads that are due, they run in their usual place
+    const auto firstWoken = awakeThreads.size();
+    while (!waitingThreads.empty() &&
+           waitingThreads.front().wakeTime <= time) {
+        std::pop_heap(waitingThreads.begin(), waitingThreads.end(),
+                      WakesLater{});
+        awakeThreads.push_back(waitingThreads.back());
+        awakeThreads.back().thread->wakeCounter = 0;
+        waitingThreads.pop_back();
+    }
+    if (firstWoken != awakeThreads.size()) {
+        const auto woken = awakeThreads.begin() +
+                           static_cast<std::ptrdiff_t>(firstWoken);
+        std::sort(woken, awakeThreads.end(), RunsBefore{});
+        std::inplace_merge(awakeThreads.begin(), woken, awakeThreads.end(),
+                           RunsBefore{});
+    }
+
+    // Threads started while running are added to awakeThreads and run too
+    size_t kept = 0;
+    try {
+        for (size_t i = 0; scheduled && i < awakeThreads.size(); ++i) {
+            const auto entry = awakeThreads[i];
+            auto& thread = *entry.thread;
+            executeThread(thread, ms);
+
+            if (thread.finished) {
+                _activeThreads.erase(entry.thread);
+            } else if (!scheduled) {
+                // The threads were changed through getThreads()
+            } else if (canWait(thread)) {
+                waitingThreads.push_back(entry);
+                waitingThreads.back().wakeTime =
+                    time + static_cast<uint64_t>(thread.wakeCounter);
+                std::push_heap(waitingThreads.begin(), waitingThreads.end(),
+                               WakesLater{});
+            } else {
+                awakeThreads[kept++] = entry;
+            }
         }
+    } catch (...) {
+        unscheduleThreads();
+        throw;
+    }
+
+    if (scheduled) {
+        awakeThreads.resize(kept);
     }
 }
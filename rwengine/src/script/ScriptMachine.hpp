@@ -12,6 +12,7 @@
 #include <utility>
 #include <vector>
 
+#include <script/ScriptProfiler.hpp>
 #include <script/ScriptTypes.hpp>
 
 class GameState;
@@ -126,6 +127,10 @@ struct SCMThread {
  * by consuming the correct number of arguments, allowing the next instruction
  * to be found,
  * and then dispatching a call to the opcode's function.
+ *
+ * Threads that wait are kept in a queue ordered by wake time and aren't
+ * visited until they're due, the threads that do run each tick still run in
+ * the order they were started.
  */
 class ScriptMachine {
 public:
@@ -136,11 +141,18 @@ public:
         return file;
     }
 
-    void startThread(SCMThread::pc_t start, bool mission = false);
+    /**
+     * Starts a thread at start, it runs after the threads already running
+     * @return the new thread
+     */
+    SCMThread& startThread(SCMThread::pc_t start, bool mission = false);
 
-    std::list<SCMThread>& getThreads() {
-        return _activeThreads;
-    }
+    /**
+     * Brings the wake counters of waiting threads up to date and lets the
+     * threads be changed freely, the wait queue is rebuilt on the next
+     * execute. Not for use by opcodes, use startThread instead.
+     */
+    std::list<SCMThread>& getThreads();
 
     SCMByte* getGlobals();
     std::vector<SCMByte>& getGlobalData() {
@@ -164,6 +176,13 @@ public:
         debugFlag = flag;
     }
 
+    /**
+     * @return the per-opcode profiler, enable it to start recording
+     */
+    ScriptProfiler& getProfiler() {
+        return profiler;
+    }
+
     /**
      * @brief executes threads until they are all in waiting state.
      */
@@ -174,11 +193,41 @@ private:
     ScriptModule* module = nullptr;
     GameState* state = nullptr;
     bool debugFlag;
+    ScriptProfiler profiler;
 
     std::list<SCMThread> _activeThreads;
 
+    struct ScheduledThread {
+        std::list<SCMThread>::iterator thread;
+        /// Threads run in the order of this
+        uint64_t order;
+        /// Script time at which a waiting thread wakes
+        uint64_t wakeTime;
+    };
+
+    /// Milliseconds of script time executed
+    uint64_t time = 0;
+    uint64_t nextOrder = 0;
+    /// Whether awakeThreads and waitingThreads cover every thread
+    bool scheduled = false;
+    /// Threads visited every tick, in order
+    std::vector<ScheduledThread> awakeThreads;
+    /// Heap of the threads that wait, soonest first
+    std::vector<ScheduledThread> waitingThreads;
+
     void executeThread(SCMThread& t, int msPassed);
 
+    /**
+     * Sorts the threads into awake and waiting ones from their wake counters
+     * @param allowWaiting false to visit every thread this tick
+     */
+    void scheduleThreads(bool allowWaiting);
+
+    /**
+     * Writes the time left back into the wake counters of waiting threads
+     */
+    void unscheduleThreads();
+
     std::vector<SCMByte> globalData;
 };
 
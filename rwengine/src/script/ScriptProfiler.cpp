@@ -0,0 +1,142 @@
+#include "script/ScriptProfiler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <ostream>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+namespace {
+/// Entries sorted by total time, then by name so the order is stable
+template <class Key, class Value>
+std::vector<std::pair<Key, const Value*>> sortByTotal(
+    const std::unordered_map<Key, Value>& map) {
+    std::vector<std::pair<Key, const Value*>> sorted;
+    sorted.reserve(map.size());
+    for (const auto& entry : map) {
+        sorted.emplace_back(entry.first, &entry.second);
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) {
+        if (a.second->total != b.second->total) {
+            return a.second->total > b.second->total;
+        }
+        return a.first < b.first;
+    });
+    return sorted;
+}
+
+std::string opcodeName(SCMOpcode opcode) {
+    std::ostringstream ss;
+    ss << std::setfill('0') << std::setw(4) << std::hex << opcode;
+    return ss.str();
+}
+
+void writeTimes(std::ostream& out, const ScriptProfiler::Stats& stats) {
+    const auto average = stats.calls > 0 ? stats.total / stats.calls : 0;
+    out << std::setw(12) << stats.calls << std::setw(12)
+        << static_cast<double>(stats.total) / 1e6 << std::setw(12)
+        << static_cast<double>(average) / 1e3 << std::setw(12)
+        << static_cast<double>(stats.max) / 1e3;
+}
+
+/// Quotes a CSV field, signatures are identifiers but thread names are data
+void writeField(std::ostream& out, const std::string& field) {
+    out << '"';
+    for (const char c : field) {
+        if (c == '"') {
+            out << '"';
+        }
+        out << c;
+    }
+    out << '"';
+}
+}  // namespace
+
+uint64_t ScriptProfiler::now() {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+}
+
+void ScriptProfiler::record(SCMOpcode opcode, const ScriptFunctionMeta& code,
+                            const char* thread, uint64_t time) {
+    auto& stats = opcodes[opcode];
+    if (stats.calls == 0) {
+        stats.signature = code.signature;
+    }
+    stats.add(time);
+
+    threads[thread].add(time);
+}
+
+void ScriptProfiler::reset() {
+    opcodes.clear();
+    threads.clear();
+}
+
+void ScriptProfiler::writeReport(std::ostream& out) const {
+    const auto flags = out.flags();
+    const auto precision = out.precision();
+    out << std::fixed << std::setprecision(3);
+
+    out << "opcode  " << std::left << std::setw(40) << "signature"
+        << std::right << std::setw(12) << "calls" << std::setw(12)
+        << "total ms" << std::setw(12) << "avg us" << std::setw(12)
+        << "max us" << '\n';
+    for (const auto& entry : sortByTotal(opcodes)) {
+        out << opcodeName(entry.first) << "    " << std::left << std::setw(40)
+            << entry.second->signature << std::right;
+        writeTimes(out, *entry.second);
+        out << '\n';
+    }
+
+    out << '\n'
+        << std::left << std::setw(48) << "thread" << std::right
+        << std::setw(12) << "calls" << std::setw(12) << "total ms"
+        << std::setw(12) << "avg us" << std::setw(12) << "max us" << '\n';
+    for (const auto& entry : sortByTotal(threads)) {
+        out << std::left << std::setw(48) << entry.first << std::right;
+        writeTimes(out, *entry.second);
+        out << '\n';
+    }
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+void ScriptProfiler::writeCSV(std::ostream& out) const {
+    out << "kind,name,signature,calls,total_ns,max_ns\n";
+    for (const auto& entry : sortByTotal(opcodes)) {
+        const auto& stats = *entry.second;
+        out << "opcode," << opcodeName(entry.first) << ',';
+        writeField(out, stats.signature);
+        out << ',' << stats.calls << ',' << stats.total << ',' << stats.max
+            << '\n';
+    }
+    for (const auto& entry : sortByTotal(threads)) {
+        const auto& stats = *entry.second;
+        out << "thread,";
+        writeField(out, entry.first);
+        out << ",," << stats.calls << ',' << stats.total << ',' << stats.max
+            << '\n';
+    }
+}
+
+bool ScriptProfiler::write(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) {
+        return false;
+    }
+    const auto csv =
+        path.size() >= 4 && path.compare(path.size() - 4, 4, ".csv") == 0;
+    if (csv) {
+        writeCSV(out);
+    } else {
+        writeReport(out);
+    }
+    return !!out;
+}
@@ -0,0 +1,89 @@
+#ifndef _RWENGINE_SCRIPTPROFILER_HPP_
+#define _RWENGINE_SCRIPTPROFILER_HPP_
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <unordered_map>
+
+#include <script/ScriptTypes.hpp>
+
+/**
+ * @brief Counts and times the instructions run by a ScriptMachine.
+ *
+ * Disabled by default, the machine only reads the clock while it's enabled.
+ * Each instruction is timed from fetching its opcode until its function
+ * returns, and added to the totals of its opcode and of the thread that ran
+ * it.
+ */
+class ScriptProfiler {
+public:
+    struct Stats {
+        uint64_t calls = 0;
+        /// Nanoseconds spent in total
+        uint64_t total = 0;
+        /// Nanoseconds taken by the slowest call
+        uint64_t max = 0;
+
+        void add(uint64_t time) {
+            ++calls;
+            total += time;
+            max = time > max ? time : max;
+        }
+    };
+
+    struct OpcodeStats : Stats {
+        std::string signature;
+    };
+
+    bool isEnabled() const {
+        return enabled;
+    }
+
+    void setEnabled(bool enable) {
+        enabled = enable;
+    }
+
+    /**
+     * @return nanoseconds from an arbitrary, fixed point
+     */
+    static uint64_t now();
+
+    /**
+     * Adds an instruction that took time nanoseconds to the totals
+     */
+    void record(SCMOpcode opcode, const ScriptFunctionMeta& code,
+                const char* thread, uint64_t time);
+
+    void reset();
+
+    const std::unordered_map<SCMOpcode, OpcodeStats>& getOpcodeStats() const {
+        return opcodes;
+    }
+
+    const std::unordered_map<std::string, Stats>& getThreadStats() const {
+        return threads;
+    }
+
+    /**
+     * Writes tables of the opcodes and threads, most expensive first
+     */
+    void writeReport(std::ostream& out) const;
+
+    /**
+     * Writes one row per opcode and per thread, most expensive first
+     */
+    void writeCSV(std::ostream& out) const;
+
+    /**
+     * Writes CSV if the path ends in .csv, the report otherwise
+     */
+    bool write(const std::string& path) const;
+
+private:
+    bool enabled = false;
+    std::unordered_map<SCMOpcode, OpcodeStats> opcodes;
+    std::unordered_map<std::string, Stats> threads;
+};
+
+#endif
@@ -18,7 +18,6 @@
 #include <script/ScriptMachine.hpp>
 #include <script/ScriptTypes.hpp>
 
-#include <boost/algorithm/string/predicate.hpp>
 
 /**
     @brief NOP
@@ -855,9 +854,7 @@ void opcode_004e(const ScriptArguments& args) {
     @arg arg2 
 */
 void opcode_004f(const ScriptArguments& args, const ScriptLabel arg1) {
-    args.getVM()->startThread(arg1, false);
-    auto& threads = args.getVM()->getThreads();
-    SCMThread& thread = threads.back();
+    SCMThread& thread = args.getVM()->startThread(arg1, false);
     // Copy arguments to locals
     /// @todo prevent overflow
     /// @todo don't do pointer casting
@@ -7855,7 +7852,9 @@ void opcode_02e3(const ScriptArguments& args, const ScriptVehicle vehicle, Scrip
     @arg arg1 
 */
 void opcode_02e4(const ScriptArguments& args, const ScriptString arg1) {
-    args.getWorld()->loadCutscene(arg1);
+    // Finished by set_cutscene_anim and start_cutscene, the models are
+    // created meanwhile
+    args.getWorld()->preloadCutscene(arg1);
     args.getState()->cutsceneStartTime = -1.f;
 
     auto player = args.getWorld()->getPlayer();
@@ -7894,6 +7893,7 @@ void opcode_02e6(const ScriptArguments& args, const ScriptObject object,
     std::string animName = arg2;
     std::transform(animName.begin(), animName.end(), animName.begin(),
                    ::tolower);
+    args.getWorld()->finishCutsceneData();
     auto anim = args.getWorld()->data->animationsCutscene.at(animName);
     if (anim) {
         cutscene->animator->playAnimation(AnimIndexMovement, anim, 1.f, false);
@@ -7909,6 +7909,15 @@ void opcode_02e6(const ScriptArguments& args, const ScriptObject object,
     opcode 02e7
 */
 void opcode_02e7(const ScriptArguments& args) {
+    // Hold the thread here until the cutscene's audio is decoded, rather
+    // than blocking the game on it. The opcode has no arguments, so
+    // stepping back over it runs it again once the thread is resumed.
+    if (!args.getWorld()->isCutsceneReady()) {
+        auto thread = args.getThread();
+        thread->programCounter -= sizeof(SCMOpcode);
+        thread->wakeCounter = -1;
+        return;
+    }
     args.getWorld()->startCutscene();
 }
 
@@ -9625,24 +9634,20 @@ void opcode_0362(const ScriptArguments& args, const ScriptCharacter character,
     @arg visible Boolean true/false
 */
 void opcode_0363(const ScriptArguments& args, ScriptVec3 coord, const ScriptFloat radius, const ScriptModel model, const ScriptBoolean visible) {
-    auto& models = args.getVM()->getFile().getModels();
-    auto& modelName = models[-model];
+    const auto id = static_cast<uint16_t>(script::getModel(args, model));
 
     // Attempt to find the closest object
     InstanceObject* closestObject = nullptr;
     float closestDistance = radius;
-    for(auto& i : args.getWorld()->instancePool.objects) {
-        InstanceObject* object = static_cast<InstanceObject*>(i.second.get());
-
-    	// Check if this instance has the correct model id, early out if it isn't
-    	auto modelinfo = object->getModelInfo<BaseModelInfo>();
-    	if (!boost::iequals(modelinfo->name, modelName)) {
+    for (auto modelObject : args.getWorld()->getModelObjects(id)) {
+    	if (modelObject->type() != GameObject::Instance) {
     		continue;
     	}
+        InstanceObject* object = static_cast<InstanceObject*>(modelObject);
 
     	// Calculate distance and check if this is the new closest object
     	// @todo will this somehow respect the objects centre of mass / bounding box or something?
-    	float distance = glm::length(object->position - coord);
+    	float distance = glm::length(object->getPosition() - coord);
     	if (distance <= closestDistance) {
     		closestObject = object;
     		closestDistance = distance;
@@ -10894,13 +10899,15 @@ void opcode_03b6(const ScriptArguments& args, ScriptVec3 coord, const ScriptFloa
     std::transform(newmodel.begin(), newmodel.end(), newmodel.begin(), ::tolower);
     std::transform(oldmodel.begin(), oldmodel.end(), oldmodel.begin(), ::tolower);
 
+    auto oldobjectid = args.getWorld()->data->findModelObject(oldmodel);
     auto newobjectid = args.getWorld()->data->findModelObject(newmodel);
     auto nobj = args.getWorld()->data->findModelInfo<SimpleModelInfo>(newobjectid);
 
-    for(auto& p : args.getWorld()->instancePool.objects) {
-        auto o = p.second.get();
+    // A copy, changing the model moves the objects to the new model's list
+    const auto objects = args.getWorld()->getModelObjects(oldobjectid);
+    for(auto o : objects) {
+    	if( o->type() != GameObject::Instance ) continue;
     	if( !o->getModel() ) continue;
-    	if( o->getModelInfo<BaseModelInfo>()->name != oldmodel ) continue;
     	float d = glm::distance(coord, o->getPosition());
     	if( d < radius ) {
     		InstanceObject* inst = static_cast<InstanceObject*>(o);
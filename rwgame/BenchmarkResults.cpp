@@ -0,0 +1,231 @@
+#include "BenchmarkResults.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <numeric>
+#include <ostream>
+
+namespace {
+float nearestRank(const std::vector<float>& sorted, float percentile) {
+    auto rank = static_cast<size_t>(
+        std::ceil(percentile * static_cast<float>(sorted.size())));
+    return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+}
+
+void writeJSONString(std::ostream& out, const std::string& str) {
+    out << '"';
+    for (char c : str) {
+        switch (c) {
+            case '"':
+                out << "\\\"";
+                break;
+            case '\\':
+                out << "\\\\";
+                break;
+            case '\n':
+                out << "\\n";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    out << "\\u" << std::hex << std::setw(4)
+                        << std::setfill('0') << static_cast<int>(c)
+                        << std::dec << std::setfill(' ');
+                } else {
+                    out << c;
+                }
+        }
+    }
+    out << '"';
+}
+
+void writeJSONSummary(std::ostream& out,
+                      const BenchmarkResults::Summary& summary) {
+    out << "{\"count\": " << summary.count << ", \"min\": " << summary.min
+        << ", \"median\": " << summary.median << ", \"p95\": " << summary.p95
+        << ", \"p99\": " << summary.p99 << ", \"max\": " << summary.max
+        << ", \"mean\": " << summary.mean << "}";
+}
+
+void writeTextSummary(std::ostream& out, const char* label,
+                      const BenchmarkResults::Summary& summary) {
+    out << std::left << std::setw(24) << label << std::right << std::fixed
+        << std::setprecision(2) << std::setw(8) << summary.min
+        << std::setw(8) << summary.median << std::setw(8) << summary.p95
+        << std::setw(8) << summary.p99 << std::setw(8) << summary.max
+        << std::setw(8) << summary.mean << "\n";
+}
+}  // namespace
+
+unsigned BenchmarkResults::getRunCount() const {
+    unsigned runs = 0;
+    for (const auto& frame : frames_) {
+        runs = std::max(runs, frame.run + 1);
+    }
+    return runs;
+}
+
+BenchmarkResults::Summary BenchmarkResults::summarize(
+    std::vector<float> values) {
+    Summary summary;
+    summary.count = values.size();
+    if (values.empty()) {
+        return summary;
+    }
+
+    std::sort(values.begin(), values.end());
+    summary.min = values.front();
+    summary.median = nearestRank(values, 0.5f);
+    summary.p95 = nearestRank(values, 0.95f);
+    summary.p99 = nearestRank(values, 0.99f);
+    summary.max = values.back();
+    summary.mean = std::accumulate(values.begin(), values.end(), 0.f) /
+                   static_cast<float>(values.size());
+    return summary;
+}
+
+BenchmarkResults::Summary BenchmarkResults::summarizeFrameTimes() const {
+    return summarizeFrames([](const Frame& frame, std::vector<float>& out) {
+        out.push_back(frame.frameTime);
+    });
+}
+
+BenchmarkResults::Summary BenchmarkResults::summarizeRun(unsigned run) const {
+    return summarizeFrames([run](const Frame& frame, std::vector<float>& out) {
+        if (frame.run == run) {
+            out.push_back(frame.frameTime);
+        }
+    });
+}
+
+BenchmarkResults::Summary BenchmarkResults::summarizeSection(
+    FrameStats::Section section) const {
+    return summarizeFrames(
+        [section](const Frame& frame, std::vector<float>& out) {
+            out.push_back(frame.sections[section]);
+        });
+}
+
+std::vector<size_t> BenchmarkResults::getHistogram() const {
+    std::vector<size_t> buckets(kBucketCount);
+    for (const auto& frame : frames_) {
+        auto bucket = static_cast<size_t>(
+            std::max(frame.frameTime, 0.f) / kBucketWidth);
+        buckets[std::min(bucket, kBucketCount - 1)]++;
+    }
+    return buckets;
+}
+
+void BenchmarkResults::writeText(std::ostream& out) const {
+    out << "Results =============\n"
+        << "Benchmark: " << name_ << "\n"
+        << "Runs: " << getRunCount() << "\n"
+        << "Frames: " << frames_.size() << "\n";
+    if (frames_.empty()) {
+        out.flush();
+        return;
+    }
+
+    // Don't leave the number formatting behind on the stream
+    std::ios format(nullptr);
+    format.copyfmt(out);
+
+    out << std::left << std::setw(24) << "(ms)" << std::right
+        << std::setw(8) << "min" << std::setw(8) << "median"
+        << std::setw(8) << "p95" << std::setw(8) << "p99" << std::setw(8)
+        << "max" << std::setw(8) << "mean" << "\n";
+    writeTextSummary(out, "frame", summarizeFrameTimes());
+    for (size_t s = 0; s < FrameStats::SectionCount; ++s) {
+        auto section = static_cast<FrameStats::Section>(s);
+        writeTextSummary(out, FrameStats::getSectionName(section),
+                         summarizeSection(section));
+    }
+    auto runs = getRunCount();
+    for (unsigned run = 0; runs > 1 && run < runs; ++run) {
+        std::string label = "frame (run " + std::to_string(run + 1) + ")";
+        writeTextSummary(out, label.c_str(), summarizeRun(run));
+    }
+
+    out << "Frame time histogram:\n";
+    auto histogram = getHistogram();
+    auto largest = *std::max_element(histogram.begin(), histogram.end());
+    for (size_t i = 0; i < histogram.size(); ++i) {
+        if (histogram[i] == 0) {
+            continue;
+        }
+        auto low = static_cast<int>(static_cast<float>(i) * kBucketWidth);
+        out << std::setw(4) << low
+            << (i + 1 < histogram.size() ? " ms " : "+ms ") << std::setw(7)
+            << histogram[i] << " "
+            << std::string(histogram[i] * 50 / largest, '#') << "\n";
+    }
+    out.copyfmt(format);
+    out.flush();
+}
+
+void BenchmarkResults::writeJSON(std::ostream& out) const {
+    out << "{\n  \"benchmark\": ";
+    writeJSONString(out, name_);
+    out << ",\n  \"frames\": " << frames_.size() << ",\n  \"frameTime\": ";
+    writeJSONSummary(out, summarizeFrameTimes());
+
+    out << ",\n  \"sections\": {";
+    for (size_t s = 0; s < FrameStats::SectionCount; ++s) {
+        auto section = static_cast<FrameStats::Section>(s);
+        out << (s == 0 ? "\n    " : ",\n    ");
+        writeJSONString(out, FrameStats::getSectionName(section));
+        out << ": ";
+        writeJSONSummary(out, summarizeSection(section));
+    }
+
+    out << "\n  },\n  \"counters\": {\n    \"draws\": ";
+    writeJSONSummary(out, summarizeFrames([](const Frame& frame,
+                                              std::vector<float>& values) {
+        values.push_back(static_cast<float>(frame.draws));
+    }));
+    out << ",\n    \"textures\": ";
+    writeJSONSummary(out, summarizeFrames([](const Frame& frame,
+                                              std::vector<float>& values) {
+        values.push_back(static_cast<float>(frame.textures));
+    }));
+    out << ",\n    \"buffers\": ";
+    writeJSONSummary(out, summarizeFrames([](const Frame& frame,
+                                              std::vector<float>& values) {
+        values.push_back(static_cast<float>(frame.buffers));
+    }));
+
+    out << "\n  },\n  \"runs\": [";
+    for (unsigned run = 0; run < getRunCount(); ++run) {
+        out << (run == 0 ? "\n    " : ",\n    ");
+        writeJSONSummary(out, summarizeRun(run));
+    }
+
+    out << "\n  ],\n  \"histogram\": {\"bucketWidth\": " << kBucketWidth
+        << ", \"counts\": [";
+    auto histogram = getHistogram();
+    for (size_t i = 0; i < histogram.size(); ++i) {
+        out << (i == 0 ? "" : ", ") << histogram[i];
+    }
+    out << "]}\n}\n";
+    out.flush();
+}
+
+void BenchmarkResults::writeCSV(std::ostream& out) const {
+    out << "run,frame_ms";
+    for (size_t s = 0; s < FrameStats::SectionCount; ++s) {
+        out << "," << FrameStats::getSectionName(
+                          static_cast<FrameStats::Section>(s))
+            << "_ms";
+    }
+    out << ",draws,textures,buffers\n";
+
+    for (const auto& frame : frames_) {
+        out << frame.run << "," << frame.frameTime;
+        for (float time : frame.sections) {
+            out << "," << time;
+        }
+        out << "," << frame.draws << "," << frame.textures << ","
+            << frame.buffers << "\n";
+    }
+    out.flush();
+}
@@ -0,0 +1,95 @@
+#ifndef RWGAME_BENCHMARKRESULTS_HPP
+#define RWGAME_BENCHMARKRESULTS_HPP
+
+#include <core/FrameStats.hpp>
+
+#include <array>
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Per frame measurements taken by BenchmarkState
+ *
+ * Besides the mean it reports the percentiles and a histogram of the frame
+ * times, since the occasional slow frame is what stands out while playing.
+ * Results can be written as text, JSON or CSV.
+ */
+class BenchmarkResults {
+public:
+    struct Frame {
+        /// Which run of the track the frame belongs to
+        unsigned run = 0;
+        /// Milliseconds since the previous frame
+        float frameTime = 0.f;
+        /// Milliseconds spent in each of the FrameStats sections
+        std::array<float, FrameStats::SectionCount> sections{};
+        int draws = 0;
+        int textures = 0;
+        int buffers = 0;
+    };
+
+    /**
+     * Percentiles use the nearest rank, so every value reported was
+     * actually measured.
+     */
+    struct Summary {
+        size_t count = 0;
+        float min = 0.f;
+        float median = 0.f;
+        float p95 = 0.f;
+        float p99 = 0.f;
+        float max = 0.f;
+        float mean = 0.f;
+    };
+
+    /// Width of the histogram buckets in milliseconds
+    static constexpr float kBucketWidth = 2.f;
+    /// The last bucket counts all frames slower than the others
+    static constexpr size_t kBucketCount = 26;
+
+    explicit BenchmarkResults(std::string name) : name_(std::move(name)) {
+    }
+
+    void addFrame(const Frame& frame) {
+        frames_.push_back(frame);
+    }
+
+    const std::vector<Frame>& getFrames() const {
+        return frames_;
+    }
+
+    /// @return the number of runs with at least one frame
+    unsigned getRunCount() const;
+
+    static Summary summarize(std::vector<float> values);
+
+    Summary summarizeFrameTimes() const;
+    Summary summarizeRun(unsigned run) const;
+    Summary summarizeSection(FrameStats::Section section) const;
+
+    std::vector<size_t> getHistogram() const;
+
+    void writeText(std::ostream& out) const;
+    void writeJSON(std::ostream& out) const;
+    /// Writes one row for each frame
+    void writeCSV(std::ostream& out) const;
+
+private:
+    std::string name_;
+    std::vector<Frame> frames_;
+
+    template <class Fn>
+    Summary summarizeFrames(Fn&& value) const {
+        std::vector<float> values;
+        values.reserve(frames_.size());
+        for (const auto& frame : frames_) {
+            value(frame, values);
+        }
+        return summarize(std::move(values));
+    }
+};
+
+#endif
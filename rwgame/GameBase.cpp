@@ -1,6 +1,7 @@
 #include "GameBase.hpp"
 
 #include <core/Logger.hpp>
+#include <gl/Headless.hpp>
 #include <rw/debug.hpp>
 #include "GitSHA1.h"
 
@@ -20,10 +21,18 @@ GameBase::GameBase(Logger &inlog, const std::optional<RWArgConfigLayer> &args) :
     bool fullscreen = config.fullscreen();
     size_t w = config.width(), h = config.height();
 
-    if (SDL_Init(SDL_INIT_VIDEO) < 0)
-        throw std::runtime_error("Failed to initialize SDL2!");
+    if (args.has_value() && args->headless) {
+        // Events are still needed to be able to quit
+        gl::setHeadless(true);
+        if (SDL_Init(SDL_INIT_EVENTS) < 0)
+            throw std::runtime_error("Failed to initialize SDL2!");
+        log.info("Game", "Running headless");
+    } else {
+        if (SDL_Init(SDL_INIT_VIDEO) < 0)
+            throw std::runtime_error("Failed to initialize SDL2!");
 
-    window.create(kWindowTitle + " [" + kBuildStr + "]", w, h, fullscreen);
+        window.create(kWindowTitle + " [" + kBuildStr + "]", w, h, fullscreen);
+    }
 
     SET_RW_ABORT_CB([this]() {window.showCursor();},
             [this]() {window.hideCursor();});
@@ -60,6 +60,9 @@ void GameWindow::create(const std::string& title, size_t w, size_t h,
 }
 
 void GameWindow::close() {
+    if (!window) {
+        return;
+    }
     SDL_GL_DeleteContext(glcontext);
     SDL_FreeSurface(icon);
     SDL_DestroyWindow(window);
@@ -76,6 +79,10 @@ void GameWindow::hideCursor() {
 }
 
 glm::ivec2 GameWindow::getSize() const {
+    if (!window) {
+        return glm::ivec2(0, 0);
+    }
+
     int x, y;
     SDL_GL_GetDrawableSize(window, &x, &y);
 
@@ -10,7 +10,9 @@
 #include "states/LoadingState.hpp"
 #include "states/MenuState.hpp"
 
+#include <core/FrameStats.hpp>
 #include <core/Profiler.hpp>
+#include <gl/Headless.hpp>
 
 #include <engine/Payphone.hpp>
 #include <engine/SaveGame.hpp>
@@ -29,6 +31,7 @@
 #include <iomanip>
 #include <iostream>
 #include <algorithm>
+#include <random>
 
 #ifdef _MSC_VER
 #pragma warning(disable : 4305 5033)
@@ -47,6 +50,12 @@ static constexpr std::array<
                     {GameRenderer::Arrow, "arrow.dff", ""}}};
 
 constexpr float kMaxPhysicsSubSteps = 2;
+
+// Steps between checksums of the world in recorded replays
+constexpr uint32_t kReplayChecksumInterval = 60;
+
+// Longest frame that is simulated in full, so we won't freeze completely
+constexpr float kMaxFrameTime = 0.1f;
 }  // namespace
 
 #define MOUSE_SENSITIVITY_SCALE 2.5f
@@ -62,11 +71,72 @@ RWGame::RWGame(Logger& log, const std::optional<RWArgConfigLayer> &args)
     bool test = false;
     std::optional<std::string> startSave;
     std::optional<std::string> benchFile;
+    BenchmarkState::Options benchOptions;
+    bool dataCache = true;
+    std::optional<std::string> recordPath;
+    std::optional<std::string> replayPath;
     if (args.has_value()) {
         newgame = args->newGame;
         test = args->test;
         startSave = args->loadGamePath;
         benchFile = args->benchmarkPath;
+        benchOptions.warmUp = args->benchmarkWarmUp.value_or(0.f);
+        benchOptions.runs =
+            static_cast<unsigned>(std::max(args->benchmarkRuns.value_or(1), 1));
+        benchOptions.outputPath = args->benchmarkOutput;
+        dataCache = !args->noDataCache;
+        maxRunTime = args->runTime;
+        saveInterval = args->saveInterval;
+        if (args->saveOutput) {
+            saveIntervalPath = *args->saveOutput;
+        }
+        if (args->traceOutput) {
+            tracePath = *args->traceOutput;
+        }
+        if (args->scriptProfileOutput) {
+            scriptProfilePath = *args->scriptProfileOutput;
+            scriptProfile = true;
+        }
+        recordPath = args->recordPath;
+        replayPath = args->replayPath;
+    }
+
+    // Replays always start from a fresh game, so they can be reproduced
+    if (replayPath) {
+        replayIn.open(*replayPath, std::ios::binary);
+        replayReader = std::make_unique<ReplayReader>(replayIn);
+        if (!replayReader->isValid()) {
+            throw std::runtime_error("Invalid replay file: " + *replayPath);
+        }
+        const auto& header = replayReader->getHeader();
+        randomSeed = header.seed;
+        test = header.start == ReplayHeader::TestGame;
+        newgame = !test;
+        startSave.reset();
+        benchFile.reset();
+        log.info("Replay", "Playing back " + *replayPath);
+    } else if (recordPath) {
+        if (startSave || benchFile) {
+            throw std::runtime_error("Only new games can be recorded");
+        }
+        ReplayHeader header;
+        header.seed = std::random_device()();
+        header.checksumInterval = kReplayChecksumInterval;
+        header.start = test ? ReplayHeader::TestGame : ReplayHeader::NewGame;
+        newgame = !test;
+        randomSeed = header.seed;
+        replayOut.open(*recordPath, std::ios::binary);
+        if (!replayOut) {
+            throw std::runtime_error("Could not create replay file: " +
+                                     *recordPath);
+        }
+        replayWriter = std::make_unique<ReplayWriter>(replayOut, header);
+        log.info("Replay", "Recording to " + *recordPath);
+    }
+
+    // Nobody can pick anything from the menu without a window
+    if (gl::isHeadless() && !benchFile && !test && !startSave) {
+        newgame = true;
     }
 
     log.info("Game", "Game directory: " + config.gamedataPath());
@@ -76,6 +146,11 @@ RWGame::RWGame(Logger& log, const std::optional<RWArgConfigLayer> &args)
                                  config.gamedataPath());
     }
 
+    if (dataCache) {
+        data.loaderCache =
+            LoaderCache(RWConfigParser::getDefaultConfigPath() / "cache");
+    }
+
     data.load();
 
     for (const auto& [specialModel, fileName, name] : kSpecialModels) {
@@ -90,6 +165,10 @@ RWGame::RWGame(Logger& log, const std::optional<RWArgConfigLayer> &args)
 
     hudDrawer.applyHUDScale(config.hudScale());
     renderer.map.scaleHUD(config.hudScale());
+    renderer.setLodBias(config.lodBias());
+    renderer.setOcclusionCulling(
+        config.occlusionCulling() &&
+        !(args.has_value() && args->noOcclusionCulling));
 
     debug.setDebugMode(btIDebugDraw::DBG_DrawWireframe |
                        btIDebugDraw::DBG_DrawConstraints |
@@ -112,7 +191,8 @@ RWGame::RWGame(Logger& log, const std::optional<RWArgConfigLayer> &args)
 
     stateManager.enter<LoadingState>(this, [=]() {
         if (benchFile.has_value()) {
-            stateManager.enter<BenchmarkState>(this, *benchFile);
+            stateManager.enter<BenchmarkState>(this, *benchFile,
+                                               benchOptions);
         } else if (test) {
             stateManager.enter<IngameState>(this, true, "test");
         } else if (newgame) {
@@ -130,6 +210,8 @@ RWGame::RWGame(Logger& log, const std::optional<RWArgConfigLayer> &args)
 
 RWGame::~RWGame() {
     log.info("Game", "Beginning cleanup");
+    writeProfilerTrace();
+    writeScriptProfile();
 }
 
 void RWGame::newGame() {
@@ -140,6 +222,10 @@ void RWGame::newGame() {
     world = std::make_unique<GameWorld>(&log, &data);
     world->dynamicsWorld->setDebugDrawer(&debug);
 
+    if (randomSeed) {
+        world->seedRandom(*randomSeed);
+    }
+
     // Associate the new world with the new state and vice versa
     state.world = world.get();
     world->state = &state;
@@ -181,7 +267,35 @@ bool RWGame::hitWorldRay(const glm::vec3 &start, const glm::vec3 &direction, glm
 }
 
 void RWGame::saveGame(const std::string& savename) {
-    RW_UNUSED(savename);
+    if (pendingSave.valid()) {
+        log.warning("Game", "Still writing " + pendingSavePath +
+                                ", not saving " + savename);
+        return;
+    }
+
+    log.info("Game", "Saving game " + savename);
+
+    // The state is copied here, only the encoding and writing is left to the
+    // worker. pollSave() reports how it went.
+    pendingSavePath = savename;
+    pendingSave = SaveGame::writeGameAsync(state, savename);
+}
+
+void RWGame::pollSave(bool wait) {
+    if (!pendingSave.valid()) {
+        return;
+    }
+    if (!wait && pendingSave.wait_for(std::chrono::seconds(0)) !=
+                     std::future_status::ready) {
+        return;
+    }
+
+    const auto error = pendingSave.get();
+    if (error.empty()) {
+        log.info("Game", "Saved game " + pendingSavePath);
+    } else {
+        log.error("Game", "Failed to save game: " + error);
+    }
 }
 
 void RWGame::loadGame(const std::string& savename) {
@@ -205,6 +319,7 @@ void RWGame::startScript(const std::string& name) {
     script = data.loadSCM(name);
     if (script) {
         vm = std::make_unique<ScriptMachine>(&state, script, &opcodes);
+        vm->getProfiler().setEnabled(scriptProfile);
         state.script = vm.get();
     } else {
         log.error("Game", "Failed to load SCM: " + name);
@@ -406,6 +521,10 @@ void RWGame::handleCheatInput(char symbol) {
 }
 
 int RWGame::run() {
+    if (gl::isHeadless()) {
+        return runHeadless();
+    }
+
     namespace chrono = std::chrono;
 
     auto lastFrame = chrono::steady_clock::now();
@@ -417,6 +536,7 @@ int RWGame::run() {
     while (stateManager.currentState() && running) {
         RW_PROFILE_FRAME_BOUNDARY();
         RW_PROFILE_SCOPE("Main Loop");
+        FrameStats::reset();
 
         running = updateInput();
 
@@ -425,18 +545,19 @@ int RWGame::run() {
             chrono::duration<float>(currentFrame - lastFrame).count();
         lastFrame = currentFrame;
 
-        if (!world->isPaused()) {
-            accumulatedTime += frameTime;
-
-            // Clamp frameTime, so we won't freeze completely
-            if (frameTime > 0.1f) {
-                frameTime = 0.1f;
-            }
+        frameTime = std::min(frameTime, kMaxFrameTime);
 
-            accumulatedTime = tickWorld(deltaTime, accumulatedTime);
+        // Frames spent paused don't move the simulation on
+        float simulatedTime = world->isPaused() ? 0.f : frameTime;
+        if (!replayFrame(simulatedTime)) {
+            break;
         }
 
-        render(1, frameTime);
+        accumulatedTime += simulatedTime;
+        accumulatedTime = tickWorld(deltaTime, accumulatedTime);
+
+        // The leftover time is how far we are between the last two steps
+        render(std::min(accumulatedTime / deltaTime, 1.f), frameTime);
 
         getWindow().swap();
 
@@ -444,40 +565,208 @@ int RWGame::run() {
         stateManager.updateStack();
     }
 
+    pollSave(true);
+
     window.close();
 
     stateManager.clear();
 
-    return 0;
+    return replayDiverged ? 1 : 0;
+}
+
+int RWGame::runHeadless() {
+    namespace chrono = std::chrono;
+
+    const float deltaTime = GAME_TIMESTEP;
+    const auto start = chrono::steady_clock::now();
+    float accumulatedTime = 0.f;
+    float simulatedTime = 0.f;
+    float nextSaveTime = saveInterval.value_or(0.f);
+
+    bool running = true;
+    while (stateManager.currentState() && running) {
+        RW_PROFILE_FRAME_BOUNDARY();
+        RW_PROFILE_SCOPE("Main Loop");
+        FrameStats::reset();
+
+        running = updateInput();
+
+        // Traffic is spawned around the camera, which render() would update
+        currentCam = stateManager.states.back()->getCamera(1.f);
+
+        // A step per frame, unless a replay says otherwise
+        float frameTime = world->isPaused() ? 0.f : deltaTime;
+        if (!replayFrame(frameTime)) {
+            break;
+        }
+
+        accumulatedTime += frameTime;
+        accumulatedTime = tickWorld(deltaTime, accumulatedTime);
+        simulatedTime = static_cast<float>(simulationTicks) * deltaTime;
+
+        // Only once a game is running, there's nothing to save before that.
+        // A slow write pushes the next save back rather than skipping it.
+        if (saveInterval && vm && !pendingSave.valid() &&
+            simulatedTime >= nextSaveTime) {
+            saveGame(saveIntervalPath);
+            nextSaveTime = simulatedTime + *saveInterval;
+        }
+
+        stateManager.updateStack();
+
+        if (maxRunTime && simulatedTime >= *maxRunTime) {
+            break;
+        }
+    }
+
+    auto elapsed =
+        chrono::duration<float>(chrono::steady_clock::now() - start).count();
+    std::ostringstream ss;
+    ss << "Simulated " << simulationTicks << " steps (" << simulatedTime
+       << "s) in " << elapsed << "s, "
+       << (elapsed > 0.f ? static_cast<float>(simulationTicks) / elapsed : 0.f)
+       << " steps/s";
+    log.info("Game", ss.str());
+
+    pollSave(true);
+
+    stateManager.clear();
+
+    return replayDiverged ? 1 : 0;
 }
 
 float RWGame::tickWorld(const float deltaTime, float accumulatedTime) {
     RW_PROFILE_SCOPEC(__func__, MP_GREEN);
+    RW_FRAME_SECTION(TickWorld);
     auto deltaTimeWithTimeScale =
             deltaTime * world->state->basic.timeScale;
 
     while (accumulatedTime >= deltaTime) {
-        if (!stateManager.currentState()) {
+        if (!stateManager.currentState() || !replayTickInput()) {
             break;
         }
 
+        // Keep the transforms from before this step, the renderer
+        // interpolates between them and the ones after it. Only objects
+        // that moved in the last step have a transform to save, not the
+        // thousands of buildings that never do.
+        world->transforms.saveLastTransforms();
+        world->dynamicTransforms.saveLastTransforms();
+
         {
             RW_PROFILE_SCOPEC("stepSimulation", MP_DARKORANGE1);
+            RW_FRAME_SECTION(StepSimulation);
             world->dynamicsWorld->stepSimulation(
                     deltaTimeWithTimeScale, kMaxPhysicsSubSteps, deltaTime);
         }
 
         stateManager.tick(deltaTimeWithTimeScale);
 
+        replayTickLook();
+
         tick(deltaTimeWithTimeScale);
 
         getState()->swapInputState();
 
         accumulatedTime -= deltaTime;
+
+        simulationTicks++;
+        if (!replayTickChecksum()) {
+            break;
+        }
     }
     return accumulatedTime;
 }
 
+bool RWGame::replayFrame(float& frameTime) {
+    if (replayWriter) {
+        replayWriter->writeFrame(
+            {frameTime, currentCam.position, currentCam.rotation});
+    } else if (replayReader) {
+        auto record = replayReader->next();
+        if (record != ReplayReader::Record::Frame) {
+            stopReplay(record == ReplayReader::Record::End
+                           ? ""
+                           : "the recording ran fewer steps");
+            return false;
+        }
+        const auto& frame = replayReader->getFrame();
+        frameTime = frame.frameTime;
+        currentCam.position = frame.cameraPosition;
+        currentCam.rotation = frame.cameraRotation;
+    }
+    return true;
+}
+
+bool RWGame::replayTickInput() {
+    if (!replayReader) {
+        return true;
+    }
+    if (replayReader->next() != ReplayReader::Record::Tick) {
+        stopReplay("the recording ran more steps");
+        return false;
+    }
+    state.input[0] = replayReader->getTick().input;
+    return true;
+}
+
+void RWGame::replayTickLook() {
+    auto player = world->getPlayer();
+    if (replayWriter) {
+        ReplayTick tick;
+        tick.input = state.input[0];
+        if (player) {
+            tick.look = player->getCharacter()->getLook();
+        }
+        replayWriter->writeTick(tick);
+    } else if (replayReader && player) {
+        // Mouse look isn't part of the input state, so it's stored as is
+        player->setLookDirection(replayReader->getTick().look);
+    }
+}
+
+bool RWGame::replayTickChecksum() {
+    if (!replayWriter && !replayReader) {
+        return true;
+    }
+
+    auto interval = replayWriter ? kReplayChecksumInterval
+                                 : replayReader->getHeader().checksumInterval;
+    if (interval == 0 || simulationTicks % interval != 0) {
+        return true;
+    }
+
+    auto checksum = checksumTransforms(*world);
+    if (replayWriter) {
+        replayWriter->writeChecksum(checksum);
+    } else if (replayReader->next() != ReplayReader::Record::Checksum ||
+               replayReader->getChecksum() != checksum) {
+        stopReplay("the objects don't match the recording");
+        return false;
+    }
+    return true;
+}
+
+void RWGame::stopReplay(const std::string& reason) {
+    std::ostringstream ss;
+    ss << "Replay ";
+    if (reason.empty()) {
+        ss << "finished";
+    } else {
+        ss << "diverged at step " << simulationTicks << ", " << reason;
+        replayDiverged = true;
+    }
+    ss << " after " << simulationTicks << " steps";
+    if (replayDiverged) {
+        log.error("Replay", ss.str());
+    } else {
+        log.info("Replay", ss.str());
+    }
+
+    replayReader.reset();
+    stateManager.clear();
+}
+
 bool RWGame::updateInput() {
     RW_PROFILE_SCOPE(__func__);
     SDL_Event event;
@@ -508,6 +797,11 @@ bool RWGame::updateInput() {
                 break;
         }
 
+        // Played back input comes from the replay
+        if (replayReader) {
+            continue;
+        }
+
         GameInput::updateGameInputState(&getState()->input[0], event);
 
         if (stateManager.currentState()) {
@@ -520,6 +814,8 @@ bool RWGame::updateInput() {
 
 void RWGame::tick(float dt) {
     RW_PROFILE_SCOPE(__func__);
+    pollSave();
+
     State* currState = stateManager.states.back().get();
 
     static float clockAccumulator = 0.f;
@@ -607,7 +903,6 @@ void RWGame::tickObjects(float dt) const {
         RW_PROFILE_SCOPEC("allObjects", MP_HOTPINK1);
         RW_PROFILE_COUNTER_SET("tickObjects/allObjects", world->allObjects.size());
         for (auto &object : world->allObjects) {
-            object->_updateLastTransform();
             object->tick(dt);
         }
     }
@@ -720,6 +1015,8 @@ void RWGame::renderDebugStats(float time) {
        << renderer.getCulledCount() << "/"
        << renderer.getRenderer().getTextureCount() << "/"
        << renderer.getRenderer().getBufferCount() << "\n"
+       << "Occluded/Occluders: " << renderer.getOccludedCount() << "/"
+       << renderer.getOccluderCount() << "\n"
        << "Timescale: " << world->state->basic.timeScale;
 
     TextRenderer::TextInfo ti;
@@ -935,6 +1232,24 @@ void RWGame::renderDebugObjects(float time, ViewCamera& camera) {
     }
 }
 
+void RWGame::writeProfilerTrace() {
+    if (RW_PROFILE_WRITE_TRACE(tracePath)) {
+        log.info("Game", "Wrote profiler trace to " + tracePath);
+    }
+}
+
+void RWGame::writeScriptProfile() {
+    if (!vm || vm->getProfiler().getOpcodeStats().empty()) {
+        return;
+    }
+    if (vm->getProfiler().write(scriptProfilePath)) {
+        log.info("Game", "Wrote script profile to " + scriptProfilePath);
+    } else {
+        log.error("Game", "Failed to write script profile to " +
+                              scriptProfilePath);
+    }
+}
+
 void RWGame::globalKeyEvent(const SDL_Event& event) {
     const auto toggle_debug = [&](DebugViewMode m) {
         debugview_ = debugview_ == m ? DebugViewMode::Disabled : m;
@@ -965,6 +1280,22 @@ void RWGame::globalKeyEvent(const SDL_Event& event) {
         case SDLK_F4:
             toggle_debug(DebugViewMode::Objects);
             break;
+        case SDLK_F5:
+            writeProfilerTrace();
+            break;
+        case SDLK_F6:
+            // Starts profiling the script, or stops and writes the report
+            if (vm) {
+                auto& profiler = vm->getProfiler();
+                if (profiler.isEnabled()) {
+                    profiler.setEnabled(false);
+                    writeScriptProfile();
+                } else {
+                    profiler.reset();
+                    profiler.setEnabled(true);
+                }
+            }
+            break;
         default:
             break;
     }
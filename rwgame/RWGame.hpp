@@ -9,6 +9,7 @@
 #include <engine/GameData.hpp>
 #include <engine/GameState.hpp>
 #include <engine/GameWorld.hpp>
+#include <engine/Replay.hpp>
 #include <render/DebugDraw.hpp>
 #include <render/GameRenderer.hpp>
 #include <script/SCMFile.hpp>
@@ -18,6 +19,9 @@
 #include <SDL_events.h>
 
 #include <chrono>
+#include <fstream>
+#include <future>
+#include <memory>
 
 class RWGame final : public GameBase {
     GameData data;
@@ -50,6 +54,37 @@ class RWGame final : public GameBase {
 
     std::string cheatInputWindow = std::string(32, ' ');
 
+    /// Game time to simulate before quitting, if limited
+    std::optional<float> maxRunTime;
+
+    /// Where the trace profiler writes its trace
+    std::string tracePath = "openrw-trace.json";
+
+    /// Where the script profiler writes its report
+    std::string scriptProfilePath = "openrw-script-profile.txt";
+    /// Whether to profile the script from the start
+    bool scriptProfile = false;
+
+    /// Seed for new worlds, set when recording or playing back a replay
+    std::optional<uint32_t> randomSeed;
+    std::ofstream replayOut;
+    std::unique_ptr<ReplayWriter> replayWriter;
+    std::ifstream replayIn;
+    std::unique_ptr<ReplayReader> replayReader;
+    bool replayDiverged = false;
+
+    /// Number of fixed steps simulated so far
+    uint64_t simulationTicks = 0;
+
+    /// Save being written in the background, and where it is written to
+    std::future<std::string> pendingSave;
+    std::string pendingSavePath;
+
+    /// Game time between headless saves, if saving periodically
+    std::optional<float> saveInterval;
+    /// Where the periodic saves are written
+    std::string saveIntervalPath = "openrw-save.b";
+
 public:
     RWGame(Logger& log, const std::optional<RWArgConfigLayer> &args);
     ~RWGame() override;
@@ -106,6 +141,39 @@ public:
     void loadGame(const std::string& savename);
 
 private:
+    /**
+     * Steps the simulation as fast as possible without rendering
+     */
+    int runHeadless();
+
+    /**
+     * Records the frame, or replaces the frame time and camera with the
+     * recorded ones.
+     * @return false once the replay is over
+     */
+    bool replayFrame(float& frameTime);
+
+    /**
+     * Called around the state's tick to record or play back the tick's input
+     * @return false once the replay is over
+     */
+    bool replayTickInput();
+    void replayTickLook();
+
+    /**
+     * Records or compares the object transform checksum every few ticks
+     * @return false if playback no longer matches the recording
+     */
+    bool replayTickChecksum();
+
+    void stopReplay(const std::string& reason);
+
+    /**
+     * Reports the background save once it has been written
+     * @param wait block until the save is written
+     */
+    void pollSave(bool wait = false);
+
     void tick(float dt);
     void render(float alpha, float dt);
 
@@ -117,6 +185,16 @@ private:
 
     void globalKeyEvent(const SDL_Event& event);
 
+    /**
+     * Writes the events recorded so far, if built with the trace profiler
+     */
+    void writeProfilerTrace();
+
+    /**
+     * Writes the script profiler's report, if it recorded anything
+     */
+    void writeScriptProfile();
+
     bool updateInput();
 
     float tickWorld(const float deltaTime, float accumulatedTime);
@@ -2,18 +2,33 @@
 #include <engine/GameState.hpp>
 #include "RWGame.hpp"
 
+#include <core/FrameStats.hpp>
+#include <rw/filesystem.hpp>
+
 #include <glm/gtc/quaternion.hpp>
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 
-BenchmarkState::BenchmarkState(RWGame* game, const std::string& benchfile)
-    : State(game), benchfile(benchfile) {
+BenchmarkState::BenchmarkState(RWGame* game, const std::string& benchfile,
+                               const Options& options)
+    : State(game)
+    , benchfile(benchfile)
+    , options(options)
+    , warmingUp(options.warmUp > 0.f)
+    , results(benchfile) {
 }
 
 void BenchmarkState::enter() {
     getWindow().hideCursor();
 
+    // Resuming after another state, keep going where we were
+    if (!track.empty()) {
+        lastFrame.reset();
+        return;
+    }
+
     std::ifstream benchstream(benchfile);
 
     unsigned int clockHour;
@@ -60,40 +75,100 @@ void BenchmarkState::enter() {
 }
 
 void BenchmarkState::exit() {
-    std::cout << "Results =============\n"
-              << "Benchmark: " << benchfile << "\n"
-              << "Frames: " << frameCounter << "\n"
-              << "Duration: " << duration << " seconds\n"
-              << "Avg frametime: " << std::setprecision(3)
-              << (duration / frameCounter) << " (" << (frameCounter / duration)
-              << " fps)" << std::endl;
+    // Only report once the benchmark is over, not when it is suspended
+    if (!hasExited()) {
+        return;
+    }
+
+    results.writeText(std::cout);
+    writeResults();
+}
+
+void BenchmarkState::writeResults() const {
+    if (!options.outputPath) {
+        return;
+    }
+
+    const auto& path = *options.outputPath;
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "Could not write benchmark results to " << path
+                  << std::endl;
+        return;
+    }
+
+    if (rwfs::path(path).extension() == ".csv") {
+        results.writeCSV(out);
+    } else {
+        results.writeJSON(out);
+    }
+    std::cout << "Results written to " << path << std::endl;
+}
+
+void BenchmarkState::restartTrack() {
+    benchmarkTime = 0.f;
+    cursor = 0;
+    // The frame spanning the restart belongs to neither run
+    lastFrame.reset();
 }
 
 void BenchmarkState::tick(float dt) {
-    if (!track.empty()) {
-        TrackPoint& a = track.front();
-        TrackPoint& b = track.back();
-        for (TrackPoint& p : track) {
-            if (benchmarkTime < p.time) {
-                b = p;
-                break;
-            }
-            a = p;
-        }
-        if (benchmarkTime > duration) {
+    if (track.empty()) {
+        done();
+        return;
+    }
+
+    float end = warmingUp ? std::min(options.warmUp, duration) : duration;
+    if (benchmarkTime > end) {
+        if (warmingUp) {
+            warmingUp = false;
+        } else if (++run >= options.runs) {
             done();
+            return;
         }
-        if (b.time != a.time) {
-            float alpha = (benchmarkTime - a.time) / (b.time - a.time);
-            trackCam.position = glm::mix(a.position, b.position, alpha);
-            trackCam.rotation = glm::slerp(a.angle, b.angle, alpha);
-        }
-        benchmarkTime += dt;
+        restartTrack();
     }
+
+    // Time only moves forward within a run, so the segment is found by
+    // moving on from the last one
+    while (cursor + 1 < track.size() &&
+           track[cursor + 1].time <= benchmarkTime) {
+        cursor++;
+    }
+
+    const TrackPoint& a = track[cursor];
+    const TrackPoint& b = track[std::min(cursor + 1, track.size() - 1)];
+    if (b.time != a.time) {
+        float alpha = (benchmarkTime - a.time) / (b.time - a.time);
+        trackCam.position = glm::mix(a.position, b.position, alpha);
+        trackCam.rotation = glm::slerp(a.angle, b.angle, alpha);
+    } else {
+        trackCam.position = a.position;
+        trackCam.rotation = a.angle;
+    }
+    benchmarkTime += dt;
 }
 
 void BenchmarkState::draw(GameRenderer& r) {
-    frameCounter++;
+    auto now = std::chrono::steady_clock::now();
+    if (!warmingUp && lastFrame) {
+        BenchmarkResults::Frame frame;
+        frame.run = run;
+        frame.frameTime =
+            std::chrono::duration<float, std::milli>(now - *lastFrame)
+                .count();
+        for (size_t s = 0; s < FrameStats::SectionCount; ++s) {
+            frame.sections[s] =
+                FrameStats::getTime(static_cast<FrameStats::Section>(s));
+        }
+        auto& renderer = r.getRenderer();
+        frame.draws = renderer.getDrawCount();
+        frame.textures = renderer.getTextureCount();
+        frame.buffers = renderer.getBufferCount();
+        results.addFrame(frame);
+    }
+    lastFrame = now;
+
     State::draw(r);
 }
 
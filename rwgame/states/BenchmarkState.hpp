@@ -1,6 +1,7 @@
 #ifndef _RWGAME_BENCHMARKSTATE_HPP_
 #define _RWGAME_BENCHMARKSTATE_HPP_
 
+#include "BenchmarkResults.hpp"
 #include "State.hpp"
 
 #include <render/ViewCamera.hpp>
@@ -8,27 +9,52 @@
 #include <glm/gtc/quaternion.hpp>
 #include <glm/vec3.hpp>
 
+#include <chrono>
+#include <optional>
 #include <string>
 #include <vector>
 
 class BenchmarkState final : public State {
+public:
+    struct Options {
+        /// Seconds of the track to play before measuring anything
+        float warmUp = 0.f;
+        /// Number of times the track is measured
+        unsigned runs = 1;
+        /// Results are also written here, as CSV for .csv files else JSON
+        std::optional<std::string> outputPath;
+    };
+
+private:
     struct TrackPoint {
         float time;
         glm::vec3 position{};
         glm::quat angle{1.0f,0.0f,0.0f,0.0f};
     };
     std::vector<TrackPoint> track;
+    /// Index of the point the camera last passed
+    size_t cursor = 0;
 
     ViewCamera trackCam;
 
     std::string benchfile;
+    Options options;
 
     float benchmarkTime{0.f};
     float duration{0.f};
-    uint32_t frameCounter{0};
+    bool warmingUp = false;
+    unsigned run = 0;
+
+    BenchmarkResults results;
+    std::optional<std::chrono::steady_clock::time_point> lastFrame;
+
+    void restartTrack();
+
+    void writeResults() const;
 
 public:
-    BenchmarkState(RWGame* game, const std::string& benchfile);
+    BenchmarkState(RWGame* game, const std::string& benchfile,
+                   const Options& options = {});
 
     void enter() override;
 
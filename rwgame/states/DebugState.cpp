@@ -64,7 +64,12 @@ Menu DebugState::createDebugMenu() {
          {"Full Health", [=] { player->getCurrentState().health = 100.f; }},
          {"Full Armour", [=] { player->getCurrentState().armour = 100.f; }},
          {"Cull Here",
-          [=] { game->getRenderer().setCullOverride(true, _debugCam); }}},
+          [=] { game->getRenderer().setCullOverride(true, _debugCam); }},
+         {"Toggle Occlusion Culling",
+          [=] {
+              auto& renderer = game->getRenderer();
+              renderer.setOcclusionCulling(!renderer.getOcclusionCulling());
+          }}},
         kDebugMenuOffset,
         kDebugFont,
         kDebugEntryHeight};
@@ -519,11 +524,11 @@ void DebugState::spawnFollower(unsigned int id) {
     auto ch = game->getWorld()->getPlayer()->getCharacter();
     if (!ch) return;
 
-    glm::vec3 fwd = ch->rotation * glm::vec3(0.f, 1.f, 0.f);
+    glm::vec3 fwd = ch->getRotation() * glm::vec3(0.f, 1.f, 0.f);
 
     glm::vec3 hit{}, normal{};
-    if (game->hitWorldRay(ch->position + (fwd * 10.f), {0.f, 0.f, -2.f}, hit,
-                          normal)) {
+    if (game->hitWorldRay(ch->getPosition() + (fwd * 10.f), {0.f, 0.f, -2.f},
+                          hit, normal)) {
         auto spawnPos = hit + normal;
         auto follower = game->getWorld()->createPedestrian(id, spawnPos);
         jumpCharacter(game, follower, spawnPos);
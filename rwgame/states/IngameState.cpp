@@ -393,11 +393,12 @@ const ViewCamera& IngameState::getCamera(float alpha) {
             std::min(world->getGameTime() - state->cutsceneStartTime,
                      cutscene->tracks.duration);
         cutsceneTime += GAME_TIMESTEP * alpha;
-        glm::vec3 cameraPos = cutscene->tracks.getPositionAt(cutsceneTime),
-                  targetPos = cutscene->tracks.getTargetAt(cutsceneTime);
-        float zoom = cutscene->tracks.getZoomAt(cutsceneTime);
+        const auto& tracks = cutscene->tracks;
+        auto cameraPos = tracks.getPositionAt(cutsceneTime, cutsceneCursor);
+        auto targetPos = tracks.getTargetAt(cutsceneTime, cutsceneCursor);
+        float zoom = tracks.getZoomAt(cutsceneTime, cutsceneCursor);
         _look.frustum.fov = glm::radians(zoom);
-        float tilt = cutscene->tracks.getRotationAt(cutsceneTime);
+        float tilt = tracks.getRotationAt(cutsceneTime, cutsceneCursor);
 
         auto direction = glm::normalize(targetPos - cameraPos);
         auto right =
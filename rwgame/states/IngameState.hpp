@@ -3,6 +3,7 @@
 
 #include "State.hpp"
 
+#include <data/CutsceneData.hpp>
 #include <render/ViewCamera.hpp>
 
 #include <glm/vec2.hpp>
@@ -31,6 +32,8 @@ class IngameState final : public State {
     /** Timer to hold user camera position */
     float autolookTimer{0.f};
     CameraMode camMode{IngameState::CAMERA_NORMAL};
+    /// Playback position in the cutscene camera tracks
+    CutsceneTracks::Cursor cutsceneCursor{};
 
     /// Player camera input since the last update
     glm::vec2 cameradelta_{};
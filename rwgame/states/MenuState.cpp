@@ -6,14 +6,16 @@
 #include "MenuSystem.hpp"
 #include "game.hpp"
 
-#include <engine/SaveGame.hpp>
 #include <rw/debug.hpp>
 
+#include <chrono>
+
 MenuState::MenuState(RWGame* game) : State(game) {
     enterMainMenu();
 }
 
 void MenuState::enterMainMenu() {
+    loadMenuOpen = false;
     auto& t = game->getGameData().texts;
 
     Menu menu{
@@ -32,10 +34,19 @@ void MenuState::enterMainMenu() {
 }
 
 void MenuState::enterLoadMenu() {
+    // The saves are listed once they have been found, until then the menu
+    // only has the way back
+    loadMenuOpen = true;
+    if (!saveScan.valid()) {
+        saveScan = SaveGame::getAllSaveGameInfoAsync();
+    }
+    showSaves({});
+}
+
+void MenuState::showSaves(const std::vector<SaveGameInfo>& saves) {
     Menu menu{{{"BACK", [=] { enterMainMenu(); }}}, glm::vec2(20.f, 30.f)};
 
-    auto saves = SaveGame::getAllSaveGameInfo();
-    for (SaveGameInfo& save : saves) {
+    for (const SaveGameInfo& save : saves) {
         if (save.valid) {
             std::stringstream ss;
             ss << save.basicState.saveTime.year << " "
@@ -67,6 +78,14 @@ void MenuState::exit() {
 
 void MenuState::tick(float dt) {
     RW_UNUSED(dt);
+
+    if (saveScan.valid() && saveScan.wait_for(std::chrono::seconds(0)) ==
+                                std::future_status::ready) {
+        const auto saves = saveScan.get();
+        if (loadMenuOpen) {
+            showSaves(saves);
+        }
+    }
 }
 
 void MenuState::handleEvent(const SDL_Event& e) {
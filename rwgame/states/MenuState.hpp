@@ -3,6 +3,11 @@
 
 #include "State.hpp"
 
+#include <engine/SaveGame.hpp>
+
+#include <future>
+#include <vector>
+
 class MenuState final : public State {
 public:
     MenuState(RWGame* game);
@@ -17,6 +22,13 @@ public:
     virtual void enterLoadMenu();
 
     void handleEvent(const SDL_Event& event) override;
+
+private:
+    void showSaves(const std::vector<SaveGameInfo>& saves);
+
+    /// Saves being found for the load menu
+    std::future<std::vector<SaveGameInfo>> saveScan;
+    bool loadMenuOpen = false;
 };
 
 #endif  // MENUSTATE_HPP
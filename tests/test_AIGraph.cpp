@@ -0,0 +1,204 @@
+#include <boost/test/unit_test.hpp>
+
+#include <ai/AIGraph.hpp>
+#include <ai/AIGraphNode.hpp>
+#include <ai/RoutePlanner.hpp>
+#include <data/PathData.hpp>
+
+#include <glm/gtx/norm.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <random>
+
+namespace {
+const glm::quat kIdentity{1.0f, 0.0f, 0.0f, 0.0f};
+
+/// Adds a straight path of external nodes from start in steps of step
+void addLine(ai::AIGraph& graph, PathData::PathType type,
+             const glm::vec3& start, const glm::vec3& step, int count) {
+    PathData path{type, 0, "", {}};
+    for (int i = 0; i < count; ++i) {
+        path.nodes.push_back({PathNode::EXTERNAL, i + 1 < count ? i + 1 : -1,
+                              start + step * static_cast<float>(i), 1.f, 1,
+                              1});
+    }
+    graph.createPathNodes(glm::vec3(), kIdentity, path);
+}
+
+/// Lines crossing every spacing units, welded into a size x size grid
+void addGrid(ai::AIGraph& graph, PathData::PathType type, int size,
+             float spacing) {
+    for (int i = 0; i < size; ++i) {
+        const auto offset = static_cast<float>(i) * spacing;
+        addLine(graph, type, {0.f, offset, 0.f}, {spacing, 0.f, 0.f}, size);
+        addLine(graph, type, {offset, 0.f, 0.f}, {0.f, spacing, 0.f}, size);
+    }
+}
+
+ai::AIGraphNode* nodeAt(ai::AIGraph& graph, const glm::vec3& position) {
+    for (auto& node : graph.nodes) {
+        if (glm::distance2(node->position, position) < 0.01f) {
+            return node.get();
+        }
+    }
+    return nullptr;
+}
+
+float routeLength(const std::vector<ai::AIGraphNode*>& route) {
+    float length = 0.f;
+    for (size_t i = 1; i < route.size(); ++i) {
+        length += glm::distance(route[i - 1]->position, route[i]->position);
+    }
+    return length;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(AIGraphTests)
+
+BOOST_AUTO_TEST_CASE(test_external_nodes_welded) {
+    ai::AIGraph graph;
+    addGrid(graph, PathData::PATH_CAR, 4, 10.f);
+
+    BOOST_CHECK_EQUAL(graph.nodes.size(), 16u);
+    BOOST_CHECK_EQUAL(graph.externalNodes.size(), 16u);
+    for (size_t i = 0; i < graph.nodes.size(); ++i) {
+        BOOST_CHECK_EQUAL(graph.nodes[i]->index, i);
+    }
+
+    auto corner = nodeAt(graph, {0.f, 0.f, 0.f});
+    auto middle = nodeAt(graph, {10.f, 10.f, 0.f});
+    BOOST_REQUIRE(corner && middle);
+    BOOST_CHECK_EQUAL(corner->connections.size(), 2u);
+    BOOST_CHECK_EQUAL(middle->connections.size(), 4u);
+
+    BOOST_CHECK_EQUAL(graph.findExternalNode({10.5f, 10.f, 0.f}, 1.f), middle);
+    BOOST_CHECK(graph.findExternalNode({15.f, 15.f, 0.f}, 1.f) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(test_nearest_node) {
+    ai::AIGraph graph;
+
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> coord(-2500.f, 2500.f);
+    for (int i = 0; i < 200; ++i) {
+        PathData path{i % 2 ? PathData::PATH_CAR : PathData::PATH_PED,
+                      0,
+                      "",
+                      {{PathNode::INTERNAL, -1, {coord(rng), coord(rng), 0.f},
+                        1.f, 1, 1}}};
+        graph.createPathNodes(glm::vec3(), kIdentity, path);
+    }
+
+    const auto accept = [](const ai::AIGraphNode& node) {
+        return node.position.x > 0.f;
+    };
+
+    for (int i = 0; i < 200; ++i) {
+        glm::vec3 point(coord(rng), coord(rng), 0.f);
+        for (auto type : {ai::NodeType::Pedestrian, ai::NodeType::Vehicle}) {
+            ai::AIGraphNode* expected = nullptr;
+            ai::AIGraphNode* expectedFiltered = nullptr;
+            float best = std::numeric_limits<float>::max();
+            float bestFiltered = best;
+            for (auto& node : graph.nodes) {
+                if (node->type != type) {
+                    continue;
+                }
+                float d = glm::distance2(point, node->position);
+                if (d < best) {
+                    best = d;
+                    expected = node.get();
+                }
+                if (accept(*node) && d < bestFiltered) {
+                    bestFiltered = d;
+                    expectedFiltered = node.get();
+                }
+            }
+            BOOST_CHECK_EQUAL(graph.findNearestNode(point, type), expected);
+            BOOST_CHECK_EQUAL(graph.findNearestNode(point, type, accept),
+                              expectedFiltered);
+        }
+    }
+
+    ai::AIGraph empty;
+    BOOST_CHECK(empty.findNearestNode({}, ai::NodeType::Vehicle) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(test_route) {
+    ai::AIGraph graph;
+    addGrid(graph, PathData::PATH_CAR, 8, 10.f);
+    ai::RoutePlanner planner(graph);
+
+    auto start = nodeAt(graph, {0.f, 0.f, 0.f});
+    auto goal = nodeAt(graph, {70.f, 30.f, 0.f});
+    std::vector<ai::AIGraphNode*> route;
+    BOOST_REQUIRE(planner.findRoute(start, goal, route));
+    BOOST_CHECK_EQUAL(route.front(), start);
+    BOOST_CHECK_EQUAL(route.back(), goal);
+    BOOST_CHECK_CLOSE(routeLength(route), 100.f, 0.01f);
+    for (size_t i = 1; i < route.size(); ++i) {
+        const auto& connections = route[i - 1]->connections;
+        BOOST_CHECK(std::find(connections.begin(), connections.end(),
+                              route[i]) != connections.end());
+    }
+
+    // The planner doesn't explore the whole grid for a nearby goal
+    BOOST_REQUIRE(
+        planner.findRoute(start, nodeAt(graph, {10.f, 0.f, 0.f}), route));
+    BOOST_CHECK_EQUAL(route.size(), 2u);
+    BOOST_CHECK_LT(planner.getExpandedCount(), graph.nodes.size() / 2);
+
+    BOOST_REQUIRE(planner.findRoute(start, start, route));
+    BOOST_CHECK_EQUAL(route.size(), 1u);
+
+    // Positions are snapped to the closest nodes
+    BOOST_REQUIRE(planner.findRoute({1.f, -1.f, 0.f}, {69.f, 31.f, 0.f},
+                                    ai::NodeType::Vehicle, route));
+    BOOST_CHECK_EQUAL(route.front(), start);
+    BOOST_CHECK_EQUAL(route.back(), goal);
+}
+
+BOOST_AUTO_TEST_CASE(test_route_avoids_disabled) {
+    ai::AIGraph graph;
+    addLine(graph, PathData::PATH_CAR, {0.f, 0.f, 0.f}, {10.f, 0.f, 0.f}, 5);
+    // A detour around the middle of the line
+    addLine(graph, PathData::PATH_CAR, {10.f, 0.f, 0.f}, {0.f, 10.f, 0.f}, 2);
+    addLine(graph, PathData::PATH_CAR, {10.f, 10.f, 0.f}, {10.f, 0.f, 0.f}, 3);
+    addLine(graph, PathData::PATH_CAR, {30.f, 10.f, 0.f}, {0.f, -10.f, 0.f},
+            2);
+    ai::RoutePlanner planner(graph);
+
+    auto start = nodeAt(graph, {0.f, 0.f, 0.f});
+    auto goal = nodeAt(graph, {40.f, 0.f, 0.f});
+    std::vector<ai::AIGraphNode*> route;
+    BOOST_REQUIRE(planner.findRoute(start, goal, route));
+    BOOST_CHECK_CLOSE(routeLength(route), 40.f, 0.01f);
+
+    auto blocked = nodeAt(graph, {20.f, 0.f, 0.f});
+    blocked->disabled = true;
+    BOOST_REQUIRE(planner.findRoute(start, goal, route));
+    BOOST_CHECK_CLOSE(routeLength(route), 60.f, 0.01f);
+    BOOST_CHECK(std::find(route.begin(), route.end(), blocked) == route.end());
+
+    nodeAt(graph, {20.f, 10.f, 0.f})->disabled = true;
+    BOOST_CHECK(!planner.findRoute(start, goal, route));
+    BOOST_CHECK(route.empty());
+    BOOST_CHECK(!planner.findRoute(start, blocked, route));
+}
+
+BOOST_AUTO_TEST_CASE(test_route_keeps_to_type) {
+    ai::AIGraph graph;
+    addLine(graph, PathData::PATH_PED, {0.f, 0.f, 0.f}, {10.f, 0.f, 0.f}, 3);
+    addLine(graph, PathData::PATH_CAR, {100.f, 0.f, 0.f}, {10.f, 0.f, 0.f}, 3);
+    ai::RoutePlanner planner(graph);
+
+    std::vector<ai::AIGraphNode*> route;
+    BOOST_CHECK(!planner.findRoute(nodeAt(graph, {0.f, 0.f, 0.f}),
+                                   nodeAt(graph, {120.f, 0.f, 0.f}), route));
+    BOOST_CHECK(planner.findRoute(nodeAt(graph, {0.f, 0.f, 0.f}),
+                                  nodeAt(graph, {20.f, 0.f, 0.f}), route));
+    BOOST_CHECK_EQUAL(route.size(), 3u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
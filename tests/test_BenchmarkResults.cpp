@@ -0,0 +1,120 @@
+#include <boost/test/unit_test.hpp>
+#include <BenchmarkResults.hpp>
+
+#include <sstream>
+#include <string>
+
+namespace {
+BenchmarkResults::Frame makeFrame(float frameTime, unsigned run = 0) {
+    BenchmarkResults::Frame frame;
+    frame.run = run;
+    frame.frameTime = frameTime;
+    frame.sections[FrameStats::TickWorld] = frameTime / 2.f;
+    frame.draws = 10;
+    return frame;
+}
+
+size_t countLines(const std::string& str) {
+    size_t lines = 0;
+    for (char c : str) {
+        lines += c == '\n';
+    }
+    return lines;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(BenchmarkResultsTests)
+
+BOOST_AUTO_TEST_CASE(test_summarize_empty) {
+    auto summary = BenchmarkResults::summarize({});
+    BOOST_CHECK_EQUAL(summary.count, 0);
+    BOOST_CHECK_EQUAL(summary.max, 0.f);
+}
+
+BOOST_AUTO_TEST_CASE(test_summarize_percentiles) {
+    // 1..100 shuffled, so the ranks are easy to check
+    std::vector<float> values;
+    for (int i = 0; i < 100; ++i) {
+        values.push_back(static_cast<float>((i * 37) % 100 + 1));
+    }
+
+    auto summary = BenchmarkResults::summarize(values);
+    BOOST_CHECK_EQUAL(summary.count, 100);
+    BOOST_CHECK_EQUAL(summary.min, 1.f);
+    BOOST_CHECK_EQUAL(summary.median, 50.f);
+    BOOST_CHECK_EQUAL(summary.p95, 95.f);
+    BOOST_CHECK_EQUAL(summary.p99, 99.f);
+    BOOST_CHECK_EQUAL(summary.max, 100.f);
+    BOOST_CHECK_CLOSE(summary.mean, 50.5f, 0.001f);
+}
+
+BOOST_AUTO_TEST_CASE(test_summarize_single_value) {
+    auto summary = BenchmarkResults::summarize({4.f});
+    BOOST_CHECK_EQUAL(summary.min, 4.f);
+    BOOST_CHECK_EQUAL(summary.median, 4.f);
+    BOOST_CHECK_EQUAL(summary.p99, 4.f);
+    BOOST_CHECK_EQUAL(summary.max, 4.f);
+}
+
+BOOST_AUTO_TEST_CASE(test_runs_and_sections) {
+    BenchmarkResults results("test");
+    results.addFrame(makeFrame(10.f, 0));
+    results.addFrame(makeFrame(20.f, 0));
+    results.addFrame(makeFrame(30.f, 1));
+
+    BOOST_CHECK_EQUAL(results.getRunCount(), 2);
+    BOOST_CHECK_EQUAL(results.summarizeRun(0).count, 2);
+    BOOST_CHECK_EQUAL(results.summarizeRun(1).min, 30.f);
+    BOOST_CHECK_EQUAL(results.summarizeSection(FrameStats::TickWorld).max,
+                      15.f);
+    BOOST_CHECK_EQUAL(
+        results.summarizeSection(FrameStats::DrawBatched).max, 0.f);
+}
+
+BOOST_AUTO_TEST_CASE(test_histogram) {
+    BenchmarkResults results("test");
+    results.addFrame(makeFrame(0.5f));
+    results.addFrame(makeFrame(1.5f));
+    results.addFrame(makeFrame(2.5f));
+    results.addFrame(makeFrame(1000.f));
+
+    auto histogram = results.getHistogram();
+    BOOST_REQUIRE_EQUAL(histogram.size(), BenchmarkResults::kBucketCount);
+    BOOST_CHECK_EQUAL(histogram[0], 2);
+    BOOST_CHECK_EQUAL(histogram[1], 1);
+    BOOST_CHECK_EQUAL(histogram.back(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_write_csv) {
+    BenchmarkResults results("test");
+    results.addFrame(makeFrame(10.f));
+    results.addFrame(makeFrame(12.f));
+
+    std::ostringstream out;
+    results.writeCSV(out);
+    auto csv = out.str();
+
+    // A header and one row per frame
+    BOOST_CHECK_EQUAL(countLines(csv), 3);
+    BOOST_CHECK_EQUAL(csv.substr(0, csv.find('\n')),
+                      "run,frame_ms,tickWorld_ms,stepSimulation_ms,"
+                      "createObjectRenderList_ms,drawBatched_ms,draws,"
+                      "textures,buffers");
+}
+
+BOOST_AUTO_TEST_CASE(test_write_json) {
+    BenchmarkResults results("bench\"mark");
+    results.addFrame(makeFrame(10.f));
+
+    std::ostringstream out;
+    results.writeJSON(out);
+    auto json = out.str();
+
+    BOOST_CHECK(json.find("\"benchmark\": \"bench\\\"mark\"") !=
+                std::string::npos);
+    BOOST_CHECK(json.find("\"frames\": 1") != std::string::npos);
+    BOOST_CHECK(json.find("\"p99\": 10") != std::string::npos);
+    BOOST_CHECK(json.find("\"drawBatched\"") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -47,6 +47,8 @@ simpleConfig_t getValidConfig() {
     result["input"]["invert_y"] =
         "1 #values != 0 enable input inversion. Optional.";
     result["game"]["hud_scale"] = "2.0\t;HUD scale";
+    result["game"]["lod_bias"] = "0.5";
+    result["game"]["occlusion_culling"] = "0";
     return result;
 }
 
@@ -293,11 +295,15 @@ BOOST_AUTO_TEST_CASE(test_configParser_valid) {
     BOOST_REQUIRE(cfgLayer.gameLanguage.has_value());
     BOOST_REQUIRE(cfgLayer.invertY.has_value());
     BOOST_REQUIRE(cfgLayer.hudScale.has_value());
+    BOOST_REQUIRE(cfgLayer.lodBias.has_value());
+    BOOST_REQUIRE(cfgLayer.occlusionCulling.has_value());
 
     BOOST_CHECK_EQUAL(*cfgLayer.gamedataPath, "/dev/test");
     BOOST_CHECK_EQUAL(*cfgLayer.gameLanguage, "american");
     BOOST_CHECK(*cfgLayer.invertY);
     BOOST_CHECK_EQUAL(*cfgLayer.hudScale, 2.f);
+    BOOST_CHECK_EQUAL(*cfgLayer.lodBias, 0.5f);
+    BOOST_CHECK(!*cfgLayer.occlusionCulling);
 }
 
 BOOST_AUTO_TEST_CASE(test_configParser_valid_modified) {
@@ -638,6 +644,19 @@ BOOST_AUTO_TEST_CASE(test_argParser_int) {
     BOOST_CHECK_EQUAL(*optLayer->width, width);
 }
 
+BOOST_AUTO_TEST_CASE(test_argParser_save_interval) {
+    RWArgumentParser argParser;
+    const char *args[] = {"", "--save-interval", "30", "--save-output",
+                          "/some/path"};
+    auto optLayer = argParser.parseArguments(5, args);
+
+    BOOST_REQUIRE(optLayer.has_value());
+    BOOST_REQUIRE(optLayer->saveInterval.has_value());
+    BOOST_CHECK_EQUAL(*optLayer->saveInterval, 30.f);
+    BOOST_REQUIRE(optLayer->saveOutput.has_value());
+    BOOST_CHECK_EQUAL(*optLayer->saveOutput, "/some/path");
+}
+
 BOOST_AUTO_TEST_CASE(test_argParser_incomplete_optional) {
     RWArgumentParser argParser;
     const char *args[] = {"", "--hel"};
@@ -699,6 +718,25 @@ BOOST_AUTO_TEST_CASE(test_argParser_bool_invert_y) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(test_argParser_bool_occlusion_culling) {
+    RWArgumentParser argParser;
+    {
+        const char *args[] = {""};
+        auto optLayer = argParser.parseArguments(1, args);
+
+        BOOST_REQUIRE(optLayer.has_value());
+        BOOST_CHECK(!optLayer->occlusionCulling.has_value());
+        BOOST_CHECK(!optLayer->noOcclusionCulling);
+    }
+    {
+        const char *args[] = {"", "--no-occlusion-culling"};
+        auto optLayer = argParser.parseArguments(2, args);
+
+        BOOST_REQUIRE(optLayer.has_value());
+        BOOST_CHECK(optLayer->noOcclusionCulling);
+    }
+}
+
 BOOST_AUTO_TEST_CASE(test_rwconfig_initial) {
     RWConfig config;
     auto missingKeys = config.missingKeys();
@@ -1,9 +1,14 @@
 #include <boost/test/unit_test.hpp>
 #include <data/CutsceneData.hpp>
+#include <engine/GameData.hpp>
+#include <engine/GameState.hpp>
+#include <engine/GameWorld.hpp>
 #include <loaders/LoaderCutsceneDAT.hpp>
 #include <platform/FileHandle.hpp>
 #include "test_Globals.hpp"
 
+#include <algorithm>
+
 BOOST_AUTO_TEST_SUITE(CutsceneTests, DATA_TEST_PREDICATE)
 
 BOOST_AUTO_TEST_CASE(test_load) {
@@ -16,17 +21,38 @@ BOOST_AUTO_TEST_CASE(test_load) {
 
         loader.load(tracks, d);
 
-        BOOST_CHECK(tracks.position.find(0.f) != tracks.position.end());
-        BOOST_CHECK(tracks.position.find(64.8f) != tracks.position.end());
+        BOOST_REQUIRE(!tracks.position.empty());
+        BOOST_CHECK_EQUAL(tracks.position.getTimes().front(), 0.f);
+        BOOST_CHECK_EQUAL(tracks.position.getTimes().back(), 64.8f);
 
-        BOOST_CHECK(tracks.zoom.find(64.8f) != tracks.zoom.end());
+        BOOST_REQUIRE(!tracks.zoom.empty());
+        BOOST_CHECK_EQUAL(tracks.zoom.getTimes().back(), 64.8f);
 
-        BOOST_CHECK(tracks.zoom.find(64.8f) != tracks.zoom.end());
+        BOOST_REQUIRE(!tracks.target.empty());
+        BOOST_CHECK_EQUAL(tracks.target.getTimes().back(), 64.8f);
 
-        BOOST_CHECK(tracks.target.find(64.8f) != tracks.target.end());
+        const auto& times = tracks.position.getTimes();
+        BOOST_CHECK(std::is_sorted(times.begin(), times.end()));
 
         BOOST_CHECK(tracks.duration == 64.8f);
     }
 }
 
+BOOST_AUTO_TEST_CASE(test_preload) {
+    auto world = Global::get().e;
+
+    world->preloadCutscene("intro");
+    BOOST_REQUIRE(world->state->currentCutscene);
+    BOOST_CHECK_EQUAL(world->state->currentCutscene->meta.name, "intro");
+
+    world->finishCutsceneLoad();
+    BOOST_CHECK(world->isCutsceneReady());
+    BOOST_CHECK_EQUAL(world->state->currentCutscene->tracks.duration, 64.8f);
+    BOOST_CHECK(!world->data->animationsCutscene.empty());
+
+    world->clearCutscene();
+    BOOST_CHECK(!world->state->currentCutscene);
+    BOOST_CHECK(world->data->animationsCutscene.empty());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -1,7 +1,15 @@
 #include <boost/test/unit_test.hpp>
 #include <engine/GameData.hpp>
+#include <engine/GameState.hpp>
 #include <engine/GameWorld.hpp>
+#include <engine/WorldCheckpoint.hpp>
+#include <objects/CharacterObject.hpp>
 #include <objects/InstanceObject.hpp>
+#include <objects/PickupObject.hpp>
+#include <objects/VehicleObject.hpp>
+
+#include <algorithm>
+
 #include "test_Globals.hpp"
 
 BOOST_AUTO_TEST_SUITE(GameWorldTests, DATA_TEST_PREDICATE)
@@ -67,4 +75,135 @@ BOOST_AUTO_TEST_CASE(test_offsetgametime) {
     BOOST_CHECK_EQUAL(25, gw.getMinute());
 }
 
+BOOST_AUTO_TEST_CASE(test_checkpoint_restore) {
+    auto& gw = *Global::get().e;
+    auto previousState = gw.state;
+    GameState state;
+    state.world = &gw;
+    gw.state = &state;
+
+    auto kept = gw.createVehicle(90u, glm::vec3(10.f, 0.f, 0.f));
+    auto removed = gw.createVehicle(90u, glm::vec3(20.f, 0.f, 0.f));
+    BOOST_REQUIRE(kept != nullptr && removed != nullptr);
+    const auto keptID = kept->getGameObjectID();
+    const auto removedID = removed->getGameObjectID();
+    state.playerInfo.money = 100;
+
+    const auto checkpoint = gw.createCheckpoint();
+    const auto vehicleCount = gw.vehiclePool.objects.size();
+
+    kept->setPosition(glm::vec3(50.f, 0.f, 0.f));
+    gw.destroyObject(removed);
+    // Takes the destroyed vehicle's ID, with a different model
+    gw.createVehicle(91u, glm::vec3(30.f, 0.f, 0.f));
+    gw.createVehicle(91u, glm::vec3(40.f, 0.f, 0.f));
+    state.playerInfo.money = 500;
+
+    gw.restoreCheckpoint(checkpoint);
+
+    BOOST_CHECK_EQUAL(state.playerInfo.money, 100);
+    BOOST_CHECK(state.world == &gw);
+    BOOST_CHECK_EQUAL(gw.vehiclePool.objects.size(), vehicleCount);
+
+    // Unchanged objects are reused
+    BOOST_CHECK_EQUAL(gw.vehiclePool.find(keptID), kept);
+    BOOST_CHECK_EQUAL(kept->getPosition(), glm::vec3(10.f, 0.f, 0.f));
+
+    auto restored =
+        static_cast<VehicleObject*>(gw.vehiclePool.find(removedID));
+    BOOST_REQUIRE(restored != nullptr);
+    BOOST_CHECK_EQUAL(restored->getVehicle()->id(), 90);
+    BOOST_CHECK_EQUAL(restored->getPosition(), glm::vec3(20.f, 0.f, 0.f));
+
+    gw.destroyObject(kept);
+    gw.destroyObject(restored);
+    gw.state = previousState;
+}
+
+BOOST_AUTO_TEST_CASE(test_checkpoint_restore_objects) {
+    auto& gw = *Global::get().e;
+    auto previousState = gw.state;
+    GameState state;
+    state.world = &gw;
+    gw.state = &state;
+
+    auto character = gw.createPedestrian(1, glm::vec3(10.f, 10.f, 0.f));
+    auto pickup =
+        gw.createPickup(glm::vec3(20.f, 10.f, 0.f), 24, PickupObject::InShop);
+    auto instance = gw.createInstance(1337, glm::vec3(30.f, 10.f, 0.f));
+    BOOST_REQUIRE(character != nullptr && pickup != nullptr &&
+                  instance != nullptr);
+    instance->setLifetime(GameObject::MissionLifetime);
+    state.missionObjects.push_back(instance);
+    const auto characterID = character->getGameObjectID();
+    const auto pickupID = pickup->getGameObjectID();
+    const auto instanceID = instance->getGameObjectID();
+
+    const auto checkpoint = gw.createCheckpoint();
+
+    // Everything is destroyed, then put back by the restore
+    gw.destroyObject(character);
+    gw.destroyObject(pickup);
+    gw.destroyObject(instance);
+    BOOST_CHECK(state.missionObjects.empty());
+
+    // Not in the checkpoint, so it's removed
+    auto added = gw.createInstance(1337, glm::vec3(40.f, 10.f, 0.f));
+    BOOST_REQUIRE(added != nullptr);
+    added->setLifetime(GameObject::MissionLifetime);
+    const auto addedID = added->getGameObjectID();
+
+    gw.restoreCheckpoint(checkpoint);
+
+    auto restoredCharacter = gw.pedestrianPool.find(characterID);
+    BOOST_REQUIRE(restoredCharacter != nullptr);
+    BOOST_CHECK_EQUAL(restoredCharacter->getPosition(),
+                      glm::vec3(10.f, 10.f, 0.f));
+
+    auto restoredPickup =
+        static_cast<PickupObject*>(gw.pickupPool.find(pickupID));
+    BOOST_REQUIRE(restoredPickup != nullptr);
+    BOOST_CHECK_EQUAL(restoredPickup->getPickupType(), PickupObject::InShop);
+    BOOST_CHECK_EQUAL(restoredPickup->getPosition(),
+                      glm::vec3(20.f, 10.f, 0.f));
+
+    auto restoredInstance = gw.instancePool.find(instanceID);
+    BOOST_REQUIRE(restoredInstance != nullptr);
+    BOOST_CHECK_EQUAL(restoredInstance->getLifetime(),
+                      GameObject::MissionLifetime);
+    BOOST_CHECK_EQUAL(restoredInstance->getPosition(),
+                      glm::vec3(30.f, 10.f, 0.f));
+    BOOST_REQUIRE_EQUAL(state.missionObjects.size(), 1);
+    BOOST_CHECK_EQUAL(state.missionObjects[0], restoredInstance);
+
+    BOOST_CHECK(gw.instancePool.find(addedID) == nullptr);
+
+    gw.destroyObject(restoredCharacter);
+    gw.destroyObject(restoredPickup);
+    gw.destroyObject(restoredInstance);
+    gw.state = previousState;
+}
+
+BOOST_AUTO_TEST_CASE(test_model_objects) {
+    auto& gw = *Global::get().e;
+    const auto count = [&](uint16_t model, GameObject* object) {
+        const auto& objects = gw.getModelObjects(model);
+        return std::count(objects.begin(), objects.end(), object);
+    };
+
+    auto first = gw.createVehicle(92u, glm::vec3(0.f, 0.f, 0.f));
+    auto second = gw.createVehicle(92u, glm::vec3(5.f, 0.f, 0.f));
+    BOOST_REQUIRE(first != nullptr && second != nullptr);
+    BOOST_CHECK_EQUAL(count(92u, first), 1);
+    BOOST_CHECK_EQUAL(count(92u, second), 1);
+    BOOST_CHECK_EQUAL(count(93u, first), 0);
+
+    gw.destroyObject(first);
+    BOOST_CHECK_EQUAL(count(92u, first), 0);
+    BOOST_CHECK_EQUAL(count(92u, second), 1);
+
+    gw.destroyObject(second);
+    BOOST_CHECK(gw.getModelObjects(92u).empty());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
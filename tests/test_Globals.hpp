@@ -9,13 +9,12 @@
 #pragma warning(default : 4305)
 #endif
 
-#include <SDL.h>
-#include <GameWindow.hpp>
 #include <boost/test/unit_test.hpp>
 #include <core/Logger.hpp>
 #include <engine/GameData.hpp>
 #include <engine/GameState.hpp>
 #include <engine/GameWorld.hpp>
+#include <gl/Headless.hpp>
 #include <objects/GameObject.hpp>
 #include <glm/gtx/string_cast.hpp>
 
@@ -84,7 +83,6 @@ BOOST_NS_MAGIC_CLOSING
 
 class Global {
 public:
-    GameWindow window;
     GameData* d;
     GameWorld* e;
     GameState* s;
@@ -94,11 +92,8 @@ public:
     Logger log;
 
     Global() {
-        if (SDL_Init(SDL_INIT_VIDEO) < 0)
-            throw std::runtime_error("Failed to initialize SDL2!");
-
-        window.create("Tests", 800, 600, false);
-        window.hideCursor();
+        // None of the tests draw anything, so they don't need a display
+        gl::setHeadless(true);
 
         d_ = std::make_unique<GameData>(&log, getGamePath());
         d = d_.get();
@@ -114,10 +109,6 @@ public:
         e->dynamicsWorld->setGravity(btVector3(0.f, 0.f, 0.f));
     }
 
-    ~Global() {
-        window.close();
-    }
-
     static std::string getGamePath();
 
     static Global& get() {
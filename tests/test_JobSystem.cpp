@@ -0,0 +1,157 @@
+#include <boost/test/unit_test.hpp>
+#include <core/JobSystem.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+const unsigned kWorkerCounts[] = {0, 1, 4};
+}
+
+BOOST_AUTO_TEST_SUITE(JobSystemTests)
+
+BOOST_AUTO_TEST_CASE(test_single_threaded_order) {
+    JobSystem jobs(0);
+    BOOST_CHECK(jobs.isSingleThreaded());
+
+    std::vector<int> order;
+    JobCounter counter;
+    for (int i = 0; i < 5; ++i) {
+        jobs.submit(counter, [&order, i] { order.push_back(i); });
+    }
+    jobs.wait(counter);
+
+    std::vector<int> expected{0, 1, 2, 3, 4};
+    BOOST_CHECK_EQUAL_COLLECTIONS(order.begin(), order.end(), expected.begin(),
+                                  expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(test_submit_and_wait) {
+    for (unsigned workers : kWorkerCounts) {
+        JobSystem jobs(workers);
+        BOOST_CHECK_EQUAL(jobs.getWorkerCount(), workers);
+
+        std::atomic<int> sum{0};
+        JobCounter counter;
+        for (int i = 1; i <= 100; ++i) {
+            jobs.submit(counter, [&sum, i] { sum += i; });
+        }
+        jobs.wait(counter);
+        BOOST_CHECK(counter.isDone());
+        BOOST_CHECK_EQUAL(sum.load(), 5050);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_parallel_for_covers_range) {
+    for (unsigned workers : kWorkerCounts) {
+        JobSystem jobs(workers);
+        for (size_t grain : {0, 1, 7, 64, 1000}) {
+            std::vector<std::atomic<int>> visits(1000);
+            std::atomic<size_t> largest{0};
+            jobs.parallelFor(0, visits.size(), grain,
+                             [&](size_t first, size_t last) {
+                                 size_t size = last - first;
+                                 size_t seen = largest.load();
+                                 while (size > seen &&
+                                        !largest.compare_exchange_weak(seen,
+                                                                       size)) {
+                                 }
+                                 for (size_t i = first; i < last; ++i) {
+                                     visits[i]++;
+                                 }
+                             });
+            for (auto& v : visits) {
+                BOOST_CHECK_EQUAL(v.load(), 1);
+            }
+            BOOST_CHECK_LE(largest.load(), std::max<size_t>(grain, 1));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_parallel_for_empty_range) {
+    JobSystem jobs(2);
+    bool called = false;
+    jobs.parallelFor(5, 5, 1, [&](size_t, size_t) { called = true; });
+    BOOST_CHECK(!called);
+}
+
+BOOST_AUTO_TEST_CASE(test_nested_wait) {
+    for (unsigned workers : kWorkerCounts) {
+        JobSystem jobs(workers);
+        std::atomic<int> count{0};
+        jobs.parallelFor(0, 8, 1, [&](size_t, size_t) {
+            jobs.parallelFor(0, 8, 1, [&](size_t, size_t) { count++; });
+        });
+        BOOST_CHECK_EQUAL(count.load(), 64);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_task_graph_order) {
+    for (unsigned workers : kWorkerCounts) {
+        JobSystem jobs(workers);
+
+        // A diamond: a -> (b, c) -> d
+        std::atomic<int> step{0};
+        int a = -1, b = -1, c = -1, d = -1;
+        TaskGraph graph;
+        auto ta = graph.add([&] { a = step++; });
+        auto tb = graph.add([&] { b = step++; });
+        auto tc = graph.add([&] { c = step++; });
+        auto td = graph.add([&] { d = step++; });
+        graph.precede(ta, tb);
+        graph.precede(ta, tc);
+        graph.precede(tb, td);
+        graph.precede(tc, td);
+
+        // Running it twice must work the same way
+        for (int run = 0; run < 2; ++run) {
+            step = 0;
+            jobs.run(graph);
+            BOOST_CHECK_EQUAL(step.load(), 4);
+            BOOST_CHECK_EQUAL(a, 0);
+            BOOST_CHECK_LT(a, b);
+            BOOST_CHECK_LT(a, c);
+            BOOST_CHECK_EQUAL(d, 3);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_task_graph_deterministic) {
+    JobSystem jobs(0);
+
+    TaskGraph graph;
+    std::vector<size_t> order;
+    for (size_t i = 0; i < 6; ++i) {
+        graph.add([&order, i] { order.push_back(i); });
+    }
+    graph.precede(0, 3);
+    graph.precede(1, 3);
+    graph.precede(3, 5);
+
+    jobs.run(graph);
+    auto first = order;
+    order.clear();
+    jobs.run(graph);
+
+    BOOST_CHECK_EQUAL(first.size(), 6);
+    BOOST_CHECK_EQUAL_COLLECTIONS(order.begin(), order.end(), first.begin(),
+                                  first.end());
+}
+
+BOOST_AUTO_TEST_CASE(test_exception_is_rethrown) {
+    for (unsigned workers : kWorkerCounts) {
+        JobSystem jobs(workers);
+        std::atomic<int> ran{0};
+        JobCounter counter;
+        jobs.submit(counter, [] { throw std::runtime_error("job failed"); });
+        jobs.submit(counter, [&] { ran++; });
+        BOOST_CHECK_THROW(jobs.wait(counter), std::runtime_error);
+        BOOST_CHECK_EQUAL(ran.load(), 1);
+
+        // The error is only reported once
+        jobs.wait(counter);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
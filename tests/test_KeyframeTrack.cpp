@@ -0,0 +1,69 @@
+#include <boost/test/unit_test.hpp>
+#include <data/CutsceneData.hpp>
+
+#include <glm/vec3.hpp>
+
+#include "test_Globals.hpp"
+
+BOOST_AUTO_TEST_SUITE(KeyframeTrackTests)
+
+BOOST_AUTO_TEST_CASE(test_add) {
+    KeyframeTrack<float> track;
+    track.add(1.f, 10.f);
+    track.add(3.f, 30.f);
+    // Out of order and duplicate keys, as a std::map would take them
+    track.add(2.f, 20.f);
+    track.add(3.f, 35.f);
+    track.add(0.f, 0.f);
+
+    const std::vector<float> times{0.f, 1.f, 2.f, 3.f};
+    const std::vector<float> values{0.f, 10.f, 20.f, 35.f};
+    BOOST_CHECK_EQUAL_COLLECTIONS(track.getTimes().begin(),
+                                  track.getTimes().end(), times.begin(),
+                                  times.end());
+    BOOST_CHECK_EQUAL_COLLECTIONS(track.getValues().begin(),
+                                  track.getValues().end(), values.begin(),
+                                  values.end());
+}
+
+BOOST_AUTO_TEST_CASE(test_sample) {
+    KeyframeTrack<glm::vec3> track;
+    BOOST_CHECK_EQUAL(track.sample(1.f), glm::vec3(0.f));
+
+    track.add(1.f, glm::vec3(0.f));
+    track.add(2.f, glm::vec3(10.f, 0.f, 0.f));
+    track.add(4.f, glm::vec3(10.f, 20.f, 0.f));
+
+    // Clamped outside the keys
+    BOOST_CHECK_EQUAL(track.sample(0.f), glm::vec3(0.f));
+    BOOST_CHECK_EQUAL(track.sample(5.f), glm::vec3(10.f, 20.f, 0.f));
+
+    BOOST_CHECK_EQUAL(track.sample(1.5f), glm::vec3(5.f, 0.f, 0.f));
+    BOOST_CHECK_EQUAL(track.sample(3.f), glm::vec3(10.f, 10.f, 0.f));
+}
+
+BOOST_AUTO_TEST_CASE(test_cursor) {
+    KeyframeTrack<float> track;
+    for (int i = 0; i < 100; ++i) {
+        track.add(static_cast<float>(i), static_cast<float>(i * 2));
+    }
+
+    size_t cursor = 0;
+    for (float time = 0.f; time < 20.f; time += 0.25f) {
+        BOOST_CHECK_EQUAL(track.sample(time, cursor), time * 2.f);
+        BOOST_CHECK_EQUAL(cursor, static_cast<size_t>(time));
+    }
+
+    // Seeking in either direction
+    BOOST_CHECK_EQUAL(track.sample(80.5f, cursor), 161.f);
+    BOOST_CHECK_EQUAL(cursor, 80);
+    BOOST_CHECK_EQUAL(track.sample(10.5f, cursor), 21.f);
+    BOOST_CHECK_EQUAL(cursor, 10);
+
+    // A cursor from a longer track
+    cursor = 500;
+    BOOST_CHECK_EQUAL(track.sample(50.f, cursor), 100.f);
+    BOOST_CHECK_EQUAL(cursor, 50);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,173 @@
+#include <boost/test/unit_test.hpp>
+#include <data/CollisionModel.hpp>
+#include <data/InstanceData.hpp>
+#include <data/ModelData.hpp>
+#include <loaders/LoaderCOL.hpp>
+#include <loaders/LoaderCache.hpp>
+#include <loaders/LoaderIDE.hpp>
+#include <loaders/LoaderIPL.hpp>
+#include "test_Globals.hpp"
+
+#include <fstream>
+#include <random>
+
+namespace {
+constexpr auto kIPLTestData = R"(
+zone
+ZONE_A, 1, -100.0, -200.00, -100.0, 100.0, 1000.0, 100.0, 1
+end
+
+inst
+101, ModelA, 10.0, 12.0, 5.0, 1, 1, 1, 0, 0, 1, 0
+112, ModelB, 11.0, 12.0, 5.0, 2, 2, 2, 0, 0, 0, 1
+end
+)";
+
+constexpr auto kIDETestData = R"(
+objs
+1100, NAME, TXD, 2, 220, 50, 0
+end
+
+cars
+90, vehicle, texture, car, HANDLING, NAME, richfamily, 10, 7, 0, 164, 0.8
+end
+
+peds
+1, mod, txd, COP, STAT_COP, man, 7f
+end
+)";
+
+struct WithCacheDirectory {
+    rwfs::path dir;
+    LoaderCache cache;
+
+    WithCacheDirectory()
+        : dir(rwfs::temp_directory_path() /
+              ("openrw-cache-test-" + std::to_string(std::random_device()())))
+        , cache(dir) {
+        rwfs::create_directories(dir);
+    }
+
+    ~WithCacheDirectory() {
+        rwfs::error_code ec;
+        rwfs::remove_all(dir, ec);
+    }
+
+    std::string writeSource(const std::string& name, const char* contents) {
+        auto path = (dir / name).string();
+        std::ofstream file(path, std::ios::binary);
+        file << contents;
+        return path;
+    }
+};
+}  // namespace
+
+BOOST_FIXTURE_TEST_SUITE(LoaderCacheTests, WithCacheDirectory)
+
+BOOST_AUTO_TEST_CASE(test_disabled_cache) {
+    LoaderCache disabled;
+    auto source = writeSource("test.ipl", kIPLTestData);
+    LoaderIPL ipl;
+    BOOST_CHECK(!disabled.isEnabled());
+    BOOST_CHECK(!disabled.storeIPL(source, ipl));
+    BOOST_CHECK(!disabled.loadIPL(source, ipl));
+}
+
+BOOST_AUTO_TEST_CASE(test_ipl_round_trip) {
+    auto source = writeSource("test.ipl", kIPLTestData);
+
+    LoaderIPL parsed;
+    BOOST_REQUIRE(parsed.load(source));
+    BOOST_REQUIRE(cache.storeIPL(source, parsed));
+
+    LoaderIPL cached;
+    BOOST_REQUIRE(cache.loadIPL(source, cached));
+
+    BOOST_REQUIRE_EQUAL(cached.m_instances.size(), parsed.m_instances.size());
+    for (size_t i = 0; i < parsed.m_instances.size(); ++i) {
+        const auto& a = *parsed.m_instances[i];
+        const auto& b = *cached.m_instances[i];
+        BOOST_CHECK_EQUAL(a.id, b.id);
+        BOOST_CHECK_EQUAL(a.model, b.model);
+        BOOST_CHECK_EQUAL(a.pos, b.pos);
+        BOOST_CHECK_EQUAL(a.scale, b.scale);
+        BOOST_CHECK(a.rot == b.rot);
+    }
+
+    BOOST_REQUIRE_EQUAL(cached.zones.size(), parsed.zones.size());
+    BOOST_CHECK_EQUAL(cached.zones[0].name, parsed.zones[0].name);
+    BOOST_CHECK_EQUAL(cached.zones[0].type, parsed.zones[0].type);
+    BOOST_CHECK_EQUAL(cached.zones[0].min, parsed.zones[0].min);
+    BOOST_CHECK_EQUAL(cached.zones[0].max, parsed.zones[0].max);
+    BOOST_CHECK_EQUAL(cached.zones[0].island, parsed.zones[0].island);
+}
+
+BOOST_AUTO_TEST_CASE(test_modified_source_invalidates) {
+    auto source = writeSource("test.ipl", kIPLTestData);
+
+    LoaderIPL parsed;
+    BOOST_REQUIRE(parsed.load(source));
+    BOOST_REQUIRE(cache.storeIPL(source, parsed));
+
+    writeSource("test.ipl", "inst\nend\n");
+
+    LoaderIPL cached;
+    BOOST_CHECK(!cache.loadIPL(source, cached));
+    BOOST_CHECK(cached.m_instances.empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_kind_mismatch_is_rejected) {
+    auto source = writeSource("test.ipl", kIPLTestData);
+
+    LoaderIPL parsed;
+    BOOST_REQUIRE(parsed.load(source));
+    BOOST_REQUIRE(cache.storeIPL(source, parsed));
+
+    // Pretend the IPL cache file belongs to a COL file
+    rwfs::copy_file(cache.getCachePath(source, LoaderCache::Kind::IPL),
+                    cache.getCachePath(source, LoaderCache::Kind::COL));
+
+    LoaderCOL col;
+    BOOST_CHECK(!cache.loadCOL(source, col));
+}
+
+BOOST_AUTO_TEST_CASE(test_ide_round_trip) {
+    auto source = writeSource("test.ide", kIDETestData);
+
+    PedStatsList stats(1);
+    stats[0].id_ = 3;
+    stats[0].name_ = "STAT_COP";
+
+    LoaderIDE parsed;
+    BOOST_REQUIRE(parsed.load(source, stats));
+    BOOST_REQUIRE(cache.storeIDE(source, stats, parsed));
+
+    LoaderIDE cached;
+    BOOST_REQUIRE(cache.loadIDE(source, stats, cached));
+    BOOST_REQUIRE_EQUAL(cached.objects.size(), 3);
+
+    auto& simple = dynamic_cast<SimpleModelInfo&>(*cached.objects[1100]);
+    BOOST_CHECK_EQUAL(simple.name, "NAME");
+    BOOST_CHECK_EQUAL(simple.textureslot, "TXD");
+    BOOST_CHECK_EQUAL(simple.getNumAtomics(), 2);
+    BOOST_CHECK_EQUAL(simple.getLodDistance(0), 220.f);
+    BOOST_CHECK_EQUAL(simple.getLodDistance(1), 50.f);
+    BOOST_CHECK_EQUAL(simple.getLargestLodDistance(),
+                      dynamic_cast<SimpleModelInfo&>(*parsed.objects[1100])
+                          .getLargestLodDistance());
+
+    auto& car = dynamic_cast<VehicleModelInfo&>(*cached.objects[90]);
+    BOOST_CHECK_EQUAL(car.handling_, "HANDLING");
+    BOOST_CHECK_EQUAL(car.vehiclename_, "NAME");
+    BOOST_CHECK(car.vehicleclass_ == VehicleModelInfo::RICHFAMILY);
+    BOOST_CHECK_EQUAL(car.wheelmodel_, 164);
+    BOOST_CHECK_EQUAL(car.wheelscale_, 0.8f);
+
+    auto& ped = dynamic_cast<PedModelInfo&>(*cached.objects[1]);
+    BOOST_CHECK(ped.pedtype_ == PedModelInfo::COP);
+    BOOST_CHECK_EQUAL(ped.statindex_, 3);
+    BOOST_CHECK_EQUAL(ped.animgroup_, "man");
+    BOOST_CHECK_EQUAL(ped.carsmask_, 0x7f);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
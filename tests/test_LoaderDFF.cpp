@@ -3,6 +3,8 @@
 #include <platform/FileHandle.hpp>
 #include "test_Globals.hpp"
 
+#include <cstring>
+
 BOOST_AUTO_TEST_SUITE(LoaderDFFTests)
 
 BOOST_AUTO_TEST_CASE(test_load_dff, DATA_TEST_PREDICATE) {
@@ -25,6 +27,22 @@ BOOST_AUTO_TEST_CASE(test_load_dff, DATA_TEST_PREDICATE) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(test_load_truncated_dff) {
+    // A clump whose frame list claims more frames than it contains
+    std::uint32_t data[] = {0x0010, 44, 0x0C02FFFF,  // Clump
+                            0x0001, 4,  0x0C02FFFF,  // Struct
+                            0,                       // Atomic count
+                            0x000E, 16, 0x0C02FFFF,  // Frame List
+                            0x0001, 4,  0x0C02FFFF,  // Struct
+                            1000};                   // Frame count
+    auto mem = std::make_unique<char[]>(sizeof(data));
+    std::memcpy(mem.get(), data, sizeof(data));
+    FileContentsInfo file(std::move(mem), sizeof(data));
+
+    LoaderDFF loader;
+    BOOST_CHECK(loader.loadFromMemory(file) == nullptr);
+}
+
 BOOST_AUTO_TEST_CASE(test_clump_clone) {
     {
         auto frame1 = std::make_shared<ModelFrame>(0);
@@ -0,0 +1,49 @@
+#include <boost/test/unit_test.hpp>
+#include <data/ModelData.hpp>
+#include "test_Globals.hpp"
+
+namespace {
+/// Three LODs, drawn up to 50, 150 and 300 units away
+void setupLods(SimpleModelInfo& model) {
+    model.setNumAtomics(3);
+    model.setLodDistance(0, 50.f);
+    model.setLodDistance(1, 150.f);
+    model.setLodDistance(2, 300.f);
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(ModelDataTests)
+
+BOOST_AUTO_TEST_CASE(test_distance_atomic_index) {
+    SimpleModelInfo model;
+    setupLods(model);
+
+    BOOST_CHECK_EQUAL(model.getDistanceAtomicIndex(10.f), 0);
+    BOOST_CHECK_EQUAL(model.getDistanceAtomicIndex(50.f), 1);
+    BOOST_CHECK_EQUAL(model.getDistanceAtomicIndex(200.f), 2);
+    BOOST_CHECK_EQUAL(model.getDistanceAtomicIndex(400.f), 3);
+}
+
+BOOST_AUTO_TEST_CASE(test_distance_atomic_hysteresis) {
+    SimpleModelInfo model;
+    setupLods(model);
+
+    // Moving away, the current LOD is kept until well past its distance
+    BOOST_CHECK_EQUAL(model.getDistanceAtomicIndex(52.f, 0, 0.1f), 0);
+    BOOST_CHECK_EQUAL(model.getDistanceAtomicIndex(56.f, 0, 0.1f), 1);
+
+    // And the same moving back
+    BOOST_CHECK_EQUAL(model.getDistanceAtomicIndex(48.f, 1, 0.1f), 1);
+    BOOST_CHECK_EQUAL(model.getDistanceAtomicIndex(44.f, 1, 0.1f), 0);
+
+    // Past the last LOD
+    BOOST_CHECK_EQUAL(model.getDistanceAtomicIndex(310.f, 2, 0.1f), 2);
+    BOOST_CHECK_EQUAL(model.getDistanceAtomicIndex(310.f, 3, 0.1f), 3);
+    BOOST_CHECK_EQUAL(model.getDistanceAtomicIndex(260.f, 3, 0.1f), 2);
+
+    // Jumps straight to the right LOD when far from the current one
+    BOOST_CHECK_EQUAL(model.getDistanceAtomicIndex(200.f, 0, 0.1f), 2);
+    BOOST_CHECK_EQUAL(model.getDistanceAtomicIndex(200.f, -1, 0.1f), 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
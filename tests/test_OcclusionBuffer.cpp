@@ -0,0 +1,193 @@
+#include <boost/test/unit_test.hpp>
+#include <data/CollisionModel.hpp>
+#include <render/OcclusionBuffer.hpp>
+#include <render/ViewCamera.hpp>
+#include "test_Globals.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace {
+/// Camera at the origin looking down the X axis
+glm::mat4 cameraViewProjection() {
+    ViewCamera camera;
+    return camera.frustum.projection() * camera.getView();
+}
+
+/// A square facing the camera at distance, half of size wide
+void addWall(OcclusionBuffer& buffer, float distance, float size) {
+    const glm::vec3 a(distance, -size, -size);
+    const glm::vec3 b(distance, size, -size);
+    const glm::vec3 c(distance, size, size);
+    const glm::vec3 d(distance, -size, size);
+    buffer.addQuad(a, b, c, d);
+}
+
+struct ScreenRect {
+    float minX;
+    float minY;
+    float maxX;
+    float maxY;
+
+    bool contains(const ScreenRect& other) const {
+        return other.minX >= minX && other.maxX <= maxX &&
+               other.minY >= minY && other.maxY <= maxY;
+    }
+};
+
+/// Buffer pixels covered by the box between min and max
+ScreenRect screenRect(const glm::mat4& viewProjection, const glm::vec3& min,
+                      const glm::vec3& max) {
+    ScreenRect rect{std::numeric_limits<float>::max(),
+                    std::numeric_limits<float>::max(),
+                    std::numeric_limits<float>::lowest(),
+                    std::numeric_limits<float>::lowest()};
+    for (int c = 0; c < 8; ++c) {
+        const glm::vec3 corner((c & 4) ? max.x : min.x, (c & 2) ? max.y : min.y,
+                               (c & 1) ? max.z : min.z);
+        const auto clip = viewProjection * glm::vec4(corner, 1.f);
+        const auto x = (clip.x / clip.w * 0.5f + 0.5f) * OcclusionBuffer::kWidth;
+        const auto y =
+            (clip.y / clip.w * 0.5f + 0.5f) * OcclusionBuffer::kHeight;
+        rect.minX = std::min(rect.minX, x);
+        rect.minY = std::min(rect.minY, y);
+        rect.maxX = std::max(rect.maxX, x);
+        rect.maxY = std::max(rect.maxY, y);
+    }
+    return rect;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(OcclusionBufferTests)
+
+BOOST_AUTO_TEST_CASE(test_empty_buffer) {
+    OcclusionBuffer buffer;
+    buffer.clear(cameraViewProjection(), 0.1f);
+
+    BOOST_CHECK(buffer.empty());
+    BOOST_CHECK(!buffer.isOccluded({100.f, 0.f, 0.f}, 1.f));
+}
+
+BOOST_AUTO_TEST_CASE(test_wall_hides_objects_behind) {
+    OcclusionBuffer buffer;
+    buffer.clear(cameraViewProjection(), 0.1f);
+    addWall(buffer, 20.f, 5.f);
+
+    BOOST_CHECK_EQUAL(buffer.getTriangleCount(), 2);
+
+    // Behind the middle of the wall
+    BOOST_CHECK(buffer.isOccluded({40.f, 0.f, 0.f}, 1.f));
+    BOOST_CHECK(buffer.isOccluded({40.f, 3.f, -3.f}, 1.f));
+
+    // In front of the wall
+    BOOST_CHECK(!buffer.isOccluded({10.f, 0.f, 0.f}, 1.f));
+
+    // Passing through the wall
+    BOOST_CHECK(!buffer.isOccluded({21.f, 0.f, 0.f}, 2.f));
+
+    // Behind, but sticking out past the sides
+    BOOST_CHECK(!buffer.isOccluded({40.f, 15.f, 0.f}, 1.f));
+    BOOST_CHECK(!buffer.isOccluded({40.f, 0.f, 0.f}, 12.f));
+}
+
+BOOST_AUTO_TEST_CASE(test_objects_past_the_edge) {
+    const auto viewProjection = cameraViewProjection();
+    OcclusionBuffer buffer;
+    buffer.clear(viewProjection, 0.1f);
+    addWall(buffer, 20.f, 5.f);
+    const auto wall =
+        screenRect(viewProjection, {20.f, -5.f, -5.f}, {20.f, 5.f, 5.f});
+
+    // Slide a sphere behind the wall out past each side, in steps much
+    // smaller than a pixel
+    const glm::vec3 directions[] = {
+        {0.f, 1.f, 0.f}, {0.f, -1.f, 0.f}, {0.f, 0.f, 1.f}, {0.f, 0.f, -1.f}};
+    for (const auto& direction : directions) {
+        size_t occluded = 0;
+        for (int step = 0; step < 700; ++step) {
+            const auto center =
+                glm::vec3(40.f, 0.f, 0.f) + direction * (5.f + step * 0.01f);
+            const glm::vec3 extent(1.f);
+            const auto sphere =
+                screenRect(viewProjection, center - extent, center + extent);
+            if (!buffer.isOccluded(center, 1.f)) {
+                continue;
+            }
+            occluded++;
+
+            // Only while it is entirely behind the wall
+            BOOST_CHECK(wall.contains(sphere));
+        }
+        BOOST_CHECK_GT(occluded, 0);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_mesh_quads) {
+    // Two triangles sharing an edge, drawn as one quad
+    CollisionModel model;
+    model.vertices = {{0.f, -5.f, -5.f},
+                      {0.f, 5.f, -5.f},
+                      {0.f, 5.f, 5.f},
+                      {0.f, -5.f, 5.f}};
+    model.faces.push_back({{0, 1, 2}, {}});
+    model.faces.push_back({{0, 2, 3}, {}});
+
+    OcclusionBuffer buffer;
+    buffer.clear(cameraViewProjection(), 0.1f);
+    buffer.addOccluder(model,
+                       glm::translate(glm::mat4(1.f), {20.f, 0.f, 0.f}));
+    BOOST_CHECK_EQUAL(buffer.getTriangleCount(), 2);
+
+    // No crack along the shared edge
+    BOOST_CHECK(buffer.isOccluded({40.f, 0.f, 0.f}, 1.f));
+    BOOST_CHECK(buffer.isOccluded({40.f, 3.f, 3.f}, 1.f));
+    BOOST_CHECK(buffer.isOccluded({40.f, -3.f, -3.f}, 1.f));
+}
+
+BOOST_AUTO_TEST_CASE(test_clear_removes_occluders) {
+    OcclusionBuffer buffer;
+    buffer.clear(cameraViewProjection(), 0.1f);
+    addWall(buffer, 20.f, 5.f);
+    BOOST_CHECK(buffer.isOccluded({40.f, 0.f, 0.f}, 1.f));
+
+    buffer.clear(cameraViewProjection(), 0.1f);
+    BOOST_CHECK(buffer.empty());
+    BOOST_CHECK(!buffer.isOccluded({40.f, 0.f, 0.f}, 1.f));
+}
+
+BOOST_AUTO_TEST_CASE(test_near_plane) {
+    OcclusionBuffer buffer;
+    buffer.clear(cameraViewProjection(), 0.1f);
+
+    // Triangles reaching behind the camera are skipped
+    buffer.addTriangle({-5.f, -5.f, -5.f}, {20.f, 5.f, -5.f},
+                       {20.f, 0.f, 5.f});
+    BOOST_CHECK(buffer.empty());
+
+    // Objects around the camera are never hidden
+    addWall(buffer, 20.f, 5.f);
+    BOOST_CHECK(!buffer.isOccluded({0.5f, 0.f, 0.f}, 1.f));
+}
+
+BOOST_AUTO_TEST_CASE(test_collision_boxes) {
+    CollisionModel model;
+    model.boxes.push_back(
+        {glm::vec3(-5.f, -5.f, -5.f), glm::vec3(5.f, 5.f, 5.f), {}});
+
+    OcclusionBuffer buffer;
+    buffer.clear(cameraViewProjection(), 0.1f);
+    buffer.addOccluder(model,
+                       glm::translate(glm::mat4(1.f), {30.f, 0.f, 0.f}));
+
+    BOOST_CHECK(!buffer.empty());
+
+    // The nearest face of the box is kept
+    const auto depth = buffer.getDepth(OcclusionBuffer::kWidth / 2,
+                                       OcclusionBuffer::kHeight / 2);
+    BOOST_CHECK_CLOSE(depth, 25.f, 0.1f);
+
+    BOOST_CHECK(buffer.isOccluded({60.f, 0.f, 0.f}, 2.f));
+    BOOST_CHECK(!buffer.isOccluded({60.f, 0.f, 30.f}, 2.f));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,133 @@
+#include <boost/test/unit_test.hpp>
+#include <loaders/PixelConversion.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using PixelConversion::Kernel;
+
+namespace {
+// Odd sizes make sure the scalar tails of the vector kernels are exercised
+const size_t kPixelCounts[] = {0, 1, 7, 15, 16, 17, 33, 1031};
+
+const Kernel kKernels[] = {Kernel::Scalar, Kernel::SSE41, Kernel::AVX2};
+
+template <class T>
+std::vector<T> randomData(size_t count, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<uint32_t> dist;
+    std::vector<T> data(count);
+    for (auto& v : data) {
+        v = static_cast<T>(dist(rng));
+    }
+    return data;
+}
+}
+
+BOOST_AUTO_TEST_SUITE(PixelConversionTests)
+
+BOOST_AUTO_TEST_CASE(test_scalar_always_supported) {
+    BOOST_CHECK(PixelConversion::isSupported(Kernel::Scalar));
+    BOOST_CHECK(PixelConversion::isSupported(PixelConversion::bestKernel()));
+}
+
+BOOST_AUTO_TEST_CASE(test_scalar_reference_values) {
+    uint16_t in1555[] = {0x0000, 0x801F, 0x03E0, 0x7C00, 0xFFFF};
+    uint32_t out1555[5];
+    PixelConversion::convert1555(in1555, out1555, 5, Kernel::Scalar);
+    BOOST_CHECK_EQUAL(out1555[0], 0x00000000u);
+    BOOST_CHECK_EQUAL(out1555[1], 0xFF0000FFu);
+    BOOST_CHECK_EQUAL(out1555[2], 0x0000FF00u);
+    BOOST_CHECK_EQUAL(out1555[3], 0x00FF0000u);
+    BOOST_CHECK_EQUAL(out1555[4], 0xFFFFFFFFu);
+
+    uint16_t in565[] = {0x0000, 0xF800, 0x07E0, 0x001F, 0x8410};
+    uint32_t out565[5];
+    PixelConversion::convert565(in565, out565, 5, Kernel::Scalar);
+    BOOST_CHECK_EQUAL(out565[0], 0xFF000000u);
+    BOOST_CHECK_EQUAL(out565[1], 0xFF0000FFu);
+    BOOST_CHECK_EQUAL(out565[2], 0xFF00FF00u);
+    BOOST_CHECK_EQUAL(out565[3], 0xFFFF0000u);
+    BOOST_CHECK_EQUAL(out565[4], 0xFF848284u);
+
+    uint32_t bgra[] = {0x11223344u};
+    PixelConversion::swizzleBGRA(bgra, bgra, 1, Kernel::Scalar);
+    BOOST_CHECK_EQUAL(bgra[0], 0x11443322u);
+}
+
+BOOST_AUTO_TEST_CASE(test_palette_matches_scalar) {
+    auto palette = randomData<uint32_t>(256, 1);
+    for (size_t count : kPixelCounts) {
+        auto indices = randomData<uint8_t>(count, 2);
+        std::vector<uint32_t> expected(count);
+        PixelConversion::expandPalette(palette.data(), indices.data(),
+                                       expected.data(), count, Kernel::Scalar);
+        for (Kernel kernel : kKernels) {
+            if (!PixelConversion::isSupported(kernel)) continue;
+            std::vector<uint32_t> out(count);
+            PixelConversion::expandPalette(palette.data(), indices.data(),
+                                           out.data(), count, kernel);
+            BOOST_CHECK_EQUAL_COLLECTIONS(out.begin(), out.end(),
+                                          expected.begin(), expected.end());
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_1555_matches_scalar) {
+    for (size_t count : kPixelCounts) {
+        auto in = randomData<uint16_t>(count, 3);
+        std::vector<uint32_t> expected(count);
+        PixelConversion::convert1555(in.data(), expected.data(), count,
+                                     Kernel::Scalar);
+        for (Kernel kernel : kKernels) {
+            if (!PixelConversion::isSupported(kernel)) continue;
+            std::vector<uint32_t> out(count);
+            PixelConversion::convert1555(in.data(), out.data(), count, kernel);
+            BOOST_CHECK_EQUAL_COLLECTIONS(out.begin(), out.end(),
+                                          expected.begin(), expected.end());
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_565_matches_scalar) {
+    for (size_t count : kPixelCounts) {
+        auto in = randomData<uint16_t>(count, 4);
+        std::vector<uint32_t> expected(count);
+        PixelConversion::convert565(in.data(), expected.data(), count,
+                                    Kernel::Scalar);
+        for (Kernel kernel : kKernels) {
+            if (!PixelConversion::isSupported(kernel)) continue;
+            std::vector<uint32_t> out(count);
+            PixelConversion::convert565(in.data(), out.data(), count, kernel);
+            BOOST_CHECK_EQUAL_COLLECTIONS(out.begin(), out.end(),
+                                          expected.begin(), expected.end());
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_swizzle_matches_scalar) {
+    for (size_t count : kPixelCounts) {
+        auto in = randomData<uint32_t>(count, 5);
+        std::vector<uint32_t> expected(count);
+        PixelConversion::swizzleBGRA(in.data(), expected.data(), count,
+                                     Kernel::Scalar);
+        for (Kernel kernel : kKernels) {
+            if (!PixelConversion::isSupported(kernel)) continue;
+            std::vector<uint32_t> out(count);
+            PixelConversion::swizzleBGRA(in.data(), out.data(), count, kernel);
+            BOOST_CHECK_EQUAL_COLLECTIONS(out.begin(), out.end(),
+                                          expected.begin(), expected.end());
+
+            // In place conversion must give the same result
+            auto inPlace = in;
+            PixelConversion::swizzleBGRA(inPlace.data(), inPlace.data(),
+                                         count, kernel);
+            BOOST_CHECK_EQUAL_COLLECTIONS(inPlace.begin(), inPlace.end(),
+                                          expected.begin(), expected.end());
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
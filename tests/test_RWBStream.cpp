@@ -3,13 +3,26 @@
 #include <platform/FileHandle.hpp>
 #include "test_Globals.hpp"
 
-BOOST_AUTO_TEST_SUITE(RWBStreamTests, DATA_TEST_PREDICATE)
+#include <cstdint>
+#include <cstring>
+#include <vector>
 
-BOOST_AUTO_TEST_CASE(iterate_stream_test) {
+namespace {
+void writeChunkHeader(std::vector<char>& out, std::uint32_t id,
+                      std::uint32_t size) {
+    std::uint32_t header[] = {id, size, 0x0C02FFFF};
+    auto bytes = reinterpret_cast<const char*>(header);
+    out.insert(out.end(), bytes, bytes + sizeof(header));
+}
+}
+
+BOOST_AUTO_TEST_SUITE(RWBStreamTests)
+
+BOOST_AUTO_TEST_CASE(iterate_stream_test, DATA_TEST_PREDICATE) {
     {
         auto d = Global::get().e->data->index.openFile("landstal.dff");
 
-        RWBStream stream(d.data.get(), d.length);
+        RWBStream stream(d.data, d.length);
 
         RWBStream::ChunkID id = stream.getNextChunk();
 
@@ -28,4 +41,30 @@ BOOST_AUTO_TEST_CASE(iterate_stream_test) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(test_stream_bounds) {
+    std::vector<char> data;
+    writeChunkHeader(data, 0x0010, 4);
+    data.insert(data.end(), 4, 0);
+    // The second chunk claims more data than there is
+    writeChunkHeader(data, 0x0010, 64);
+    data.insert(data.end(), 4, 0);
+
+    RWBStream stream(data.data(), data.size());
+    BOOST_CHECK_EQUAL(stream.getNextChunk(), 0x0010);
+    BOOST_CHECK_EQUAL(stream.getCurrentChunkSize(), 4);
+    BOOST_CHECK_EQUAL(stream.getNextChunk(), 0);
+    BOOST_CHECK_EQUAL(stream.getNextChunk(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_stream_partial_header) {
+    std::vector<char> data;
+    writeChunkHeader(data, 0x0010, 0);
+    // Not enough left for another chunk header
+    data.insert(data.end(), 8, 0);
+
+    RWBStream stream(data.data(), data.size());
+    BOOST_CHECK_EQUAL(stream.getNextChunk(), 0x0010);
+    BOOST_CHECK_EQUAL(stream.getNextChunk(), 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,117 @@
+#include <boost/test/unit_test.hpp>
+#include <engine/Replay.hpp>
+
+#include <sstream>
+#include <string>
+
+namespace {
+ReplayHeader makeHeader() {
+    ReplayHeader header;
+    header.seed = 1234;
+    header.checksumInterval = 30;
+    header.start = ReplayHeader::TestGame;
+    return header;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(ReplayTests)
+
+BOOST_AUTO_TEST_CASE(test_header_round_trip) {
+    std::stringstream stream;
+    ReplayWriter writer(stream, makeHeader());
+    BOOST_CHECK(writer.good());
+
+    ReplayReader reader(stream);
+    BOOST_REQUIRE(reader.isValid());
+    BOOST_CHECK_EQUAL(reader.getHeader().seed, 1234);
+    BOOST_CHECK_EQUAL(reader.getHeader().checksumInterval, 30);
+    BOOST_CHECK(reader.getHeader().start == ReplayHeader::TestGame);
+    BOOST_CHECK(reader.next() == ReplayReader::Record::End);
+}
+
+BOOST_AUTO_TEST_CASE(test_record_round_trip) {
+    std::stringstream stream;
+    ReplayWriter writer(stream, makeHeader());
+
+    ReplayFrame frame;
+    frame.frameTime = 1.f / 60.f;
+    frame.cameraPosition = {1.f, 2.f, 3.f};
+    frame.cameraRotation = {0.f, 1.f, 0.f, 0.f};
+    writer.writeFrame(frame);
+
+    ReplayTick first;
+    first.input.levels[GameInputState::Sprint] = 1.f;
+    first.look = {0.5f, -0.25f};
+    writer.writeTick(first);
+
+    ReplayTick second = first;
+    second.input.levels[GameInputState::GoForward] = 1.f;
+    second.input.levels[GameInputState::Sprint] = 0.f;
+    writer.writeTick(second);
+
+    writer.writeChecksum(0xdeadbeef);
+
+    ReplayReader reader(stream);
+    BOOST_REQUIRE(reader.isValid());
+
+    BOOST_REQUIRE(reader.next() == ReplayReader::Record::Frame);
+    BOOST_CHECK_EQUAL(reader.getFrame().frameTime, frame.frameTime);
+    BOOST_CHECK(reader.getFrame().cameraPosition == frame.cameraPosition);
+    BOOST_CHECK_EQUAL(reader.getFrame().cameraRotation.x, 1.f);
+    BOOST_CHECK_EQUAL(reader.getFrame().cameraRotation.w, 0.f);
+
+    BOOST_REQUIRE(reader.next() == ReplayReader::Record::Tick);
+    BOOST_CHECK_EQUAL(reader.getTick().input[GameInputState::Sprint], 1.f);
+    BOOST_CHECK_EQUAL(reader.getTick().input[GameInputState::GoForward], 0.f);
+    BOOST_CHECK(reader.getTick().look == first.look);
+
+    // Unchanged controls carry over from the previous tick
+    BOOST_REQUIRE(reader.next() == ReplayReader::Record::Tick);
+    for (int c = 0; c < GameInputState::_MaxControls; ++c) {
+        BOOST_CHECK_EQUAL(reader.getTick().input.levels[c],
+                          second.input.levels[c]);
+    }
+
+    BOOST_REQUIRE(reader.next() == ReplayReader::Record::Checksum);
+    BOOST_CHECK_EQUAL(reader.getChecksum(), 0xdeadbeef);
+
+    BOOST_CHECK(reader.next() == ReplayReader::Record::End);
+}
+
+BOOST_AUTO_TEST_CASE(test_unchanged_ticks_are_small) {
+    std::stringstream stream;
+    ReplayWriter writer(stream, makeHeader());
+
+    ReplayTick tick;
+    tick.input.levels[GameInputState::GoForward] = 1.f;
+    writer.writeTick(tick);
+    auto afterFirst = stream.str().size();
+    writer.writeTick(tick);
+    auto afterSecond = stream.str().size();
+
+    // Tag, empty change mask and the look angles
+    BOOST_CHECK_EQUAL(afterSecond - afterFirst,
+                      sizeof(uint8_t) + sizeof(uint32_t) + sizeof(glm::vec2));
+}
+
+BOOST_AUTO_TEST_CASE(test_invalid_magic) {
+    std::stringstream stream("not a replay at all");
+    ReplayReader reader(stream);
+    BOOST_CHECK(!reader.isValid());
+    BOOST_CHECK(reader.next() == ReplayReader::Record::End);
+}
+
+BOOST_AUTO_TEST_CASE(test_truncated_record) {
+    std::stringstream stream;
+    ReplayWriter writer(stream, makeHeader());
+    writer.writeFrame({});
+    auto data = stream.str();
+
+    std::stringstream truncated(data.substr(0, data.size() - 4));
+    ReplayReader reader(truncated);
+    BOOST_REQUIRE(reader.isValid());
+    BOOST_CHECK(reader.next() == ReplayReader::Record::End);
+    BOOST_CHECK(!reader.isValid());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
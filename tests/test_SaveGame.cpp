@@ -1,69 +1,184 @@
 #include <boost/test/unit_test.hpp>
+#include <engine/GameData.hpp>
 #include <engine/GameState.hpp>
+#include <engine/GameWorld.hpp>
 #include <engine/SaveGame.hpp>
+#include <rw/filesystem.hpp>
+#include <script/SCMFile.hpp>
 #include <script/ScriptMachine.hpp>
 
+#include <fstream>
+#include <vector>
+
 #include "test_Globals.hpp"
 
-#if 0  // Disabled until we make a start on saving the game
+namespace {
+/// Header jumps for an SCM file with 8 bytes of globals and no models
+SCMByte scmData[] = {0x02, 0x00, 0x01, 0x08, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00,
+                     0x01, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                     0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x01, 0x28, 0x00, 0x00,
+                     0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                     0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+
+/// Writes the start of a save, enough for it to be listed
+void writeSaveHeader(const rwfs::path& path, char name, size_t padding = 0) {
+    BasicState basic;
+    basic.saveName[0] = static_cast<GameStringChar>(name);
+    const uint32_t blockSize = sizeof(basic);
+    const std::vector<char> extra(padding);
+
+    std::ofstream out(path.string(), std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(&blockSize), sizeof(blockSize));
+    out.write(reinterpret_cast<const char*>(&basic), sizeof(basic));
+    out.write(extra.data(), static_cast<std::streamsize>(extra.size()));
+}
+
+GameStringChar findSaveName(const std::vector<SaveGameInfo>& infos,
+                            const rwfs::path& path) {
+    for (const auto& info : infos) {
+        if (info.savePath == path.string()) {
+            return info.valid ? info.basicState.saveName[0] : 0;
+        }
+    }
+    return 0;
+}
+}  // namespace
+
 BOOST_AUTO_TEST_SUITE(SaveGameTests)
 
-BOOST_AUTO_TEST_CASE(test_write_state)
-{
-	GameState state;
-
-	// Set some test data
-	state.world = nullptr;
-	state.currentProgress = 10;
-	state.maxProgress = 124;
-	state.numMissions = 12;
-	state.numHiddenPackages = 34;
-	state.numHiddenPackagesDiscovered = 11;
-	state.numUniqueJumps = 14;
-	state.numRampages = 7;
-	state.maxWantedLevel = 5;
-	state.currentWeather = 9;
-	state.overrideNextStart = true;
-	state.hour = 13;
-	state.minute = 32;
-
-	// This may break due to cwd issues
-	SaveGame::writeState(state, "test_savestate.sav");
-
-	GameState loaded;
-	loaded.world = nullptr;
-
-	BOOST_REQUIRE( SaveGame::loadState(loaded, "test_savestate.sav") );
-	BOOST_CHECK( loaded.world == nullptr );
-	BOOST_CHECK_EQUAL( loaded.currentProgress, state.currentProgress );
-	BOOST_CHECK_EQUAL( loaded.maxProgress, state.maxProgress );
-	BOOST_CHECK_EQUAL( loaded.numMissions, state.numMissions );
-	BOOST_CHECK_EQUAL( loaded.numHiddenPackages, state.numHiddenPackages );
-	BOOST_CHECK_EQUAL( loaded.numHiddenPackagesDiscovered, state.numHiddenPackagesDiscovered );
-	BOOST_CHECK_EQUAL( loaded.numUniqueJumps, state.numUniqueJumps );
-	BOOST_CHECK_EQUAL( loaded.numRampages, state.numRampages );
-	BOOST_CHECK_EQUAL( loaded.maxWantedLevel, state.maxWantedLevel );
-	BOOST_CHECK_EQUAL( loaded.currentWeather, state.currentWeather );
-	BOOST_CHECK_EQUAL( loaded.overrideNextStart, state.overrideNextStart );
-	BOOST_CHECK_EQUAL( loaded.hour, state.hour );
-	BOOST_CHECK_EQUAL( loaded.minute, state.minute );
-	
-	// Check Garage data + garage vehicle restoration
+BOOST_AUTO_TEST_CASE(test_write_and_load_game, DATA_TEST_PREDICATE) {
+    auto world = Global::get().e;
+
+    // Loading replaces the zones, keep the real ones for the other tests
+    auto& zones = world->data->gamezones;
+    const auto realZones = zones;
+    zones = {ZoneData("TESTZN", 0, glm::vec3(0.f), glm::vec3(10.f), 1, 2, 3)};
+    world->data->buildZoneHierarchy();
+
+    SCMFile file;
+    file.loadFile(scmData, sizeof(scmData));
+
+    GameState state;
+    state.world = world;
+    ScriptMachine machine(&state, file, nullptr);
+    state.script = &machine;
+
+    machine.getGlobals()[4] = 42;
+    machine.startThread(0x28);
+    machine.getThreads().back().locals[8] = 7;
+
+    state.basic.gameHour = 13;
+    state.basic.gameMinute = 32;
+    state.basic.timeMS = 5000;
+    state.playerInfo.money = 1234;
+    state.gameStats.playerKills = 9;
+    state.importExportPortland = 0x5;
+    state.vehicleGenerators.emplace_back(0, glm::vec3(1.f, 2.f, 3.f), 90.f,
+                                         130, 1, 2, true, 10, 20, 0, 100, 0,
+                                         101);
+
+    const auto path =
+        (rwfs::temp_directory_path() / "rw_test_savegame.b").string();
+    BOOST_REQUIRE(SaveGame::writeGameAsync(state, path).get().empty());
+    BOOST_CHECK(!rwfs::exists(path + ".tmp"));
+
+    // Failures come back through the future rather than being logged
+    const auto missing =
+        (rwfs::temp_directory_path() / "rw_test_missing" / "save.b").string();
+    const auto error = SaveGame::writeGameAsync(state, missing).get();
+    BOOST_CHECK(error.find(missing) != std::string::npos);
+
+    BasicState basic;
+    BOOST_REQUIRE(SaveGame::getSaveInfo(path, &basic));
+    BOOST_CHECK_EQUAL(basic.gameHour, 13);
+    BOOST_CHECK_EQUAL(basic.gameMinute, 32);
+
+    GameState loaded;
+    loaded.world = world;
+    ScriptMachine loadedMachine(&loaded, file, nullptr);
+    loaded.script = &loadedMachine;
+    BOOST_REQUIRE(SaveGame::loadGame(loaded, path));
+
+    BOOST_CHECK_EQUAL(loaded.gameTime, 5.f);
+    BOOST_CHECK_EQUAL(loaded.playerInfo.money, 1234);
+    BOOST_CHECK_EQUAL(loaded.gameStats.playerKills, 9);
+    BOOST_CHECK_EQUAL(loaded.importExportPortland.to_ulong(), 0x5);
+
+    BOOST_CHECK_EQUAL(loadedMachine.getGlobals()[4], 42);
+    BOOST_REQUIRE_EQUAL(loadedMachine.getThreads().size(), 1);
+    const auto& thread = loadedMachine.getThreads().back();
+    BOOST_CHECK_EQUAL(thread.programCounter, 0x28);
+    BOOST_CHECK_EQUAL(thread.locals[8], 7);
+
+    BOOST_REQUIRE_EQUAL(loaded.vehicleGenerators.size(), 1);
+    const auto& gen = loaded.vehicleGenerators[0];
+    BOOST_CHECK_EQUAL(gen.position, glm::vec3(1.f, 2.f, 3.f));
+    BOOST_CHECK_EQUAL(gen.vehicleID, 130);
+    BOOST_CHECK_EQUAL(gen.maxDelay, 100);
+
+    BOOST_REQUIRE_EQUAL(zones.size(), 1);
+    BOOST_CHECK_EQUAL(zones[0].name, "TESTZN");
+    BOOST_CHECK_EQUAL(zones[0].max, glm::vec3(10.f));
+    BOOST_CHECK_EQUAL(zones[0].pedGroupDay, 2);
+    BOOST_CHECK_EQUAL(zones[0].pedGroupNight, 3);
+
+    zones = realZones;
+    world->data->buildZoneHierarchy();
+    rwfs::remove(path);
 }
 
-BOOST_AUTO_TEST_CASE(test_load_game)
-{
-	GameState state;
-	GameWorld world();
-	SCMOpcodes s;
-	auto file = Global::get().d->loadSCM("main.scm");
-	ScriptMachine machine(&state, file, &s);
-	
-	state.world = Global::get().e;
-	state.script = &machine;
-
-	BOOST_REQUIRE( SaveGame::loadGame(state, "GTA3sf1.b") );
+BOOST_AUTO_TEST_CASE(test_save_slot_scan) {
+    const auto directory = rwfs::temp_directory_path() / "rw_test_saves";
+    rwfs::remove_all(directory);
+    rwfs::create_directories(directory);
+    const auto first = directory / "GTA3sf1.b";
+    const auto second = directory / "GTA3sf2.b";
+    writeSaveHeader(first, 'A');
+    writeSaveHeader(second, 'B');
+    writeSaveHeader(directory / "notes.txt", 'C');
+
+    auto infos = SaveGame::getAllSaveGameInfo(directory.string());
+    BOOST_REQUIRE_EQUAL(infos.size(), 2);
+    BOOST_CHECK_EQUAL(findSaveName(infos, first), 'A');
+    BOOST_CHECK_EQUAL(findSaveName(infos, second), 'B');
+
+    // Unchanged size and time, the cached header is used
+    const auto modified = rwfs::last_write_time(first);
+    writeSaveHeader(first, 'D');
+    rwfs::last_write_time(first, modified);
+    infos = SaveGame::getAllSaveGameInfo(directory.string());
+    BOOST_CHECK_EQUAL(findSaveName(infos, first), 'A');
+
+    // A different size means the save changed
+    writeSaveHeader(first, 'E', 16);
+    rwfs::last_write_time(first, modified);
+    infos = SaveGame::getAllSaveGameInfo(directory.string());
+    BOOST_CHECK_EQUAL(findSaveName(infos, first), 'E');
+
+    rwfs::remove(second);
+    infos = SaveGame::getAllSaveGameInfo(directory.string());
+    BOOST_REQUIRE_EQUAL(infos.size(), 1);
+    BOOST_CHECK_EQUAL(infos[0].savePath, first.string());
+
+    rwfs::remove_all(directory);
+}
+
+BOOST_AUTO_TEST_CASE(test_truncated_save) {
+    const auto directory = rwfs::temp_directory_path() / "rw_test_saves";
+    rwfs::remove_all(directory);
+    rwfs::create_directories(directory);
+    const auto path = directory / "GTA3sf1.b";
+    std::ofstream(path.string()) << "RW";
+
+    const auto infos = SaveGame::getAllSaveGameInfo(directory.string());
+    BOOST_REQUIRE_EQUAL(infos.size(), 1);
+    BOOST_CHECK(!infos[0].valid);
+
+    BasicState basic;
+    BOOST_CHECK(!SaveGame::getSaveInfo((directory / "missing.b").string(),
+                                       &basic));
+
+    rwfs::remove_all(directory);
 }
 
 BOOST_AUTO_TEST_SUITE_END()
-#endif
@@ -1,6 +1,12 @@
 #include <boost/test/unit_test.hpp>
+#include <engine/GameState.hpp>
 #include <script/SCMFile.hpp>
 #include <script/ScriptMachine.hpp>
+#include <script/ScriptModule.hpp>
+
+#include <vector>
+
+#include "test_Globals.hpp"
 
 SCMByte data[] = {0x02, 0x00, 0x01, 0x08, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00,
                   0x01, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
@@ -8,6 +14,33 @@ SCMByte data[] = {0x02, 0x00, 0x01, 0x08, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00,
                   0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
                   0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
 
+namespace {
+/// After the header: 0x30 waits 100ms in a loop, 0x3e yields in a loop
+const SCMByte code[] = {0x03, 0x00, 0x01, 0x00, 0x05, 0x64, 0x00, 0x02, 0x00,
+                        0x01, 0x30, 0x00, 0x00, 0x00, 0x03, 0x00, 0x01, 0x00,
+                        0x04, 0x00, 0x02, 0x00, 0x01, 0x3e, 0x00, 0x00, 0x00};
+
+std::vector<SCMThread::pc_t> ran;
+
+void wait(const ScriptArguments& args, const ScriptInt time) {
+    args.getThread()->wakeCounter = time > 0 ? time : -1;
+}
+
+void jump(const ScriptArguments& args, const ScriptLabel label) {
+    args.getThread()->programCounter = static_cast<SCMThread::pc_t>(label);
+}
+
+void record(const ScriptArguments& args) {
+    ran.push_back(args.getThread()->baseAddress);
+}
+
+std::vector<SCMThread::pc_t> tick(ScriptMachine& machine, float dt) {
+    ran.clear();
+    machine.execute(dt);
+    return ran;
+}
+}  // namespace
+
 BOOST_AUTO_TEST_SUITE(ScriptMachineTests)
 
 BOOST_AUTO_TEST_CASE(scmfile_test) {
@@ -19,4 +52,43 @@ BOOST_AUTO_TEST_CASE(scmfile_test) {
     BOOST_CHECK_EQUAL(f.getCodeSection(), 0x28);
 }
 
+BOOST_AUTO_TEST_CASE(test_waiting_threads) {
+    ScriptModule module("Test");
+    module.bind(0x0001, 1, wait);
+    module.bind(0x0002, 1, jump);
+    module.bind(0x0003, 0, record);
+
+    std::vector<SCMByte> program(data, data + sizeof(data));
+    program.insert(program.end(), code, code + sizeof(code));
+    SCMFile file;
+    file.loadFile(program.data(), program.size());
+
+    GameState state;
+    state.world = Global::get().e;
+    ScriptMachine machine(&state, file, &module);
+    machine.startThread(0x30);
+    machine.startThread(0x3e);
+    auto& last = machine.startThread(0x30);
+    BOOST_CHECK_EQUAL(&last, &machine.getThreads().back());
+
+    using Order = std::vector<SCMThread::pc_t>;
+    BOOST_CHECK(tick(machine, 0.05f) == (Order{0x30, 0x3e, 0x30}));
+    BOOST_CHECK(tick(machine, 0.05f) == (Order{0x3e}));
+
+    // Waiting threads report the time they have left
+    BOOST_CHECK_EQUAL(machine.getThreads().front().wakeCounter, 50);
+
+    // Woken threads run in the order they were started
+    BOOST_CHECK(tick(machine, 0.05f) == (Order{0x30, 0x3e, 0x30}));
+    BOOST_CHECK(tick(machine, 0.06f) == (Order{0x3e}));
+    BOOST_CHECK(tick(machine, 0.03f) == (Order{0x3e}));
+    BOOST_CHECK(tick(machine, 0.01f) == (Order{0x30, 0x3e, 0x30}));
+
+    // Threads can be ended from outside
+    machine.getThreads().front().finished = true;
+    machine.getThreads().front().wakeCounter = -1;
+    BOOST_CHECK(tick(machine, 0.01f) == (Order{0x3e}));
+    BOOST_CHECK_EQUAL(machine.getThreads().size(), 2);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
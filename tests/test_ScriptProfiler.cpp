@@ -0,0 +1,73 @@
+#include <boost/test/unit_test.hpp>
+#include <script/ScriptProfiler.hpp>
+
+#include <sstream>
+#include <string>
+
+namespace {
+const ScriptFunctionMeta kWait{nullptr, 1, "wait", ""};
+const ScriptFunctionMeta kGoto{nullptr, 1, "goto", ""};
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(ScriptProfilerTests)
+
+BOOST_AUTO_TEST_CASE(test_disabled_by_default) {
+    ScriptProfiler profiler;
+    BOOST_CHECK(!profiler.isEnabled());
+    BOOST_CHECK(profiler.getOpcodeStats().empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_record) {
+    ScriptProfiler profiler;
+    profiler.record(0x0001, kWait, "MAIN", 100);
+    profiler.record(0x0001, kWait, "INTRO", 300);
+    profiler.record(0x0002, kGoto, "MAIN", 50);
+
+    const auto& opcodes = profiler.getOpcodeStats();
+    BOOST_REQUIRE_EQUAL(opcodes.size(), 2);
+    const auto& wait = opcodes.at(0x0001);
+    BOOST_CHECK_EQUAL(wait.signature, "wait");
+    BOOST_CHECK_EQUAL(wait.calls, 2);
+    BOOST_CHECK_EQUAL(wait.total, 400);
+    BOOST_CHECK_EQUAL(wait.max, 300);
+
+    const auto& threads = profiler.getThreadStats();
+    BOOST_REQUIRE_EQUAL(threads.size(), 2);
+    BOOST_CHECK_EQUAL(threads.at("MAIN").calls, 2);
+    BOOST_CHECK_EQUAL(threads.at("MAIN").total, 150);
+    BOOST_CHECK_EQUAL(threads.at("INTRO").max, 300);
+
+    profiler.reset();
+    BOOST_CHECK(profiler.getOpcodeStats().empty());
+    BOOST_CHECK(profiler.getThreadStats().empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_csv_is_sorted) {
+    ScriptProfiler profiler;
+    profiler.record(0x0002, kGoto, "MAIN", 50);
+    profiler.record(0x0001, kWait, "MAIN", 100);
+    profiler.record(0x0001, kWait, "INTRO", 300);
+
+    std::ostringstream out;
+    profiler.writeCSV(out);
+    BOOST_CHECK_EQUAL(out.str(),
+                      "kind,name,signature,calls,total_ns,max_ns\n"
+                      "opcode,0001,\"wait\",2,400,300\n"
+                      "opcode,0002,\"goto\",1,50,50\n"
+                      "thread,\"INTRO\",,1,300,300\n"
+                      "thread,\"MAIN\",,2,150,100\n");
+}
+
+BOOST_AUTO_TEST_CASE(test_report) {
+    ScriptProfiler profiler;
+    profiler.record(0x0001, kWait, "MAIN", 2000000);
+
+    std::ostringstream out;
+    profiler.writeReport(out);
+    const auto report = out.str();
+    BOOST_CHECK(report.find("0001    wait") != std::string::npos);
+    BOOST_CHECK(report.find("2.000") != std::string::npos);
+    BOOST_CHECK(report.find("MAIN") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,80 @@
+#include <boost/test/unit_test.hpp>
+#include <core/TraceProfiler.hpp>
+
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace {
+std::string writeTrace() {
+    std::ostringstream out;
+    TraceProfiler::writeChromeTrace(out);
+    return out.str();
+}
+
+bool contains(const std::string& haystack, const std::string& needle) {
+    return haystack.find(needle) != std::string::npos;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(TraceProfilerTests)
+
+BOOST_AUTO_TEST_CASE(test_scope_is_recorded) {
+    auto before = TraceProfiler::getEventCount();
+    { TraceProfiler::Scope scope("test_scope_is_recorded"); }
+    BOOST_CHECK_EQUAL(TraceProfiler::getEventCount(), before + 1);
+
+    auto trace = writeTrace();
+    BOOST_CHECK(contains(trace, "\"traceEvents\":["));
+    BOOST_CHECK(
+        contains(trace, "\"name\":\"test_scope_is_recorded\",\"ts\":"));
+}
+
+BOOST_AUTO_TEST_CASE(test_threads_are_named) {
+    std::thread thread([] {
+        TraceProfiler::setThreadName("Trace Test Thread");
+        TraceProfiler::Scope scope("test_threads_are_named");
+    });
+    thread.join();
+
+    // Events of threads that have exited are kept
+    auto trace = writeTrace();
+    BOOST_CHECK(contains(trace, "\"args\":{\"name\":\"Trace Test Thread\"}"));
+    BOOST_CHECK(contains(trace, "\"name\":\"test_threads_are_named\""));
+}
+
+BOOST_AUTO_TEST_CASE(test_counters_accumulate) {
+    TraceProfiler::counterSet("traceTestCounter", 2);
+    TraceProfiler::counterAdd("traceTestCounter", 3);
+    std::thread thread(
+        [] { TraceProfiler::counterAdd("traceTestCounter", 4); });
+    thread.join();
+
+    auto trace = writeTrace();
+    BOOST_CHECK(contains(trace, "\"name\":\"traceTestCounter\""));
+    BOOST_CHECK(contains(trace, "\"args\":{\"value\":5}"));
+    BOOST_CHECK(contains(trace, "\"args\":{\"value\":9}"));
+}
+
+BOOST_AUTO_TEST_CASE(test_names_are_escaped) {
+    TraceProfiler::timelineEnter("say \"hi\"\\\n");
+    TraceProfiler::timelineLeave("say \"hi\"\\\n");
+
+    auto trace = writeTrace();
+    BOOST_CHECK(contains(trace, "\"name\":\"say \\\"hi\\\"\\\\\\u000a\""));
+    BOOST_CHECK(contains(trace, "\"ph\":\"b\""));
+    BOOST_CHECK(contains(trace, "\"ph\":\"e\""));
+}
+
+BOOST_AUTO_TEST_CASE(test_many_events) {
+    // Enough to fill more than one of the buffer's blocks
+    const size_t count = 10000;
+    auto before = TraceProfiler::getEventCount();
+    for (size_t i = 0; i < count; ++i) {
+        TraceProfiler::frame();
+    }
+    BOOST_CHECK_EQUAL(TraceProfiler::getEventCount(), before + count);
+    BOOST_CHECK_EQUAL(TraceProfiler::getDroppedCount(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -5,10 +5,14 @@
 #include <ai/AIGraphNode.hpp>
 #include <ai/TrafficDirector.hpp>
 #include <data/PathData.hpp>
+#include <engine/GameState.hpp>
 #include <objects/CharacterObject.hpp>
 #include <objects/InstanceObject.hpp>
+#include <objects/VehicleObject.hpp>
 #include <render/ViewCamera.hpp>
 
+#include <algorithm>
+
 bool operator!=(const ai::AIGraphNode* lhs, const glm::vec3& rhs) {
     return lhs->position != rhs;
 }
@@ -166,4 +170,130 @@ BOOST_AUTO_TEST_CASE(test_create_traffic) {
     // Global::get().e->destroyObject(created[0]);
 }
 
+BOOST_AUTO_TEST_CASE(test_nodes_added_later) {
+    ai::AIGraph graph;
+    ai::TrafficDirector director(&graph, Global::get().e);
+
+    auto open = director.findAvailableNodes(ai::NodeType::Pedestrian,
+                                            glm::vec3(5.f, 5.f, 0.f), 10.f);
+    BOOST_CHECK(open.empty());
+
+    // Paths are created as instances are placed, after traffic started
+    PathData path{PathData::PATH_PED,
+                  0,
+                  "",
+                  {
+                      {PathNode::EXTERNAL, 1, {10.f, 10.f, 0.f}, 1.f, 0, 0},
+                  }};
+    graph.createPathNodes(glm::vec3(), glm::quat{1.0f,0.0f,0.0f,0.0f}, path);
+
+    open = director.findAvailableNodes(ai::NodeType::Pedestrian,
+                                       glm::vec3(5.f, 5.f, 0.f), 10.f);
+    BOOST_CHECK(open.size() == 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_cleanup_budget) {
+    auto world = Global::get().e;
+    ai::AIGraph graph;
+    ai::TrafficDirector director(&graph, world);
+
+    // Looking along +x, the traffic is far behind the camera
+    ViewCamera camera(glm::vec3(0.f, 0.f, 0.f));
+    camera.frustum.update(camera.frustum.projection() * camera.getView());
+
+    std::vector<GameObjectID> traffic;
+    for (int i = 0; i < 3; ++i) {
+        auto ped = world->createPedestrian(1, glm::vec3(-500.f, 0.f, 0.f));
+        ped->setLifetime(GameObject::TrafficLifetime);
+        traffic.push_back(ped->getGameObjectID());
+    }
+    const auto remaining = [&] {
+        return std::count_if(traffic.begin(), traffic.end(), [&](auto id) {
+            return world->pedestrianPool.find(id) != nullptr;
+        });
+    };
+
+    director.cleanupTraffic(camera, 100.f, 1);
+    BOOST_CHECK_GE(remaining(), 2);
+
+    // Every object is checked once the cleanup went around the pool
+    const auto pedestrians = world->pedestrianPool.objects.size();
+    for (size_t i = 0; i < pedestrians; ++i) {
+        director.cleanupTraffic(camera, 100.f, 1);
+    }
+    BOOST_CHECK_EQUAL(remaining(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_vehicle_generators) {
+    auto world = Global::get().e;
+    auto& generators = world->state->vehicleGenerators;
+    const auto realGenerators = generators;
+    ai::AIGraph graph;
+    ai::TrafficDirector director(&graph, world);
+
+    const auto addGenerator = [&](const glm::vec3& position) {
+        generators.emplace_back(generators.size(), position, 0.f, 130, -1, -1,
+                                true, 0, 0, 0, 0, 0, 101);
+    };
+    std::vector<GameObject*> vehicles;
+    const auto spawnVehicles = [&] {
+        size_t count = 0;
+        for (auto object : director.populateNearby(
+                 glm::vec3(1000.f, 1000.f, 0.f), 100.f)) {
+            if (object->type() == GameObject::Vehicle) {
+                vehicles.push_back(object);
+                ++count;
+            }
+        }
+        return count;
+    };
+
+    addGenerator(glm::vec3(1010.f, 1000.f, 0.f));
+    addGenerator(glm::vec3(1500.f, 1000.f, 0.f));
+    BOOST_CHECK_EQUAL(spawnVehicles(), 1);
+    BOOST_REQUIRE(!vehicles.empty());
+    BOOST_CHECK_CLOSE(vehicles[0]->getPosition().x, 1010.f, 0.01f);
+
+    // Generators added later are indexed on the next pass, the first one is
+    // blocked by its vehicle
+    addGenerator(glm::vec3(1040.f, 1000.f, 0.f));
+    BOOST_CHECK_EQUAL(spawnVehicles(), 1);
+
+    // A disabled generator isn't spawned at
+    world->destroyObject(vehicles[0]);
+    generators[0].remainingSpawns = 0;
+    BOOST_CHECK_EQUAL(spawnVehicles(), 0);
+
+    // Generators below the map are moved onto the ground
+    btStaticPlaneShape groundShape(btVector3(0.f, 0.f, 1.f), 5.f);
+    btDefaultMotionState groundState;
+    btRigidBody::btRigidBodyConstructionInfo groundInfo{0.f, &groundState,
+                                                       &groundShape};
+    btRigidBody ground(groundInfo);
+    world->dynamicsWorld->addRigidBody(&ground);
+    const glm::vec3 belowMap(970.f, 1000.f, -100.f);
+    BOOST_CHECK_CLOSE(world->getGroundAtPosition(belowMap).z, 5.f, 0.01f);
+
+    addGenerator(belowMap);
+    const auto spawned = spawnVehicles();
+    world->dynamicsWorld->removeRigidBody(&ground);
+    BOOST_REQUIRE_EQUAL(spawned, 1);
+    auto vehicle = static_cast<VehicleObject*>(vehicles.back());
+    const auto& handling = vehicle->info->handling;
+    const auto onGround =
+        5.f + handling.dimensions.z / 2.f - handling.centerOfMass.z;
+    BOOST_CHECK_CLOSE(vehicle->getPosition().z, onGround, 0.01f);
+
+    // The ground is only looked up once, it's gone now
+    world->destroyObject(vehicle);
+    vehicles.pop_back();
+    BOOST_REQUIRE_EQUAL(spawnVehicles(), 1);
+    BOOST_CHECK_CLOSE(vehicles.back()->getPosition().z, onGround, 0.01f);
+
+    for (size_t i = 1; i < vehicles.size(); ++i) {
+        world->destroyObject(vehicles[i]);
+    }
+    generators = realGenerators;
+}
+
 BOOST_AUTO_TEST_SUITE_END()
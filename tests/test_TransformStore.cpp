@@ -0,0 +1,118 @@
+#include <boost/test/unit_test.hpp>
+#include <objects/GameObject.hpp>
+#include <objects/TransformStore.hpp>
+
+#include <vector>
+
+#include "test_Globals.hpp"
+
+namespace {
+class TestObject final : public GameObject {
+public:
+    TestObject(const glm::vec3& pos)
+        : GameObject(nullptr, pos, glm::quat{1.f, 0.f, 0.f, 0.f}, nullptr) {
+    }
+
+    void tick(float) override {
+    }
+};
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(TransformStoreTests)
+
+BOOST_AUTO_TEST_CASE(test_slots) {
+    TransformStore store;
+    const glm::quat identity{1.f, 0.f, 0.f, 0.f};
+    TestObject object(glm::vec3(0.f));
+    const auto owner = &object;
+
+    const auto a = store.create(owner, glm::vec3(1.f), identity);
+    const auto b = store.create(owner, glm::vec3(2.f), identity);
+    BOOST_CHECK_NE(a, b);
+    BOOST_CHECK_EQUAL(store.getPosition(b), glm::vec3(2.f));
+    BOOST_CHECK_EQUAL(store.getLastPosition(b), glm::vec3(2.f));
+
+    store.destroy(a);
+    BOOST_CHECK(store.getOwner(a) == nullptr);
+
+    // Freed slots are reused, the other handles don't move
+    const auto c = store.create(owner, glm::vec3(3.f), identity);
+    BOOST_CHECK_EQUAL(c, a);
+    BOOST_CHECK_EQUAL(store.size(), 2);
+    BOOST_CHECK_EQUAL(store.getPosition(c), glm::vec3(3.f));
+    BOOST_CHECK_EQUAL(store.getPosition(b), glm::vec3(2.f));
+}
+
+BOOST_AUTO_TEST_CASE(test_save_last_transforms) {
+    TransformStore store;
+    const glm::quat identity{1.f, 0.f, 0.f, 0.f};
+    TestObject object(glm::vec3(0.f));
+
+    const auto still = store.create(&object, glm::vec3(1.f), identity);
+    const auto moving = store.create(&object, glm::vec3(2.f), identity);
+    BOOST_CHECK_EQUAL(store.getMovedCount(), 0);
+
+    // Written twice, listed once
+    store.setPosition(moving, glm::vec3(3.f));
+    store.setPosition(moving, glm::vec3(4.f));
+    BOOST_CHECK_EQUAL(store.getMovedCount(), 1);
+    BOOST_CHECK_EQUAL(store.getLastPosition(moving), glm::vec3(2.f));
+
+    store.saveLastTransforms();
+    BOOST_CHECK_EQUAL(store.getMovedCount(), 0);
+    BOOST_CHECK_EQUAL(store.getLastPosition(moving), glm::vec3(4.f));
+    BOOST_CHECK_EQUAL(store.getLastPosition(still), glm::vec3(1.f));
+
+    // Nothing moved, nothing to save
+    store.saveLastTransforms();
+    BOOST_CHECK_EQUAL(store.getLastPosition(moving), glm::vec3(4.f));
+}
+
+BOOST_AUTO_TEST_CASE(test_find_in_radius) {
+    TransformStore store;
+    const glm::quat identity{1.f, 0.f, 0.f, 0.f};
+    TestObject near(glm::vec3(0.f)), far(glm::vec3(0.f));
+
+    store.create(&near, glm::vec3(1.f, 0.f, 0.f), identity);
+    store.create(&far, glm::vec3(10.f, 0.f, 0.f), identity);
+    const auto freed = store.create(&near, glm::vec3(0.f), identity);
+    store.destroy(freed);
+
+    // Free slots are skipped
+    std::vector<GameObject*> found;
+    store.findInRadius(glm::vec3(0.f), 5.f, found);
+    BOOST_REQUIRE_EQUAL(found.size(), 1);
+    BOOST_CHECK(found[0] == &near);
+
+    // Results are appended
+    store.findInRadius(glm::vec3(10.f, 0.f, 0.f), 1.f, found);
+    BOOST_REQUIRE_EQUAL(found.size(), 2);
+    BOOST_CHECK(found[1] == &far);
+}
+
+BOOST_AUTO_TEST_CASE(test_object_transform) {
+    auto& store = TransformStore::detached();
+    TestObject object(glm::vec3(1.f, 2.f, 3.f));
+    const auto handle = object.getTransformHandle();
+    BOOST_CHECK(store.getOwner(handle) == &object);
+    BOOST_CHECK_EQUAL(store.getPosition(handle), glm::vec3(1.f, 2.f, 3.f));
+
+    const glm::quat rotation{0.f, 0.f, 0.f, 1.f};
+    object.updateTransform(glm::vec3(4.f), rotation);
+    BOOST_CHECK_EQUAL(store.getPosition(handle), glm::vec3(4.f));
+    BOOST_CHECK_EQUAL(object.getLastPosition(), glm::vec3(1.f, 2.f, 3.f));
+    BOOST_CHECK(object.getRotation() == rotation);
+
+    object.setPosition(glm::vec3(5.f));
+    BOOST_CHECK_EQUAL(object.getPosition(), glm::vec3(5.f));
+    BOOST_CHECK_EQUAL(object.getLastPosition(), glm::vec3(5.f));
+
+    {
+        // Creating objects doesn't move the existing transforms
+        TestObject other(glm::vec3(6.f));
+        BOOST_CHECK_NE(other.getTransformHandle(), handle);
+        BOOST_CHECK_EQUAL(object.getPosition(), glm::vec3(5.f));
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1,7 +1,34 @@
 #include <boost/test/unit_test.hpp>
 #include <data/ZoneData.hpp>
+#include <data/ZoneIndex.hpp>
 #include "test_Globals.hpp"
 
+#include <random>
+
+namespace {
+/// A root zone with nested and overlapping zones, hierarchy built
+ZoneDataList makeZones() {
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> coord(-1000.f, 1000.f);
+    std::uniform_real_distribution<float> size(10.f, 400.f);
+
+    ZoneDataList zones;
+    zones.emplace_back("ROOT", 0, glm::vec3(-1000.f, -1000.f, -100.f),
+                       glm::vec3(1000.f, 1000.f, 100.f), 0, 0, 0);
+    for (int i = 0; i < 200; ++i) {
+        glm::vec3 min(coord(rng), coord(rng), -50.f);
+        glm::vec3 max(min.x + size(rng), min.y + size(rng), 50.f);
+        zones.emplace_back("Z" + std::to_string(i), 0, min, max, 0, 0, 0);
+    }
+    for (ZoneData& zone : zones) {
+        if (&zone != &zones[0]) {
+            zones[0].insertZone(zone);
+        }
+    }
+    return zones;
+}
+}  // namespace
+
 BOOST_AUTO_TEST_SUITE(ZoneDataTests)
 
 BOOST_AUTO_TEST_CASE(test_contains_point) {
@@ -28,6 +55,65 @@ BOOST_AUTO_TEST_CASE(test_hierarchy) {
 
     BOOST_CHECK_EQUAL(zone.findLeafAtPoint({-5.f, 0.f, 0.f}), &zone);
     BOOST_CHECK_EQUAL(zone.findLeafAtPoint({ 5.f, 5.f, 0.f}), &leaf);
+    BOOST_CHECK(zone.findLeafAtPoint({20.f, 5.f, 0.f}) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(test_index_matches_hierarchy) {
+    auto zones = makeZones();
+    ZoneIndex index;
+    index.build(zones[0]);
 
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> coord(-1100.f, 1100.f);
+    std::uniform_real_distribution<float> height(-120.f, 120.f);
+    for (int i = 0; i < 5000; ++i) {
+        glm::vec3 point(coord(rng), coord(rng), height(rng));
+        BOOST_CHECK_EQUAL(index.find(point), zones[0].findLeafAtPoint(point));
+    }
+
+    // Zone corners are inside
+    for (const auto& zone : zones) {
+        BOOST_CHECK_EQUAL(index.find(zone.min),
+                          zones[0].findLeafAtPoint(zone.min));
+        BOOST_CHECK_EQUAL(index.find(zone.max),
+                          zones[0].findLeafAtPoint(zone.max));
+    }
 }
+
+BOOST_AUTO_TEST_CASE(test_index_cache) {
+    auto zones = makeZones();
+    ZoneIndex index;
+    ZoneIndex::Cache cache;
+
+    // Nothing indexed yet
+    BOOST_CHECK(index.find({0.f, 0.f, 0.f}, cache) == nullptr);
+
+    index.build(zones[0]);
+
+    // Walk in small steps, so most lookups come from the cache
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> step(-5.f, 5.f);
+    glm::vec3 point(0.f, 0.f, 0.f);
+    for (int i = 0; i < 5000; ++i) {
+        point.x = std::max(-1100.f, std::min(1100.f, point.x + step(rng)));
+        point.y = std::max(-1100.f, std::min(1100.f, point.y + step(rng)));
+        point.z = std::max(-120.f, std::min(120.f, point.z + step(rng)));
+        BOOST_CHECK_EQUAL(index.find(point, cache),
+                          zones[0].findLeafAtPoint(point));
+    }
+
+    // Rebuilding drops old results
+    point = glm::vec3(0.f, 0.f, 0.f);
+    index.find(point, cache);
+    ZoneData leaf("LEAF", 0, point, point, 0, 0, 0);
+    BOOST_REQUIRE(zones[0].insertZone(leaf));
+    index.build(zones[0]);
+    BOOST_CHECK_EQUAL(index.find(point, cache), &leaf);
+
+    // A cleared index finds nothing, even for a cached point
+    index.clear();
+    BOOST_CHECK(index.find(point, cache) == nullptr);
+    BOOST_CHECK(index.find(point) == nullptr);
+}
+
 BOOST_AUTO_TEST_SUITE_END()